@@ -1,5 +1,8 @@
 #pragma once
+#include <chrono>
+#include <cstddef>
 #include <string_view>
+#include "core/Types.hpp"
 
 /// @file Config.hpp
 /// @brief Application-wide configuration constants.
@@ -15,6 +18,14 @@ inline constexpr int kWindowHeight = 800;
 inline constexpr int kFrameRateLimit = 60;
 inline constexpr std::string_view kWindowTitle = "Modern Chess";
 
+/// When the game loop draws a frame.
+enum class RedrawMode {
+    Continuous,  ///< Every loop iteration, up to kFrameRateLimit
+    OnDemand     ///< Only after a change; otherwise sleep until input arrives
+};
+
+inline constexpr RedrawMode kRedrawMode = RedrawMode::OnDemand;
+
 // ============================================================================
 // Animation Settings
 // ============================================================================
@@ -44,6 +55,29 @@ inline constexpr float kLegalMoveRingRadius = 0.45f;
 /// Legal move capture ring thickness ratio relative to tile size.
 inline constexpr float kLegalMoveRingThickness = 0.08f;
 
+// ============================================================================
+// Engine Settings
+// ============================================================================
+
+/// What the background engine does while the game is running.
+enum class EngineMode {
+    Off,       ///< No engine
+    Analysis,  ///< Analyze every position until it changes
+    Opponent   ///< Play kEngineColor's moves
+};
+
+inline constexpr EngineMode kEngineMode = EngineMode::Opponent;
+inline constexpr chess::Color kEngineColor = chess::Color::Black;
+
+/// Thinking time per engine move in Opponent mode.
+inline constexpr std::chrono::milliseconds kEngineMoveTime{1000};
+
+/// How often an idle OnDemand loop checks for engine results while it thinks.
+inline constexpr std::chrono::milliseconds kEnginePollInterval{1000 / kFrameRateLimit};
+
+inline constexpr std::size_t kEngineHashMb = 64;
+inline constexpr int kEngineThreads = 1;
+
 // ============================================================================
 // Asset Paths
 // ============================================================================
@@ -1,4 +1,5 @@
 ﻿#include "Application.hpp"
+#include "Config.hpp"
 #include "ui/SfmlInputHandler.hpp"
 #include <stdexcept>
 
@@ -10,10 +11,12 @@ namespace app {
 
 Application::Application(std::unique_ptr<chess::IGame> game,
                          std::unique_ptr<ui::IRenderer> renderer,
-                         std::unique_ptr<ui::IInputHandler> input_handler)
+                         std::unique_ptr<ui::IInputHandler> input_handler,
+                         std::unique_ptr<engine::AsyncEngine> engine)
     : game_(std::move(game)),
       renderer_(std::move(renderer)),
-      input_handler_(std::move(input_handler)) {
+      input_handler_(std::move(input_handler)),
+      engine_(std::move(engine)) {
     
     if (!game_ || !renderer_ || !input_handler_) {
         throw std::invalid_argument("Application requires non-null game, renderer, and input handler");
@@ -44,7 +47,31 @@ void Application::run() {
 void Application::processFrame() {
     handleAnimation();
     handleInput();
-    renderFrame();
+    handleEngine();
+
+    if (needsRedraw()) {
+        renderFrame();
+        frame_dirty_ = false;
+        rendered_position_ = game_->positionKey();
+    } else {
+        waitForActivity();
+    }
+}
+
+bool Application::needsRedraw() const {
+    if (config::kRedrawMode == config::RedrawMode::Continuous) return true;
+    // Moves, undo/redo and engine replies all change the position; the
+    // overlay's frame times and engine statistics need a steady frame rate
+    return frame_dirty_ || game_->positionKey() != rendered_position_ ||
+           input_handler_->getAnimationState() || input_handler_->isDragging() ||
+           renderer_->isOverlayVisible();
+}
+
+void Application::waitForActivity() {
+    // A thinking engine posts its result without an input event to wake us
+    const bool engine_busy = engine_ && engine_searching_;
+    input_handler_->waitForInput(engine_busy ? std::optional{config::kEnginePollInterval}
+                                             : std::nullopt);
 }
 
 void Application::handleAnimation() {
@@ -57,13 +84,113 @@ void Application::handleInput() {
     if (auto move = input_handler_->processInput()) {
         game_->makeMove(*move);
     }
+    if (input_handler_->takeRedrawRequest()) {
+        frame_dirty_ = true;
+    }
+    if (auto command = input_handler_->takeCommand()) {
+        handleCommand(*command);
+    }
+}
+
+void Application::handleCommand(ui::InputCommand command) {
+    if (command == ui::InputCommand::ToggleOverlay) {
+        renderer_->toggleOverlay();
+        frame_dirty_ = true;
+        return;
+    }
+
+    const auto step = [&] {
+        return command == ui::InputCommand::Undo ? game_->undoMove() : game_->redoMove();
+    };
+    if (!step()) return;
+
+    // Against the engine, step over its reply too so the player is to move
+    if (engine_ && config::kEngineMode == config::EngineMode::Opponent &&
+        game_->sideToMove() == config::kEngineColor) {
+        static_cast<void>(step());
+    }
+}
+
+// ============================================================================
+// Background Engine
+// ============================================================================
+
+void Application::handleEngine() {
+    if (!engine_) return;
+
+    // Cancel on new move: a search for any other position is stale
+    const chess::zobrist::Key position = game_->positionKey();
+    if (engine_position_ && *engine_position_ != position) {
+        if (engine_searching_) engine_->cancel();
+        engine_searching_ = false;
+        engine_position_.reset();
+        engine_info_.reset();
+    }
+
+    // Never blocks: only takes what the worker already posted
+    while (auto update = engine_->poll()) {
+        engine_info_ = std::move(update->info);
+        if (update->kind == engine::EngineUpdate::Kind::BestMove) {
+            engine_searching_ = false;
+            if (config::kEngineMode == config::EngineMode::Opponent && update->best_move) {
+                playEngineMove(*update->best_move);
+            }
+        }
+    }
+
+    if (!engine_position_ && wantsEngineSearch()) {
+        engine::SearchLimits limits{};
+        if (config::kEngineMode == config::EngineMode::Opponent) {
+            limits.move_time = config::kEngineMoveTime;
+        }
+        engine_->start(game_->board(), game_->sideToMove(), limits, game_->repetitionKeys(),
+                       game_->halfmoveClock());
+        engine_position_ = position;
+        engine_searching_ = true;
+    }
+}
+
+bool Application::wantsEngineSearch() const {
+    // Wait for the board to settle before searching the new position
+    if (input_handler_->getAnimationState() || game_->isGameOver()) {
+        return false;
+    }
+    switch (config::kEngineMode) {
+        case config::EngineMode::Off:
+            return false;
+        case config::EngineMode::Analysis:
+            return true;
+        case config::EngineMode::Opponent:
+            return game_->sideToMove() == config::kEngineColor;
+    }
+    return false;
 }
 
+void Application::playEngineMove(const chess::Move& move) {
+    // Animate like a dropped piece; the move is made when the animation ends
+    auto* sfml_input = dynamic_cast<ui::SfmlInputHandler*>(input_handler_.get());
+    const auto& piece = game_->board().at(move.from);
+    if (sfml_input && piece) {
+        sfml_input->startAnimation(move.from, move.to, *piece, move);
+    } else {
+        static_cast<void>(game_->makeMove(move));
+    }
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
 void Application::renderFrame() {
     auto anim_state = input_handler_->getAnimationState();
     
     // Configure renderer
     renderer_->setAnimationState(anim_state ? &(*anim_state) : nullptr);
+    renderer_->setEngineStatus({
+        .attached = engine_ != nullptr,
+        .searching = engine_searching_,
+        .info = engine_info_ ? &(*engine_info_) : nullptr,
+    });
     syncLegalMoveHighlights();
 
     // Render scene
@@ -72,6 +199,7 @@ void Application::renderFrame() {
     if (anim_state) {
         renderer_->renderPieceAnimation(*game_, *anim_state);
     }
+    renderer_->renderOverlay();
 
     // Present and cleanup
     renderer_->setAnimationState(nullptr);
@@ -79,14 +207,7 @@ void Application::renderFrame() {
 }
 
 void Application::syncLegalMoveHighlights() {
-    if (auto* sfml_input = dynamic_cast<ui::SfmlInputHandler*>(input_handler_.get())) {
-        auto legal_squares = sfml_input->getLegalMoveSquares();
-        if (!legal_squares.empty()) {
-            renderer_->setLegalMoveHighlights(legal_squares);
-        } else {
-            renderer_->clearLegalMoveHighlights();
-        }
-    }
+    renderer_->setLegalMoveHighlights(input_handler_->legalMoveHighlights());
 }
 
 } // namespace app
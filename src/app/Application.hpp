@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include <memory>
+#include <optional>
 #include "core/IGame.hpp"
+#include "engine/AsyncEngine.hpp"
 #include "ui/IRenderer.hpp"
 #include "ui/IInputHandler.hpp"
 
@@ -9,14 +11,19 @@ namespace app {
 /// Main application class coordinating the game loop.
 /// 
 /// Connects game logic, rendering, and input handling layers.
-/// Manages the main loop lifecycle and frame processing.
+/// Manages the main loop lifecycle and frame processing. In
+/// config::RedrawMode::OnDemand a frame is drawn only while a piece is
+/// animating or dragged, or after input or a position change; in between,
+/// the loop sleeps in IInputHandler::waitForInput().
 class Application final {
 public:
     /// Construct application with required dependencies.
-    /// @throws std::invalid_argument if any dependency is null
+    /// @param engine Optional background engine driven per config::kEngineMode
+    /// @throws std::invalid_argument if any required dependency is null
     Application(std::unique_ptr<chess::IGame> game,
                 std::unique_ptr<ui::IRenderer> renderer,
-                std::unique_ptr<ui::IInputHandler> input_handler);
+                std::unique_ptr<ui::IInputHandler> input_handler,
+                std::unique_ptr<engine::AsyncEngine> engine = nullptr);
     
     ~Application();
     
@@ -32,14 +39,33 @@ public:
 private:
     void initializeInputHandler();
     void processFrame();
+    [[nodiscard]] bool needsRedraw() const;
+    void waitForActivity();
     void handleAnimation();
     void handleInput();
+    void handleCommand(ui::InputCommand command);
+    void handleEngine();
     void renderFrame();
     void syncLegalMoveHighlights();
 
+    /// True if the engine should be thinking about the current position.
+    [[nodiscard]] bool wantsEngineSearch() const;
+    void playEngineMove(const chess::Move& move);
+
     std::unique_ptr<chess::IGame> game_;
     std::unique_ptr<ui::IRenderer> renderer_;
     std::unique_ptr<ui::IInputHandler> input_handler_;
+    std::unique_ptr<engine::AsyncEngine> engine_;
+
+    /// Position the latest engine search was started for; a different
+    /// current position means the search is stale and gets cancelled.
+    std::optional<chess::zobrist::Key> engine_position_;
+    bool engine_searching_{false};
+    std::optional<engine::SearchInfo> engine_info_;  ///< Latest progress report
+
+    // On-demand redraw (config::RedrawMode::OnDemand)
+    bool frame_dirty_{true};  ///< Input may have changed the picture
+    chess::zobrist::Key rendered_position_{0};
 };
 
 } // namespace app
@@ -0,0 +1,230 @@
+#include "GameArchive.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <utility>
+
+namespace batch {
+
+namespace {
+
+constexpr std::array<std::byte, 4> kMagic = {std::byte{'M'}, std::byte{'C'}, std::byte{'G'},
+                                             std::byte{'A'}};
+constexpr std::uint32_t kFormatVersion = 1;
+
+constexpr std::size_t kHeaderSize = 32;
+constexpr std::size_t kEncodingOffset = 8;
+constexpr std::size_t kGameCountOffset = 16;
+constexpr std::size_t kIndexOffsetOffset = 24;
+
+/// Result, FEN length and ply count before a record's variable-length data.
+constexpr std::size_t kRecordHeaderSize = 4;
+constexpr std::size_t kMaxPlies = 0xFFFF;
+
+template <std::unsigned_integral T>
+void appendLe(std::vector<std::byte>& out, T value) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<std::byte>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+/// @pre offset + sizeof(T) <= bytes.size()
+template <std::unsigned_integral T>
+[[nodiscard]] T loadLe(std::span<const std::byte> bytes, std::size_t offset) noexcept {
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        value = static_cast<T>(value | (static_cast<T>(bytes[offset + i]) << (8 * i)));
+    }
+    return value;
+}
+
+[[nodiscard]] constexpr std::size_t bytesPerPly(MoveEncoding encoding) noexcept {
+    return encoding == MoveEncoding::Packed ? 2 : 1;
+}
+
+void writeBytes(std::ofstream& out, std::span<const std::byte> bytes) {
+    out.write(reinterpret_cast<const char*>(bytes.data()),
+              static_cast<std::streamsize>(bytes.size()));
+}
+
+} // namespace
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+std::optional<GameArchiveWriter> GameArchiveWriter::create(const std::filesystem::path& path,
+                                                           MoveEncoding encoding) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return std::nullopt;
+
+    // Placeholder; finish() rewrites it once the index position is known
+    const std::array<std::byte, kHeaderSize> header{};
+    writeBytes(out, header);
+    if (!out) return std::nullopt;
+
+    return GameArchiveWriter(std::move(out), encoding);
+}
+
+GameArchiveWriter::GameArchiveWriter(std::ofstream out, MoveEncoding encoding)
+    : out_(std::move(out)), encoding_(encoding), position_(kHeaderSize) {}
+
+GameArchiveWriter::~GameArchiveWriter() {
+    if (!finished_ && out_.is_open()) {
+        static_cast<void>(finish());
+    }
+}
+
+bool GameArchiveWriter::addGame(std::span<const chess::PackedMove> moves, chess::GameResult result,
+                                std::string_view start_fen) {
+    if (moves.size() > kMaxPlies) return false;
+
+    chess::FenString fen;
+    if (start_fen.empty()) {
+        game_.newGame();
+    } else {
+        if (!game_.loadFen(start_fen)) return false;
+        fen = game_.fen();
+    }
+
+    record_.clear();
+    appendLe(record_, static_cast<std::uint8_t>(result));
+    appendLe(record_, static_cast<std::uint8_t>(fen.view().size()));
+    appendLe(record_, static_cast<std::uint16_t>(moves.size()));
+    for (const char c : fen.view()) {
+        record_.push_back(static_cast<std::byte>(c));
+    }
+
+    for (const chess::PackedMove packed : moves) {
+        const chess::Move wanted = packed.toMove();
+        const chess::MoveList& legal = game_.legalMoveList();
+        const auto it = std::ranges::find_if(legal, [&](const chess::Move& move) {
+            return move.from == wanted.from && move.to == wanted.to &&
+                   move.promotion == wanted.promotion;
+        });
+        if (it == legal.end()) return false;
+
+        if (encoding_ == MoveEncoding::Packed) {
+            appendLe(record_, chess::PackedMove(*it).raw());
+        } else {
+            // At most 218 legal moves exist in any position
+            appendLe(record_, static_cast<std::uint8_t>(it - legal.begin()));
+        }
+        const chess::Move move = *it;
+        static_cast<void>(game_.makeMove(move));
+    }
+
+    writeBytes(out_, record_);
+    offsets_.push_back(position_);
+    position_ += record_.size();
+    return true;
+}
+
+bool GameArchiveWriter::finish() {
+    if (finished_) return !out_.fail();
+    finished_ = true;
+
+    record_.clear();
+    for (const std::uint64_t offset : offsets_) {
+        appendLe(record_, offset);
+    }
+    writeBytes(out_, record_);
+
+    record_.assign(kMagic.begin(), kMagic.end());
+    appendLe(record_, kFormatVersion);
+    appendLe(record_, static_cast<std::uint8_t>(encoding_));
+    record_.resize(kGameCountOffset);
+    appendLe(record_, static_cast<std::uint64_t>(offsets_.size()));
+    appendLe(record_, position_);
+
+    out_.seekp(0);
+    writeBytes(out_, record_);
+    out_.close();
+    return !out_.fail();
+}
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+std::optional<GameArchiveReader> GameArchiveReader::open(const std::filesystem::path& path) {
+    auto file = chess::MappedFile::open(path);
+    if (!file) return std::nullopt;
+
+    const auto bytes = file->bytes();
+    if (bytes.size() < kHeaderSize || !std::ranges::equal(bytes.first(kMagic.size()), kMagic) ||
+        loadLe<std::uint32_t>(bytes, kMagic.size()) != kFormatVersion) {
+        return std::nullopt;
+    }
+
+    const auto encoding = std::to_integer<std::uint8_t>(bytes[kEncodingOffset]);
+    if (encoding > static_cast<std::uint8_t>(MoveEncoding::LegalIndex)) return std::nullopt;
+
+    const auto game_count = loadLe<std::uint64_t>(bytes, kGameCountOffset);
+    const auto index_offset = loadLe<std::uint64_t>(bytes, kIndexOffsetOffset);
+    if (index_offset < kHeaderSize || index_offset > bytes.size() ||
+        game_count > (bytes.size() - index_offset) / sizeof(std::uint64_t)) {
+        return std::nullopt;
+    }
+
+    return GameArchiveReader(std::move(*file), static_cast<MoveEncoding>(encoding),
+                             static_cast<std::size_t>(game_count),
+                             static_cast<std::size_t>(index_offset));
+}
+
+GameArchiveReader::GameArchiveReader(chess::MappedFile file, MoveEncoding encoding,
+                                     std::size_t game_count, std::size_t index_offset) noexcept
+    : file_(std::move(file)),
+      encoding_(encoding),
+      game_count_(game_count),
+      index_offset_(index_offset) {}
+
+std::optional<ArchivedGame> GameArchiveReader::game(std::size_t n) const noexcept {
+    if (n >= game_count_) return std::nullopt;
+
+    const auto bytes = file_.bytes();
+    const auto offset = loadLe<std::uint64_t>(bytes, index_offset_ + n * sizeof(std::uint64_t));
+    if (offset < kHeaderSize || offset > index_offset_ - kRecordHeaderSize) return std::nullopt;
+
+    const auto record = static_cast<std::size_t>(offset);
+    const auto result = std::to_integer<std::uint8_t>(bytes[record]);
+    const auto fen_size = std::to_integer<std::size_t>(bytes[record + 1]);
+    const auto plies = loadLe<std::uint16_t>(bytes, record + 2);
+    const std::size_t fen_begin = record + kRecordHeaderSize;
+    const std::size_t moves_size = plies * bytesPerPly(encoding_);
+    if (result > static_cast<std::uint8_t>(chess::GameResult::Unknown) ||
+        fen_begin + fen_size + moves_size > index_offset_) {
+        return std::nullopt;
+    }
+
+    return ArchivedGame{
+        .result = static_cast<chess::GameResult>(result),
+        .start_fen = file_.text().substr(fen_begin, fen_size),
+        .plies = plies,
+        .moves = bytes.subspan(fen_begin + fen_size, moves_size),
+    };
+}
+
+bool GameArchiveReader::replay(const ArchivedGame& record, chess::ChessGame& game) const {
+    if (record.start_fen.empty()) {
+        game.newGame();
+    } else if (!game.loadFen(record.start_fen)) {
+        return false;
+    }
+
+    for (std::size_t ply = 0; ply < record.plies; ++ply) {
+        if (encoding_ == MoveEncoding::Packed) {
+            const auto packed = chess::PackedMove::fromRaw(loadLe<std::uint16_t>(record.moves, 2 * ply));
+            if (!game.makeMove(packed.toMove())) return false;
+        } else {
+            const chess::MoveList& legal = game.legalMoveList();
+            const auto index = std::to_integer<std::size_t>(record.moves[ply]);
+            if (index >= legal.size()) return false;
+            const chess::Move move = legal[index];
+            static_cast<void>(game.makeMove(move));
+        }
+    }
+    return true;
+}
+
+} // namespace batch
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "core/ChessGame.hpp"
+#include "core/MappedFile.hpp"
+#include "core/PackedMove.hpp"
+#include "core/Pgn.hpp"
+
+/// @file GameArchive.hpp
+/// @brief Compact binary game archives with O(1) random access.
+///
+/// File layout (all integers little-endian):
+/// - 32-byte header: magic "MCGA", format version (u32), move encoding (u8),
+///   7 reserved bytes, game count (u64), offset of the game index (u64)
+/// - Game records: result (u8), start FEN length (u8, 0 = standard start
+///   position), ply count (u16), the FEN text, then one encoded move per ply
+/// - Game index: one u64 file offset per game record
+
+namespace batch {
+
+/// How an archive stores moves.
+enum class MoveEncoding : std::uint8_t {
+    /// 2 bytes per ply (chess::PackedMove): self-describing moves.
+    Packed,
+    /// 1 byte per ply: the move's index in Rules::legalMoves() order. Half the
+    /// size of Packed, but only readable with the same move generation order.
+    LegalIndex
+};
+
+/// One game record, viewing the archive's mapping.
+struct ArchivedGame {
+    chess::GameResult result{chess::GameResult::Unknown};
+    std::string_view start_fen{};  ///< Empty for the standard start position
+    std::uint16_t plies{0};
+    std::span<const std::byte> moves{};  ///< `plies` moves in the archive's encoding
+};
+
+/// Streams games into a new archive file.
+///
+/// Every game is replayed as it is added, so an archive only ever holds
+/// legal games. The index and header are written by finish().
+class GameArchiveWriter {
+public:
+    /// Create (or truncate) an archive file.
+    /// @return nullopt if the file cannot be opened for writing
+    [[nodiscard]] static std::optional<GameArchiveWriter> create(const std::filesystem::path& path,
+                                                                 MoveEncoding encoding);
+
+    GameArchiveWriter(GameArchiveWriter&&) noexcept = default;
+    GameArchiveWriter& operator=(GameArchiveWriter&&) noexcept = default;
+    GameArchiveWriter(const GameArchiveWriter&) = delete;
+    GameArchiveWriter& operator=(const GameArchiveWriter&) = delete;
+
+    /// Calls finish() if it has not been called; errors are lost, so call it explicitly.
+    ~GameArchiveWriter();
+
+    /// Append a game.
+    /// @param start_fen Starting position; empty for the standard one
+    /// @return false (appending nothing) if the FEN is invalid, a move is
+    ///         illegal or the game is longer than 65535 plies
+    [[nodiscard]] bool addGame(std::span<const chess::PackedMove> moves, chess::GameResult result,
+                               std::string_view start_fen = {});
+
+    /// Write the game index and header and close the file.
+    /// @return false if any write failed
+    [[nodiscard]] bool finish();
+
+    [[nodiscard]] std::size_t gameCount() const noexcept { return offsets_.size(); }
+
+private:
+    GameArchiveWriter(std::ofstream out, MoveEncoding encoding);
+
+    std::ofstream out_;
+    MoveEncoding encoding_;
+    std::vector<std::uint64_t> offsets_;
+    std::uint64_t position_{0};       // Current file offset
+    std::vector<std::byte> record_;   // Scratch buffer for one game record
+    chess::ChessGame game_;           // Validates moves and resolves legal indices
+    bool finished_{false};
+};
+
+/// Memory-mapped read access to an archive.
+///
+/// Opening only validates the header and index bounds; records are paged in
+/// by the OS as they are read, and game(n) is a single index lookup.
+class GameArchiveReader {
+public:
+    /// Map an archive.
+    /// @return nullopt if the file cannot be mapped or is not a valid archive
+    [[nodiscard]] static std::optional<GameArchiveReader> open(const std::filesystem::path& path);
+
+    [[nodiscard]] std::size_t size() const noexcept { return game_count_; }
+    [[nodiscard]] MoveEncoding encoding() const noexcept { return encoding_; }
+
+    /// Record of game n.
+    /// @return nullopt if n is out of range or the record is corrupt
+    [[nodiscard]] std::optional<ArchivedGame> game(std::size_t n) const noexcept;
+
+    /// Load a record's start position into `game` and play all of its moves.
+    /// @return false if a move does not decode to a legal move
+    [[nodiscard]] bool replay(const ArchivedGame& record, chess::ChessGame& game) const;
+
+private:
+    GameArchiveReader(chess::MappedFile file, MoveEncoding encoding, std::size_t game_count,
+                      std::size_t index_offset) noexcept;
+
+    chess::MappedFile file_;
+    MoveEncoding encoding_;
+    std::size_t game_count_;
+    std::size_t index_offset_;
+};
+
+} // namespace batch
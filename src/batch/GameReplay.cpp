@@ -0,0 +1,261 @@
+#include "GameReplay.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "core/ChessGame.hpp"
+#include "core/San.hpp"
+#include "GameArchive.hpp"
+
+namespace batch {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Batches in flight per worker: enough to keep workers busy while the
+/// caller is emitting, small enough to bound memory.
+constexpr std::size_t kBatchesPerWorker = 4;
+
+constexpr std::string_view kCorruptRecord = "<corrupt archive record>";
+
+/// Consecutive games handed to one worker.
+template <typename Item>
+struct Batch {
+    std::uint64_t sequence{0};
+    std::uint64_t first_index{0};
+    std::vector<Item> games;
+};
+
+/// State shared by the splitter, the workers and the emitting caller.
+template <typename Item>
+class ReplayQueue {
+public:
+    explicit ReplayQueue(std::size_t max_in_flight) noexcept : max_in_flight_(max_in_flight) {}
+
+    /// Splitter: queue a batch, waiting while too many are in flight.
+    void pushWork(Batch<Item> batch) {
+        std::unique_lock lock(mutex_);
+        space_.wait(lock, [&] { return batch.sequence - emitted_ < max_in_flight_; });
+        work_.push_back(std::move(batch));
+        work_ready_.notify_one();
+    }
+
+    /// Splitter: no more batches will follow.
+    void finishInput(std::uint64_t batch_count) {
+        std::scoped_lock lock(mutex_);
+        batch_count_ = batch_count;
+        work_ready_.notify_all();
+        result_ready_.notify_all();
+    }
+
+    /// Worker: the next batch, or nullopt once the input is exhausted.
+    [[nodiscard]] std::optional<Batch<Item>> popWork() {
+        std::unique_lock lock(mutex_);
+        work_ready_.wait(lock, [&] { return !work_.empty() || batch_count_; });
+        if (work_.empty()) return std::nullopt;
+        Batch<Item> batch = std::move(work_.front());
+        work_.pop_front();
+        return batch;
+    }
+
+    /// Worker: hand back the reports of a batch.
+    void pushResult(std::uint64_t sequence, std::vector<GameReport> reports) {
+        std::scoped_lock lock(mutex_);
+        done_.emplace(sequence, std::move(reports));
+        result_ready_.notify_one();
+    }
+
+    /// Caller: reports of the next batch in input order, or nullopt when all
+    /// batches have been emitted.
+    [[nodiscard]] std::optional<std::vector<GameReport>> popResultInOrder() {
+        std::unique_lock lock(mutex_);
+        result_ready_.wait(lock, [&] {
+            return done_.contains(emitted_) || (batch_count_ && emitted_ == *batch_count_);
+        });
+        const auto it = done_.find(emitted_);
+        if (it == done_.end()) return std::nullopt;
+        std::vector<GameReport> reports = std::move(it->second);
+        done_.erase(it);
+        ++emitted_;
+        space_.notify_one();
+        return reports;
+    }
+
+private:
+    const std::size_t max_in_flight_;
+
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable result_ready_;
+    std::condition_variable space_;
+
+    std::deque<Batch<Item>> work_;
+    std::map<std::uint64_t, std::vector<GameReport>> done_;
+    std::uint64_t emitted_{0};
+    std::optional<std::uint64_t> batch_count_;  // Set once the input is split
+};
+
+[[nodiscard]] FinalState finalState(const chess::ChessGame& game) {
+    if (game.isCheckmate()) return FinalState::Checkmate;
+    if (game.isStalemate()) return FinalState::Stalemate;
+    return FinalState::Ongoing;
+}
+
+} // namespace
+
+// ============================================================================
+// Single Game
+// ============================================================================
+
+GameReport replayGame(chess::ChessGame& game, const chess::PgnGame& pgn, std::uint64_t index,
+                      bool keep_moves) {
+    GameReport report{.index = index, .result = pgn.result()};
+
+    if (const auto fen = pgn.tag("FEN")) {
+        report.start_fen = *fen;
+        if (!game.loadFen(*fen)) {
+            report.error = *fen;
+            return report;
+        }
+    } else {
+        game.newGame();
+    }
+
+    chess::MovetextReader moves(pgn.movetext);
+    while (const auto san = moves.next()) {
+        const auto move = chess::parseSan(game.board(), game.legalMoveList(), *san);
+        if (!move || !game.makeMove(*move)) {
+            report.error = *san;
+            break;
+        }
+        if (keep_moves) report.moves.emplace_back(*move);
+        ++report.plies;
+    }
+
+    report.final_state = finalState(game);
+    report.final_key = game.positionKey();
+    return report;
+}
+
+// ============================================================================
+// Pipeline
+// ============================================================================
+
+namespace {
+
+/// Run the splitter / worker pool / in-order emitter pipeline.
+/// @param split  Called on the splitter thread with a sink taking an Item;
+///               feeds every game of the input to it in order
+/// @param replay `GameReport(chess::ChessGame&, const Item&, std::uint64_t index)`,
+///               called on worker threads
+template <typename Item, typename Split, typename Replay>
+[[nodiscard]] ReplayStats runPipeline(const ReplayOptions& options, const ReportSink& on_game,
+                                      Split split, Replay replay) {
+    const auto start = Clock::now();
+    const auto worker_count = static_cast<std::size_t>(std::max(options.threads, 1));
+    const std::size_t batch_size = std::max<std::size_t>(options.batch_size, 1);
+    ReplayQueue<Item> queue(worker_count * kBatchesPerWorker);
+
+    ReplayStats stats;
+    {
+        std::jthread splitter([&] {
+            std::uint64_t sequence = 0;
+            std::uint64_t index = 0;
+            Batch<Item> batch;
+            const auto flush = [&] {
+                batch.sequence = sequence++;
+                batch.first_index = index;
+                index += batch.games.size();
+                queue.pushWork(std::exchange(batch, Batch<Item>{}));
+            };
+            split([&](Item item) {
+                batch.games.push_back(std::move(item));
+                if (batch.games.size() == batch_size) flush();
+            });
+            if (!batch.games.empty()) flush();
+            queue.finishInput(sequence);
+        });
+
+        std::vector<std::jthread> workers;
+        workers.reserve(worker_count);
+        for (std::size_t i = 0; i < worker_count; ++i) {
+            workers.emplace_back([&] {
+                chess::ChessGame game;
+                while (auto batch = queue.popWork()) {
+                    std::vector<GameReport> reports;
+                    reports.reserve(batch->games.size());
+                    for (std::size_t g = 0; g < batch->games.size(); ++g) {
+                        reports.push_back(replay(game, batch->games[g], batch->first_index + g));
+                    }
+                    queue.pushResult(batch->sequence, std::move(reports));
+                }
+            });
+        }
+
+        while (const auto reports = queue.popResultInOrder()) {
+            for (const GameReport& report : *reports) {
+                ++stats.games;
+                stats.failed += report.ok() ? 0 : 1;
+                stats.plies += static_cast<std::uint64_t>(report.plies);
+                if (on_game) on_game(report);
+            }
+        }
+    } // Joins the splitter and workers
+
+    stats.elapsed = Clock::now() - start;
+    return stats;
+}
+
+} // namespace
+
+// ============================================================================
+// Collections
+// ============================================================================
+
+ReplayStats replayGames(std::string_view pgn, const ReplayOptions& options,
+                        const ReportSink& on_game) {
+    return runPipeline<chess::PgnGame>(
+        options, on_game,
+        [&](const auto& push) {
+            chess::PgnReader reader(pgn);
+            while (const auto game = reader.next()) {
+                push(*game);
+            }
+        },
+        [&](chess::ChessGame& game, const chess::PgnGame& pgn_game, std::uint64_t index) {
+            return replayGame(game, pgn_game, index, options.keep_moves);
+        });
+}
+
+ReplayStats replayArchive(const GameArchiveReader& archive, const ReplayOptions& options,
+                          const ReportSink& on_game) {
+    return runPipeline<std::size_t>(
+        options, on_game,
+        [&](const auto& push) {
+            for (std::size_t n = 0; n < archive.size(); ++n) {
+                push(n);
+            }
+        },
+        [&](chess::ChessGame& game, std::size_t n, std::uint64_t index) {
+            GameReport report{.index = index};
+            const auto record = archive.game(n);
+            if (!record || !archive.replay(*record, game)) {
+                report.error = kCorruptRecord;
+                return report;
+            }
+            report.result = record->result;
+            report.start_fen = record->start_fen;
+            report.plies = record->plies;
+            report.final_state = finalState(game);
+            report.final_key = game.positionKey();
+            return report;
+        });
+}
+
+} // namespace batch
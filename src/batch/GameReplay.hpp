@@ -0,0 +1,92 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+#include "core/PackedMove.hpp"
+#include "core/Pgn.hpp"
+#include "core/Zobrist.hpp"
+
+/// @file GameReplay.hpp
+/// @brief Parallel replay of PGN game collections.
+
+namespace chess {
+class ChessGame;
+}
+
+namespace batch {
+
+class GameArchiveReader;
+
+/// How a replayed game's final position stands.
+enum class FinalState : std::uint8_t {
+    Ongoing,    ///< The side to move has legal moves
+    Checkmate,
+    Stalemate
+};
+
+/// Outcome of replaying one game.
+struct GameReport {
+    std::uint64_t index{0};  ///< 0-based position of the game in the input
+    std::string_view start_fen{};  ///< FEN tag of the input; empty for the start position
+    chess::GameResult result{chess::GameResult::Unknown};  ///< As recorded in the PGN
+    int plies{0};            ///< Moves replayed before the end or the first error
+    /// The first move that did not parse as a legal SAN move (or the FEN tag
+    /// if it was invalid); empty if the whole game replayed. Views the input.
+    std::string_view error{};
+    FinalState final_state{FinalState::Ongoing};
+    chess::zobrist::Key final_key{0};
+    /// The moves replayed, if ReplayOptions::keep_moves was set.
+    std::vector<chess::PackedMove> moves{};
+
+    [[nodiscard]] bool ok() const noexcept { return error.empty(); }
+};
+
+/// Totals over a replay run.
+struct ReplayStats {
+    std::uint64_t games{0};
+    std::uint64_t failed{0};  ///< Games with a report error
+    std::uint64_t plies{0};
+    std::chrono::duration<double> elapsed{};
+
+    [[nodiscard]] double gamesPerSecond() const noexcept {
+        return elapsed.count() > 0.0 ? static_cast<double>(games) / elapsed.count() : 0.0;
+    }
+};
+
+struct ReplayOptions {
+    int threads{1};               ///< Replay workers, each with its own ChessGame
+    std::size_t batch_size{256};  ///< Games handed to a worker at a time
+    bool keep_moves{false};       ///< Fill GameReport::moves (PGN input only)
+};
+
+/// Receives reports in input order, on the thread that called replayGames().
+using ReportSink = std::function<void(const GameReport&)>;
+
+/// Replay one game from the start position (or its FEN tag) in `game`.
+/// @param keep_moves Record the replayed moves in GameReport::moves
+[[nodiscard]] GameReport replayGame(chess::ChessGame& game, const chess::PgnGame& pgn,
+                                    std::uint64_t index = 0, bool keep_moves = false);
+
+/// Replay every game of a PGN collection on a pool of worker threads.
+///
+/// One thread splits the input into batches of games, the workers parse and
+/// replay them, and the caller's thread hands reports to `on_game` in input
+/// order. A bounded number of batches is in flight, so memory use does not
+/// grow with the input size.
+/// @param pgn Complete PGN text, typically MappedFile::text(); must outlive
+///            the call (reports view it)
+[[nodiscard]] ReplayStats replayGames(std::string_view pgn, const ReplayOptions& options,
+                                      const ReportSink& on_game = {});
+
+/// Replay every game of a binary archive, like replayGames().
+///
+/// No text is parsed, so the cost is move generation alone; corrupt records
+/// are reported as errors.
+[[nodiscard]] ReplayStats replayArchive(const GameArchiveReader& archive,
+                                        const ReplayOptions& options,
+                                        const ReportSink& on_game = {});
+
+} // namespace batch
@@ -0,0 +1,382 @@
+#include "PositionBatch.hpp"
+#include <algorithm>
+#include <execution>
+#include <version>
+#include "core/Attacks.hpp"
+
+namespace batch {
+
+using chess::Bitboard;
+using chess::Color;
+using chess::PieceType;
+
+namespace {
+
+// ============================================================================
+// Position View
+// ============================================================================
+
+/// One position's columns, copied out of the batch.
+struct Position {
+    std::array<Bitboard, chess::kPieceTypeCount> pieces;
+    std::array<Bitboard, chess::kColorCount> colors;
+    Color side;
+    std::uint8_t castling;
+    std::int8_t en_passant;
+
+    [[nodiscard]] Bitboard of(PieceType type) const noexcept {
+        return pieces[static_cast<std::size_t>(type)];
+    }
+
+    [[nodiscard]] Bitboard of(Color color) const noexcept {
+        return colors[static_cast<std::size_t>(color)];
+    }
+
+    [[nodiscard]] Bitboard of(PieceType type, Color color) const noexcept {
+        return of(type) & of(color);
+    }
+};
+
+[[nodiscard]] Position positionAt(const PositionBatch& batch, std::size_t i) noexcept {
+    Position position{
+        .pieces = {},
+        .colors = {},
+        .side = batch.sideToMove()[i],
+        .castling = batch.castling()[i],
+        .en_passant = batch.enPassant()[i]
+    };
+    for (std::size_t type = 0; type < position.pieces.size(); ++type) {
+        position.pieces[type] = batch.pieces(static_cast<PieceType>(type))[i];
+    }
+    for (std::size_t color = 0; color < position.colors.size(); ++color) {
+        position.colors[color] = batch.pieces(static_cast<Color>(color))[i];
+    }
+    return position;
+}
+
+/// Pieces of both colors attacking `index`, as in Rules.
+[[nodiscard]] Bitboard attackersTo(const Position& position, int index,
+                                   Bitboard occupied) noexcept {
+    const Bitboard queens = position.of(PieceType::Queen);
+    return (chess::pawnAttacks(Color::White, index) & position.of(PieceType::Pawn, Color::Black)) |
+           (chess::pawnAttacks(Color::Black, index) & position.of(PieceType::Pawn, Color::White)) |
+           (chess::knightAttacks(index) & position.of(PieceType::Knight)) |
+           (chess::kingAttacks(index) & position.of(PieceType::King)) |
+           (chess::bishopAttacks(index, occupied) & (position.of(PieceType::Bishop) | queens)) |
+           (chess::rookAttacks(index, occupied) & (position.of(PieceType::Rook) | queens));
+}
+
+// ============================================================================
+// Move Counting
+// ============================================================================
+
+/// The facts Rules' generators share, for counting instead of generating.
+struct CountContext {
+    const Position& position;
+    Color side;
+    int king;
+    Bitboard own;
+    Bitboard enemies;
+    Bitboard occupied;
+    Bitboard checkers;
+    Bitboard pinned;
+    Bitboard evasion_mask;
+};
+
+[[nodiscard]] Bitboard pinnedPieces(const Position& position, Color side, int king) noexcept {
+    const Color enemy = chess::opponent(side);
+    const Bitboard queens = position.of(PieceType::Queen, enemy);
+    Bitboard snipers = (chess::rookAttacks(king, chess::kEmptyBitboard) &
+                        (position.of(PieceType::Rook, enemy) | queens)) |
+                       (chess::bishopAttacks(king, chess::kEmptyBitboard) &
+                        (position.of(PieceType::Bishop, enemy) | queens));
+
+    const Bitboard occupied = position.of(Color::White) | position.of(Color::Black);
+    Bitboard pinned = chess::kEmptyBitboard;
+    while (snipers) {
+        const Bitboard blockers = chess::betweenBits(king, chess::popLsb(snipers)) & occupied;
+        if (chess::popCount(blockers) == 1) {
+            pinned |= blockers & position.of(side);
+        }
+    }
+    return pinned;
+}
+
+/// Destinations allowed for the piece on `from`, as in Rules.
+[[nodiscard]] Bitboard allowedTargets(const CountContext& ctx, int from) noexcept {
+    return chess::contains(ctx.pinned, from) ? ctx.evasion_mask & chess::lineBits(ctx.king, from)
+                                             : ctx.evasion_mask;
+}
+
+/// Promotions count once per piece they can promote to.
+constexpr int kPromotionPieces = 4;
+
+/// Pawn targets for a set of pawns, counted with whole-board shifts: pushes
+/// and each capture direction are one bitboard each, so a pawn's targets
+/// never collide with another pawn's within one of them.
+[[nodiscard]] int countPawnTargets(Bitboard targets, Bitboard promotion_rank) noexcept {
+    return chess::popCount(targets & ~promotion_rank) +
+           kPromotionPieces * chess::popCount(targets & promotion_rank);
+}
+
+[[nodiscard]] int countPawnMoves(const CountContext& ctx) noexcept {
+    const bool white = ctx.side == Color::White;
+    const Bitboard promotion_rank = chess::rankMask(white ? 0 : chess::kBoardSize - 1);
+    const Bitboard double_push_rank = chess::rankMask(white ? 5 : 2);
+    const auto forward = [white](Bitboard bb) { return white ? bb >> 8 : bb << 8; };
+    const auto captureWest = [white](Bitboard bb) {
+        bb &= ~chess::kFileA;
+        return white ? bb >> 9 : bb << 7;
+    };
+    const auto captureEast = [white](Bitboard bb) {
+        bb &= ~chess::kFileH;
+        return white ? bb >> 7 : bb << 9;
+    };
+
+    const Bitboard pawns = ctx.position.of(PieceType::Pawn, ctx.side);
+    const Bitboard empty = ~ctx.occupied;
+
+    // Unpinned pawns all share the evasion mask
+    const Bitboard free_pawns = pawns & ~ctx.pinned;
+    const Bitboard single = forward(free_pawns) & empty;
+    const Bitboard twice = forward(single & double_push_rank) & empty;
+    int count = countPawnTargets(single & ctx.evasion_mask, promotion_rank) +
+                countPawnTargets(twice & ctx.evasion_mask, promotion_rank) +
+                countPawnTargets(captureWest(free_pawns) & ctx.enemies & ctx.evasion_mask,
+                                 promotion_rank) +
+                countPawnTargets(captureEast(free_pawns) & ctx.enemies & ctx.evasion_mask,
+                                 promotion_rank);
+
+    // Pinned pawns only move along their pin ray
+    for (Bitboard pinned = pawns & ctx.pinned; pinned;) {
+        const int from = chess::popLsb(pinned);
+        const Bitboard pawn = chess::squareBit(from);
+        const Bitboard one = forward(pawn) & empty;
+        const Bitboard targets = one | (forward(one & double_push_rank) & empty) |
+                                 (chess::pawnAttacks(ctx.side, from) & ctx.enemies);
+        count += countPawnTargets(targets & allowedTargets(ctx, from), promotion_rank);
+    }
+
+    // En-passant can expose the king along the rank, so each capture is
+    // verified on the post-capture occupancy, as in Rules
+    if (ctx.position.en_passant != PositionBatch::kNoEnPassant) {
+        const int to = ctx.position.en_passant;
+        const int victim = white ? to + chess::kBoardSize : to - chess::kBoardSize;
+        const Bitboard enemies = ctx.enemies & ~chess::squareBit(victim);
+        for (Bitboard capturers = chess::pawnAttacks(chess::opponent(ctx.side), to) & pawns;
+             capturers;) {
+            const int from = chess::popLsb(capturers);
+            const Bitboard occupied = (ctx.occupied ^ chess::squareBit(from) ^
+                                       chess::squareBit(victim)) | chess::squareBit(to);
+            if ((attackersTo(ctx.position, ctx.king, occupied) & enemies) == 0) ++count;
+        }
+    }
+    return count;
+}
+
+[[nodiscard]] int countPieceMoves(const CountContext& ctx) noexcept {
+    int count = 0;
+    // Pinned knights can never move along the pin ray
+    for (Bitboard knights = ctx.position.of(PieceType::Knight, ctx.side) & ~ctx.pinned;
+         knights;) {
+        count += chess::popCount(chess::knightAttacks(chess::popLsb(knights)) & ctx.evasion_mask);
+    }
+
+    // Queens count as both sliders: their rook and bishop targets are disjoint
+    const Bitboard queens = ctx.position.of(PieceType::Queen, ctx.side);
+    for (Bitboard sliders = ctx.position.of(PieceType::Bishop, ctx.side) | queens; sliders;) {
+        const int from = chess::popLsb(sliders);
+        count += chess::popCount(chess::bishopAttacks(from, ctx.occupied) &
+                                 allowedTargets(ctx, from));
+    }
+    for (Bitboard sliders = ctx.position.of(PieceType::Rook, ctx.side) | queens; sliders;) {
+        const int from = chess::popLsb(sliders);
+        count += chess::popCount(chess::rookAttacks(from, ctx.occupied) &
+                                 allowedTargets(ctx, from));
+    }
+    return count;
+}
+
+/// Every square the enemy attacks, with the king lifted from the occupancy
+/// so that sliders checking it also cover the squares behind it. One map
+/// answers all king destinations and castling transit squares, where Rules
+/// asks per square.
+[[nodiscard]] Bitboard enemyAttacks(const CountContext& ctx) noexcept {
+    const Position& position = ctx.position;
+    const Color enemy = chess::opponent(ctx.side);
+    const Bitboard occupied = ctx.occupied ^ chess::squareBit(ctx.king);
+
+    const Bitboard pawns = position.of(PieceType::Pawn, enemy);
+    const Bitboard west = pawns & ~chess::kFileA;
+    const Bitboard east = pawns & ~chess::kFileH;
+    Bitboard attacked = enemy == Color::White ? (west >> 9) | (east >> 7)
+                                              : (west << 7) | (east << 9);
+
+    for (Bitboard knights = position.of(PieceType::Knight, enemy); knights;) {
+        attacked |= chess::knightAttacks(chess::popLsb(knights));
+    }
+    const Bitboard queens = position.of(PieceType::Queen, enemy);
+    for (Bitboard sliders = position.of(PieceType::Bishop, enemy) | queens; sliders;) {
+        attacked |= chess::bishopAttacks(chess::popLsb(sliders), occupied);
+    }
+    for (Bitboard sliders = position.of(PieceType::Rook, enemy) | queens; sliders;) {
+        attacked |= chess::rookAttacks(chess::popLsb(sliders), occupied);
+    }
+    if (const Bitboard king = position.of(PieceType::King, enemy)) {
+        attacked |= chess::kingAttacks(chess::lsbIndex(king));
+    }
+    return attacked;
+}
+
+/// Lifting the king does not change what the transit squares see: anything
+/// reaching them through the king's square would be giving check.
+[[nodiscard]] int countCastling(const CountContext& ctx, Bitboard attacked) noexcept {
+    const bool white = ctx.side == Color::White;
+    const int home_rank = white ? chess::kBoardSize - 1 : 0;
+    const int king_home = chess::toIndex({home_rank, 4});
+    if (ctx.king != king_home || ctx.checkers) return 0;
+
+    const Bitboard rooks = ctx.position.of(PieceType::Rook, ctx.side);
+    const auto canCastle = [&](int right, int rook_file, int transit_a, int transit_b) {
+        const int rook = chess::toIndex({home_rank, rook_file});
+        const Bitboard transit = chess::squareBit(chess::toIndex({home_rank, transit_a})) |
+                                 chess::squareBit(chess::toIndex({home_rank, transit_b}));
+        return (ctx.position.castling & (1u << right)) != 0 && chess::contains(rooks, rook) &&
+               (ctx.occupied & chess::betweenBits(king_home, rook)) == 0 &&
+               (attacked & transit) == 0;
+    };
+    const int kingside = white ? 0 : 2;
+    return int{canCastle(kingside, 7, 5, 6)} + int{canCastle(kingside + 1, 0, 3, 2)};
+}
+
+[[nodiscard]] int countKingMoves(const CountContext& ctx) noexcept {
+    const Bitboard attacked = enemyAttacks(ctx);
+    return chess::popCount(chess::kingAttacks(ctx.king) & ~ctx.own & ~attacked) +
+           countCastling(ctx, attacked);
+}
+
+void analyzeOne(const Position& position, std::uint8_t& legal_moves,
+                PositionStatus& status) noexcept {
+    const Color side = position.side;
+    const Bitboard kings = position.of(PieceType::King, side);
+    if (!kings) {
+        legal_moves = 0;
+        status = PositionStatus::Stalemate;
+        return;
+    }
+
+    const int king = chess::lsbIndex(kings);
+    const Bitboard own = position.of(side);
+    const Bitboard enemies = position.of(chess::opponent(side));
+    const Bitboard occupied = own | enemies;
+    const Bitboard checkers = attackersTo(position, king, occupied) & enemies;
+    const CountContext ctx{
+        .position = position,
+        .side = side,
+        .king = king,
+        .own = own,
+        .enemies = enemies,
+        .occupied = occupied,
+        .checkers = checkers,
+        .pinned = pinnedPieces(position, side, king),
+        .evasion_mask = checkers ? checkers | chess::betweenBits(king, chess::lsbIndex(checkers))
+                                 : ~own
+    };
+
+    int count = countKingMoves(ctx);
+    // In double check only the king may move
+    if (chess::popCount(checkers) < 2) {
+        count += countPawnMoves(ctx) + countPieceMoves(ctx);
+    }
+
+    legal_moves = static_cast<std::uint8_t>(count);
+    if (count == 0) {
+        status = checkers ? PositionStatus::Checkmate : PositionStatus::Stalemate;
+    } else {
+        status = checkers ? PositionStatus::Check : PositionStatus::Normal;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// PositionBatch
+// ============================================================================
+
+void PositionBatch::push_back(const chess::Board& board, Color side) {
+    for (std::size_t type = 0; type < pieces_.size(); ++type) {
+        pieces_[type].push_back(board.pieces(static_cast<PieceType>(type)));
+    }
+    for (std::size_t color = 0; color < colors_.size(); ++color) {
+        colors_[color].push_back(board.pieces(static_cast<Color>(color)));
+    }
+    side_to_move_.push_back(side);
+
+    std::uint8_t castling = 0;
+    const auto& rights = board.castlingRights();
+    for (std::size_t i = 0; i < rights.size(); ++i) {
+        if (rights[i]) castling |= static_cast<std::uint8_t>(1u << i);
+    }
+    castling_.push_back(castling);
+
+    const auto ep = board.enPassantSquare();
+    en_passant_.push_back(ep ? static_cast<std::int8_t>(chess::toIndex(*ep)) : kNoEnPassant);
+}
+
+void PositionBatch::reserve(std::size_t count) {
+    for (auto& column : pieces_) column.reserve(count);
+    for (auto& column : colors_) column.reserve(count);
+    side_to_move_.reserve(count);
+    castling_.reserve(count);
+    en_passant_.reserve(count);
+}
+
+void PositionBatch::clear() noexcept {
+    for (auto& column : pieces_) column.clear();
+    for (auto& column : colors_) column.clear();
+    side_to_move_.clear();
+    castling_.clear();
+    en_passant_.clear();
+}
+
+// ============================================================================
+// Analysis
+// ============================================================================
+
+void analyzePositions(const PositionBatch& positions, BatchAnalysis& analysis,
+                      const AnalysisOptions& options) {
+    const std::size_t count = positions.size();
+    analysis.legal_moves.resize(count);
+    analysis.status.resize(count);
+
+    // Blocks keep each task's writes to its own cache lines
+    const std::size_t block_size = std::max<std::size_t>(options.block_size, 1);
+    std::vector<std::size_t> blocks;
+    blocks.reserve(count / block_size + 1);
+    for (std::size_t begin = 0; begin < count; begin += block_size) {
+        blocks.push_back(begin);
+    }
+
+    const auto analyzeBlock = [&](std::size_t begin) {
+        const std::size_t end = std::min(begin + block_size, count);
+        for (std::size_t i = begin; i < end; ++i) {
+            analyzeOne(positionAt(positions, i), analysis.legal_moves[i], analysis.status[i]);
+        }
+    };
+
+#if defined(__cpp_lib_execution)
+    if (options.parallel && blocks.size() > 1) {
+        std::for_each(std::execution::par, blocks.begin(), blocks.end(), analyzeBlock);
+        return;
+    }
+#endif
+    std::for_each(blocks.begin(), blocks.end(), analyzeBlock);
+}
+
+BatchAnalysis analyzePositions(const PositionBatch& positions, const AnalysisOptions& options) {
+    BatchAnalysis analysis;
+    analyzePositions(positions, analysis, options);
+    return analysis;
+}
+
+} // namespace batch
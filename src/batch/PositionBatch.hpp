@@ -0,0 +1,97 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "core/Bitboard.hpp"
+#include "core/Board.hpp"
+#include "core/Types.hpp"
+
+/// @file PositionBatch.hpp
+/// @brief Check, mate and legal move count analysis of many positions at once.
+
+namespace batch {
+
+/// Many positions stored column by column (structure of arrays): one
+/// bitboard array per piece type and per color, then the side to move,
+/// castling rights and en-passant square of each position.
+///
+/// Analysis touches only the bitboards, so a batch is several times smaller
+/// than the chess::Board objects it is built from and streams through the
+/// cache one column at a time.
+class PositionBatch {
+public:
+    static constexpr std::int8_t kNoEnPassant = -1;
+
+    /// Append a position.
+    void push_back(const chess::Board& board, chess::Color side);
+
+    void reserve(std::size_t count);
+    void clear() noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept { return side_to_move_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return side_to_move_.empty(); }
+
+    [[nodiscard]] std::span<const chess::Bitboard> pieces(chess::PieceType type) const noexcept {
+        return pieces_[static_cast<std::size_t>(type)];
+    }
+
+    [[nodiscard]] std::span<const chess::Bitboard> pieces(chess::Color color) const noexcept {
+        return colors_[static_cast<std::size_t>(color)];
+    }
+
+    [[nodiscard]] std::span<const chess::Color> sideToMove() const noexcept {
+        return side_to_move_;
+    }
+
+    /// Castling rights in bits 0-3, chess::CastlingRights order.
+    [[nodiscard]] std::span<const std::uint8_t> castling() const noexcept { return castling_; }
+
+    /// Square index, or kNoEnPassant.
+    [[nodiscard]] std::span<const std::int8_t> enPassant() const noexcept { return en_passant_; }
+
+private:
+    std::array<std::vector<chess::Bitboard>, chess::kPieceTypeCount> pieces_;
+    std::array<std::vector<chess::Bitboard>, chess::kColorCount> colors_;
+    std::vector<chess::Color> side_to_move_;
+    std::vector<std::uint8_t> castling_;
+    std::vector<std::int8_t> en_passant_;
+};
+
+/// How a position stands for its side to move.
+enum class PositionStatus : std::uint8_t {
+    Normal,     ///< Not in check, has legal moves
+    Check,      ///< In check, has legal moves
+    Checkmate,
+    Stalemate   ///< Also a position without a king of the side to move
+};
+
+/// Per-position results, indexed like the batch.
+struct BatchAnalysis {
+    /// Legal moves of the side to move; each promotion piece counts (at most 218).
+    std::vector<std::uint8_t> legal_moves;
+    std::vector<PositionStatus> status;
+
+    [[nodiscard]] std::size_t size() const noexcept { return status.size(); }
+};
+
+struct AnalysisOptions {
+    bool parallel{true};           ///< Spread blocks over std::execution::par
+    std::size_t block_size{4096};  ///< Positions analyzed per task
+};
+
+/// Analyze every position of a batch, reusing `analysis`'s storage.
+///
+/// Agrees with chess::Rules (legalMoves().size(), isCheck(), isCheckmate()
+/// and isStalemate()) on every position, but counts moves on the bitboards
+/// without generating them.
+/// @note Runs serially if the standard library has no parallel algorithms.
+void analyzePositions(const PositionBatch& positions, BatchAnalysis& analysis,
+                      const AnalysisOptions& options = {});
+
+/// Convenience overload returning a new result.
+[[nodiscard]] BatchAnalysis analyzePositions(const PositionBatch& positions,
+                                             const AnalysisOptions& options = {});
+
+} // namespace batch
@@ -0,0 +1,379 @@
+#include "batch/PositionBatch.hpp"
+#include "core/Attacks.hpp"
+#include "core/ChessGame.hpp"
+#include "core/Fen.hpp"
+#include "core/Instrumentation.hpp"
+#include "core/MoveList.hpp"
+#include "core/Notation.hpp"
+#include "core/Rules.hpp"
+#include "engine/Engine.hpp"
+#include "engine/NnueKernels.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// @file main.cpp
+/// @brief chess_bench: Google Benchmark micro-benchmarks for the core
+/// primitives and the search, over fixed position sets.
+///
+/// Usage:
+///   chess_bench [--benchmark_filter=<regex>] [--benchmark_repetitions=N]
+///               [--benchmark_format=json] [--benchmark_out=<file.json>]
+///
+/// Every position benchmark runs once per set (opening, middlegame, endgame)
+/// and reports items/s, where an item is one call of the measured function.
+/// The JSON context records the compiler, the CHESS_USE_PEXT and
+/// CHESS_INSTRUMENT settings and the NNUE kernels chosen, so results from
+/// different builds and machines can be told apart (e.g. with Google
+/// Benchmark's tools/compare.py). NNUE kernel benchmarks run once per
+/// instruction set the CPU supports.
+
+namespace {
+
+// ============================================================================
+// Fixed Inputs
+// ============================================================================
+
+constexpr std::array<std::string_view, 4> kOpeningFens = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq c6 0 2",
+    "rnbqkb1r/pppp1ppp/5n2/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+    "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3",
+};
+
+constexpr std::array<std::string_view, 6> kMiddlegameFens = {
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r2q1rk1/pp1nbppp/2p1pn2/3p4/2PP4/2NBPN2/PP3PPP/R2Q1RK1 w - - 0 9",
+    "2rq1rk1/pp1bppbp/3p1np1/4n3/3NP3/1BN1BP2/PPPQ2PP/2KR3R w - - 0 13",
+    "r1b2rk1/2q1bppp/p2ppn2/1p6/3BPP2/2NB4/PPP1Q1PP/2KR3R w - - 0 14",
+};
+
+constexpr std::array<std::string_view, 5> kEndgameFens = {
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "8/8/4k3/3p4/3P4/4K3/8/8 w - - 0 1",
+    "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+    "8/5pk1/6p1/7p/3R3P/6P1/r4PK1/8 b - - 0 40",
+    "8/8/8/3k4/8/8/2QK4/8 w - - 0 1",
+};
+
+struct PositionSet {
+    std::string_view name;
+    std::span<const std::string_view> fens;
+};
+
+constexpr std::array<PositionSet, 3> kPositionSets = {{
+    {"opening", kOpeningFens},
+    {"middlegame", kMiddlegameFens},
+    {"endgame", kEndgameFens},
+}};
+
+/// Ruy Lopez, Closed: 22 plies including castling, from the start position.
+constexpr std::array<std::string_view, 22> kGameMoves = {
+    "e2e4", "e7e5", "g1f3", "b8c6", "f1b5", "a7a6", "b5a4", "g8f6", "e1g1", "f8e7", "f1e1",
+    "b7b5", "a4b3", "d7d6", "c2c3", "e8g8", "h2h3", "c6a5", "b3c2", "c7c5", "d2d4", "d8c7",
+};
+
+/// Search depth for Engine::search; each iteration searches the whole set.
+constexpr int kSearchDepth = 4;
+constexpr std::size_t kSearchHashMb = 16;
+
+/// Positions per batch::analyzePositions call.
+constexpr std::size_t kBatchPositions = 4096;
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+/// @return nullopt (after naming the culprit) if a FEN is malformed
+[[nodiscard]] std::optional<std::vector<chess::FenPosition>> loadPositions(
+    std::span<const std::string_view> fens) {
+    std::vector<chess::FenPosition> positions;
+    for (const std::string_view fen : fens) {
+        auto position = chess::parseFen(fen);
+        if (!position) {
+            std::cerr << "chess_bench: invalid FEN: " << fen << '\n';
+            return std::nullopt;
+        }
+        positions.push_back(*position);
+    }
+    return positions;
+}
+
+/// @return nullopt (after naming the culprit) if a move is illegal
+[[nodiscard]] std::optional<std::vector<chess::Move>> loadGame(
+    std::span<const std::string_view> uci_moves) {
+    chess::ChessGame game;
+    std::vector<chess::Move> moves;
+    for (const std::string_view text : uci_moves) {
+        const chess::MoveList& legal = game.legalMoveList();
+        const auto it = std::ranges::find_if(
+            legal, [&](const chess::Move& move) { return chess::toUci(move) == text; });
+        if (it == legal.end()) {
+            std::cerr << "chess_bench: illegal move in game line: " << text << '\n';
+            return std::nullopt;
+        }
+        const chess::Move move = *it;
+        static_cast<void>(game.makeMove(move));
+        moves.push_back(move);
+    }
+    return moves;
+}
+
+[[nodiscard]] std::string compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+    return "unknown";
+#endif
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+using Positions = std::span<const chess::FenPosition>;
+
+/// Quiet piece moves, each played there and back so the boards never change.
+void benchMovePiece(benchmark::State& state, Positions positions) {
+    struct QuietMove {
+        std::size_t board;
+        chess::Move move;
+    };
+    std::vector<chess::Board> boards;
+    std::vector<QuietMove> moves;
+    for (const chess::FenPosition& position : positions) {
+        for (const chess::Move& move : chess::Rules{}.legalMoves(position.board,
+                                                                 position.side_to_move)) {
+            const bool special = move.castling || move.en_passant || move.isPromotion();
+            if (!special && !position.board.hasPieceAt(move.to)) {
+                moves.push_back({.board = boards.size(), .move = move});
+            }
+        }
+        boards.push_back(position.board);
+    }
+    if (moves.empty()) {
+        state.SkipWithError("no quiet moves in the set");
+        return;
+    }
+
+    std::size_t next = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const QuietMove& quiet = moves[next];
+        chess::Board& board = boards[quiet.board];
+        board.movePiece(quiet.move);
+        board.movePiece({.from = quiet.move.to, .to = quiet.move.from});
+        benchmark::ClobberMemory();
+        next = next + 1 == moves.size() ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(2 * state.iterations());
+}
+
+/// Every legal move of each position, made and unmade (incremental hashing included).
+void benchMakeUnmake(benchmark::State& state, Positions positions) {
+    std::vector<chess::Board> boards;
+    std::vector<chess::MoveList> moves(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        chess::Rules{}.legalMoves(positions[i].board, positions[i].side_to_move, moves[i]);
+        boards.push_back(positions[i].board);
+    }
+
+    std::int64_t made = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        for (std::size_t i = 0; i < boards.size(); ++i) {
+            for (const chess::Move& move : moves[i]) {
+                const chess::UndoInfo undo = boards[i].makeMove(move);
+                benchmark::DoNotOptimize(boards[i].key());
+                boards[i].unmakeMove(move, undo);
+            }
+            made += static_cast<std::int64_t>(moves[i].size());
+        }
+    }
+    state.SetItemsProcessed(made);
+}
+
+/// Check tests for both sides of each position.
+void benchIsCheck(benchmark::State& state, Positions positions) {
+    const chess::Rules rules;
+    for ([[maybe_unused]] auto _ : state) {
+        for (const chess::FenPosition& position : positions) {
+            benchmark::DoNotOptimize(rules.isCheck(position.board, chess::Color::White));
+            benchmark::DoNotOptimize(rules.isCheck(position.board, chess::Color::Black));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * static_cast<std::int64_t>(positions.size()));
+}
+
+/// Legal move generation into a reused list, as the search and ChessGame do.
+void benchLegalMoves(benchmark::State& state, Positions positions) {
+    const chess::Rules rules;
+    chess::MoveList moves;
+    for ([[maybe_unused]] auto _ : state) {
+        for (const chess::FenPosition& position : positions) {
+            rules.legalMoves(position.board, position.side_to_move, moves);
+            benchmark::DoNotOptimize(moves.size());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()));
+}
+
+/// Batch analysis of the set repeated to kBatchPositions, on the calling
+/// thread so items/s compares with Rules::legalMoves.
+void benchAnalyzePositions(benchmark::State& state, Positions positions) {
+    batch::PositionBatch batch;
+    batch.reserve(kBatchPositions);
+    while (batch.size() < kBatchPositions) {
+        const chess::FenPosition& position = positions[batch.size() % positions.size()];
+        batch.push_back(position.board, position.side_to_move);
+    }
+    batch::BatchAnalysis analysis;
+    for ([[maybe_unused]] auto _ : state) {
+        batch::analyzePositions(batch, analysis, {.parallel = false});
+        benchmark::DoNotOptimize(analysis.legal_moves.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch.size()));
+}
+
+/// A fixed game replayed through ChessGame, restarted with newGame() each time.
+void benchGameMakeMove(benchmark::State& state, std::span<const chess::Move> moves) {
+    chess::ChessGame game;
+    for ([[maybe_unused]] auto _ : state) {
+        for (const chess::Move& move : moves) {
+            benchmark::DoNotOptimize(game.makeMove(move));
+        }
+        game.newGame();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(moves.size()));
+}
+
+/// Single-threaded fixed-depth search of each position from an empty hash table.
+void benchSearch(benchmark::State& state, Positions positions) {
+    engine::Engine engine(kSearchHashMb);
+    const engine::SearchLimits limits{.depth = static_cast<int>(state.range(0))};
+    std::uint64_t nodes = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        for (const chess::FenPosition& position : positions) {
+            state.PauseTiming();
+            engine.clearHash();
+            state.ResumeTiming();
+            nodes += engine.search(position.board, position.side_to_move, limits).info.nodes;
+        }
+    }
+    state.counters["nodes"] = benchmark::Counter(static_cast<double>(nodes),
+                                                 benchmark::Counter::kIsRate);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()));
+}
+
+/// Random accumulator-sized rows for the NNUE kernel benchmarks.
+struct NnueRows {
+    static constexpr int kRows = 6;
+
+    explicit NnueRows(std::uint32_t seed) {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<int> value(-300, 300);
+        for (auto& one : rows) {
+            for (std::int16_t& lane : one) lane = static_cast<std::int16_t>(value(random));
+        }
+    }
+
+    [[nodiscard]] const std::int16_t* operator[](int i) const noexcept { return rows[i].data(); }
+
+    // The output layer reads two rows as one 2 * kHidden weight vector
+    alignas(64) std::array<std::array<std::int16_t, engine::nnue::kHidden>, kRows> rows{};
+};
+
+/// One accumulator update the size of a capture: two rows in, two out, per
+/// perspective as the search does it.
+void benchNnueUpdate(benchmark::State& state, const engine::nnue::Kernels* kernels) {
+    const NnueRows rows(1);
+    alignas(64) std::array<std::int16_t, engine::nnue::kHidden> accumulator = rows.rows[0];
+    const std::array<const std::int16_t*, 2> added = {rows[1], rows[2]};
+    const std::array<const std::int16_t*, 2> removed = {rows[3], rows[4]};
+    for ([[maybe_unused]] auto _ : state) {
+        kernels->update(accumulator.data(), accumulator.data(), added.data(), 2, removed.data(), 2);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// The output layer of one evaluation: both perspectives, clipped and weighted.
+void benchNnueOutput(benchmark::State& state, const engine::nnue::Kernels* kernels) {
+    const NnueRows rows(2);
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(kernels->output(rows[0], rows[1], rows[2]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+using PositionBenchmark = void (*)(benchmark::State&, Positions);
+
+/// Register a position benchmark for one set, as "<name>/<set>".
+benchmark::internal::Benchmark* registerForSet(std::string_view name, std::string_view set,
+                                               PositionBenchmark function, Positions positions) {
+    std::string full_name{name};
+    full_name += '/';
+    full_name += set;
+    return benchmark::RegisterBenchmark(full_name.c_str(), function, positions);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    // Benchmarks refer to these until they have all run
+    std::vector<std::vector<chess::FenPosition>> sets;
+    for (const PositionSet& set : kPositionSets) {
+        auto positions = loadPositions(set.fens);
+        if (!positions) return 1;
+        sets.push_back(std::move(*positions));
+    }
+    const auto game = loadGame(kGameMoves);
+    if (!game) return 1;
+
+    for (std::size_t i = 0; i < kPositionSets.size(); ++i) {
+        const Positions positions = sets[i];
+        const std::string_view set = kPositionSets[i].name;
+        registerForSet("Board::movePiece", set, benchMovePiece, positions);
+        registerForSet("Board::makeMove+unmakeMove", set, benchMakeUnmake, positions);
+        registerForSet("Rules::isCheck", set, benchIsCheck, positions);
+        registerForSet("Rules::legalMoves", set, benchLegalMoves, positions);
+        registerForSet("batch::analyzePositions", set, benchAnalyzePositions, positions);
+        registerForSet("Engine::search", set, benchSearch, positions)
+            ->Arg(kSearchDepth)
+            ->ArgName("depth")
+            ->Unit(benchmark::kMillisecond);
+    }
+    benchmark::RegisterBenchmark("ChessGame::makeMove/ruy_lopez", benchGameMakeMove,
+                                 std::span<const chess::Move>{*game});
+    for (const engine::nnue::Kernels* kernels : engine::nnue::supportedKernels()) {
+        const std::string name{kernels->name};
+        benchmark::RegisterBenchmark(("nnue::update/" + name).c_str(), benchNnueUpdate, kernels);
+        benchmark::RegisterBenchmark(("nnue::output/" + name).c_str(), benchNnueOutput, kernels);
+    }
+
+    benchmark::AddCustomContext("compiler", compilerName());
+    benchmark::AddCustomContext("chess_use_pext", chess::usesPext() ? "on" : "off");
+    benchmark::AddCustomContext("chess_instrument", chess::instrument::kEnabled ? "on" : "off");
+    benchmark::AddCustomContext("nnue_kernels", engine::nnue::bestKernels().name);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
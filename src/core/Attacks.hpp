@@ -0,0 +1,146 @@
+#pragma once
+#include <array>
+#include "Bitboard.hpp"
+
+/// @file Attacks.hpp
+/// @brief Precomputed attack sets for all piece types.
+///
+/// Leaper attacks (pawn, knight, king) are constexpr tables. Slider attacks use
+/// magic-bitboard lookups, or PEXT when the build targets BMI2 (see
+/// CHESS_USE_PEXT in CMakeLists.txt). Both index the same table layout.
+
+namespace chess {
+
+namespace detail {
+
+/// Build a leaper attack table from (rank, file) offsets.
+template <std::size_t N>
+[[nodiscard]] constexpr std::array<Bitboard, kSquareCount> makeLeaperTable(
+    const std::array<std::array<int, 2>, N>& offsets) noexcept {
+    std::array<Bitboard, kSquareCount> table{};
+    for (int index = 0; index < kSquareCount; ++index) {
+        const Square from = toSquare(index);
+        for (const auto& [dr, df] : offsets) {
+            if (isValidSquare(from.rank + dr, from.file + df)) {
+                table[index] |= squareBit(Square{from.rank + dr, from.file + df});
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr auto kKnightAttacks = makeLeaperTable<8>({{
+    {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}
+}});
+
+inline constexpr auto kKingAttacks = makeLeaperTable<8>({{
+    {-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}
+}});
+
+/// Indexed by Color: White pawns capture toward rank index 0, Black toward 7.
+inline constexpr std::array<std::array<Bitboard, kSquareCount>, kColorCount> kPawnAttacks = {
+    makeLeaperTable<2>({{{-1, -1}, {-1, 1}}}),
+    makeLeaperTable<2>({{{1, -1}, {1, 1}}})
+};
+
+/// Squares strictly between two aligned squares (empty if not aligned).
+/// Indexed [a][b].
+inline constexpr auto kBetween = [] {
+    std::array<std::array<Bitboard, kSquareCount>, kSquareCount> table{};
+    constexpr std::array<std::array<int, 2>, 8> kDirections = {{
+        {-1, 0}, {1, 0}, {0, -1}, {0, 1}, {-1, -1}, {-1, 1}, {1, -1}, {1, 1}
+    }};
+    for (int index = 0; index < kSquareCount; ++index) {
+        const Square from = toSquare(index);
+        for (const auto& [dr, df] : kDirections) {
+            Bitboard ray = kEmptyBitboard;
+            for (int r = from.rank + dr, f = from.file + df; isValidSquare(r, f); r += dr, f += df) {
+                table[index][toIndex(Square{r, f})] = ray;
+                ray |= squareBit(Square{r, f});
+            }
+        }
+    }
+    return table;
+}();
+
+/// Full board-edge-to-edge line through two aligned squares (empty if not
+/// aligned). Indexed [a][b].
+inline constexpr auto kLine = [] {
+    std::array<std::array<Bitboard, kSquareCount>, kSquareCount> table{};
+    constexpr std::array<std::array<int, 2>, 4> kDirections = {{{1, 0}, {0, 1}, {1, 1}, {1, -1}}};
+    for (int index = 0; index < kSquareCount; ++index) {
+        const Square from = toSquare(index);
+        for (const auto& [dr, df] : kDirections) {
+            Bitboard line = squareBit(index);
+            for (int sign : {-1, 1}) {
+                for (int r = from.rank + sign * dr, f = from.file + sign * df; isValidSquare(r, f);
+                     r += sign * dr, f += sign * df) {
+                    line |= squareBit(Square{r, f});
+                }
+            }
+            for (Bitboard others = line & ~squareBit(index); others;) {
+                table[index][popLsb(others)] = line;
+            }
+        }
+    }
+    return table;
+}();
+
+} // namespace detail
+
+// ============================================================================
+// Leaper Attacks
+// ============================================================================
+
+/// Squares attacked by a pawn of the given color standing on `index`.
+[[nodiscard]] constexpr Bitboard pawnAttacks(Color color, int index) noexcept {
+    return detail::kPawnAttacks[static_cast<std::size_t>(color)][index];
+}
+
+[[nodiscard]] constexpr Bitboard knightAttacks(int index) noexcept {
+    return detail::kKnightAttacks[index];
+}
+
+[[nodiscard]] constexpr Bitboard kingAttacks(int index) noexcept {
+    return detail::kKingAttacks[index];
+}
+
+// ============================================================================
+// Geometry
+// ============================================================================
+
+/// Squares strictly between `a` and `b` when they share a rank, file or
+/// diagonal; empty otherwise.
+[[nodiscard]] constexpr Bitboard betweenBits(int a, int b) noexcept {
+    return detail::kBetween[a][b];
+}
+
+/// The whole line through `a` and `b` (including both) when aligned; empty otherwise.
+[[nodiscard]] constexpr Bitboard lineBits(int a, int b) noexcept {
+    return detail::kLine[a][b];
+}
+
+// ============================================================================
+// Slider Attacks
+// ============================================================================
+
+/// Rook attacks from `index` given board occupancy (blockers included).
+[[nodiscard]] Bitboard rookAttacks(int index, Bitboard occupied) noexcept;
+
+/// Bishop attacks from `index` given board occupancy (blockers included).
+[[nodiscard]] Bitboard bishopAttacks(int index, Bitboard occupied) noexcept;
+
+[[nodiscard]] inline Bitboard queenAttacks(int index, Bitboard occupied) noexcept {
+    return rookAttacks(index, occupied) | bishopAttacks(index, occupied);
+}
+
+/// True when slider lookups use BMI2 PEXT instead of magic multiplication.
+[[nodiscard]] constexpr bool usesPext() noexcept {
+#if defined(CHESS_USE_PEXT)
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace chess
@@ -0,0 +1,96 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include "Types.hpp"
+
+/// @file Bitboard.hpp
+/// @brief 64-bit square sets and square index helpers.
+
+namespace chess {
+
+// ============================================================================
+// Types and Constants
+// ============================================================================
+
+/// Set of squares, one bit per square.
+/// @note Bit index = rank * 8 + file, matching Square's orientation
+///       (index 0 = a8, index 63 = h1), so converting a Square is a multiply-add.
+using Bitboard = std::uint64_t;
+
+/// Number of squares on the board.
+inline constexpr int kSquareCount = kBoardSize * kBoardSize;
+
+/// Number of distinct piece types (Pawn..King).
+inline constexpr int kPieceTypeCount = 6;
+
+/// Number of colors.
+inline constexpr int kColorCount = 2;
+
+inline constexpr Bitboard kEmptyBitboard = 0;
+inline constexpr Bitboard kFileA = 0x0101010101010101ULL;
+inline constexpr Bitboard kFileH = kFileA << 7;
+
+/// Rank mask by Square::rank index (0 = rank 8, 7 = rank 1).
+[[nodiscard]] constexpr Bitboard rankMask(int rank) noexcept {
+    return Bitboard{0xFF} << (rank * kBoardSize);
+}
+
+/// File mask by Square::file index (0 = a-file, 7 = h-file).
+[[nodiscard]] constexpr Bitboard fileMask(int file) noexcept {
+    return kFileA << file;
+}
+
+// ============================================================================
+// Square Index Conversion
+// ============================================================================
+
+/// Convert a square to its 0..63 bit index.
+/// @pre sq.isValid()
+[[nodiscard]] constexpr int toIndex(Square sq) noexcept {
+    return sq.rank * kBoardSize + sq.file;
+}
+
+/// Convert a 0..63 bit index back to a square.
+/// @pre 0 <= index < kSquareCount
+[[nodiscard]] constexpr Square toSquare(int index) noexcept {
+    return Square{.rank = index / kBoardSize, .file = index % kBoardSize};
+}
+
+/// Single-bit set for a square index.
+[[nodiscard]] constexpr Bitboard squareBit(int index) noexcept {
+    return Bitboard{1} << index;
+}
+
+/// Single-bit set for a square.
+/// @pre sq.isValid()
+[[nodiscard]] constexpr Bitboard squareBit(Square sq) noexcept {
+    return squareBit(toIndex(sq));
+}
+
+// ============================================================================
+// Bit Manipulation
+// ============================================================================
+
+[[nodiscard]] constexpr int popCount(Bitboard bb) noexcept {
+    return std::popcount(bb);
+}
+
+/// Index of the least significant set bit.
+/// @pre bb != 0
+[[nodiscard]] constexpr int lsbIndex(Bitboard bb) noexcept {
+    return std::countr_zero(bb);
+}
+
+/// Remove and return the least significant set bit index.
+/// @pre bb != 0
+[[nodiscard]] constexpr int popLsb(Bitboard& bb) noexcept {
+    const int index = lsbIndex(bb);
+    bb &= bb - 1;
+    return index;
+}
+
+[[nodiscard]] constexpr bool contains(Bitboard bb, int index) noexcept {
+    return (bb & squareBit(index)) != 0;
+}
+
+} // namespace chess
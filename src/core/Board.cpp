@@ -1,5 +1,8 @@
 ﻿#include "Board.hpp"
+#include "Attacks.hpp"
 #include <algorithm>
+#include <cassert>
+#include <utility>
 
 namespace chess {
 
@@ -11,6 +14,25 @@ constexpr std::array<PieceType, Board::kSize> kBackRankOrder = {
     PieceType::King, PieceType::Bishop, PieceType::Knight, PieceType::Rook
 };
 
+/// Castling rook files: kingside h -> f, queenside a -> d.
+constexpr int kKingsideRookFrom = 7;
+constexpr int kKingsideRookTo = 5;
+constexpr int kQueensideRookFrom = 0;
+constexpr int kQueensideRookTo = 3;
+
+/// Rook (from, to) squares for a castling king move.
+[[nodiscard]] constexpr std::pair<int, int> castlingRookSquares(const Move& move) noexcept {
+    const int rank = move.from.rank;
+    return (move.to.file > move.from.file)
+        ? std::pair{toIndex({rank, kKingsideRookFrom}), toIndex({rank, kKingsideRookTo})}
+        : std::pair{toIndex({rank, kQueensideRookFrom}), toIndex({rank, kQueensideRookTo})};
+}
+
+/// Square holding the pawn captured by an en-passant move.
+[[nodiscard]] constexpr int enPassantVictim(const Move& move) noexcept {
+    return toIndex({move.from.rank, move.to.file});
+}
+
 } // namespace
 
 Board::Board() { 
@@ -18,31 +40,39 @@ Board::Board() {
 }
 
 const std::optional<Piece>& Board::at(Square sq) const noexcept { 
-    return grid_[sq.rank][sq.file]; 
-}
-
-std::optional<Piece>& Board::at(Square sq) noexcept { 
-    return grid_[sq.rank][sq.file]; 
+    return mailbox_[toIndex(sq)]; 
 }
 
 bool Board::hasPieceAt(Square sq) const noexcept {
-    return sq.isValid() && grid_[sq.rank][sq.file].has_value();
+    return sq.isValid() && contains(occupied(), toIndex(sq));
 }
 
 bool Board::hasPieceAt(Square sq, Color color) const noexcept {
-    if (!sq.isValid()) return false;
-    const auto& piece = grid_[sq.rank][sq.file];
-    return piece.has_value() && piece->color == color;
+    return sq.isValid() && contains(pieces(color), toIndex(sq));
 }
 
 void Board::movePiece(const Move& move) {
-    grid_[move.to.rank][move.to.file] = grid_[move.from.rank][move.from.file];
-    grid_[move.from.rank][move.from.file] = std::nullopt;
+    const int from = toIndex(move.from);
+    const int to = toIndex(move.to);
+    const auto piece = mailbox_[from];
+    if (!piece) return;
+
+    removePiece(from);
+    if (mailbox_[to]) {
+        removePiece(to);
+    }
+    putPiece(to, *piece);
 }
 
 void Board::setPiece(Square sq, std::optional<Piece> piece) {
-    if (sq.isValid()) {
-        grid_[sq.rank][sq.file] = piece;
+    if (!sq.isValid()) return;
+
+    const int index = toIndex(sq);
+    if (mailbox_[index]) {
+        removePiece(index);
+    }
+    if (piece) {
+        putPiece(index, *piece);
     }
 }
 
@@ -50,33 +80,243 @@ void Board::clearSquare(Square sq) {
     setPiece(sq, std::nullopt);
 }
 
+// ============================================================================
+// Make / Unmake
+// ============================================================================
+
+UndoInfo Board::makeMove(const Move& move) noexcept {
+    instrument::count(instrument::Counter::BoardMoves);
+    const int from = toIndex(move.from);
+    const int to = toIndex(move.to);
+    assert(mailbox_[from].has_value());
+    const Piece mover = *mailbox_[from];
+
+    UndoInfo undo{
+        .captured = std::nullopt,
+        .castling_rights = castling_rights_,
+        .en_passant = en_passant_,
+        .key = key_
+    };
+
+    if (move.en_passant) {
+        const int victim = enPassantVictim(move);
+        undo.captured = mailbox_[victim];
+        removePiece(victim);
+    } else if (mailbox_[to]) {
+        undo.captured = mailbox_[to];
+        removePiece(to);
+    }
+
+    if (move.promotion) {
+        removePiece(from);
+        putPiece(to, Piece{.type = *move.promotion, .color = mover.color});
+    } else {
+        relocatePiece(from, to);
+    }
+
+    if (move.castling) {
+        const auto [rook_from, rook_to] = castlingRookSquares(move);
+        relocatePiece(rook_from, rook_to);
+    }
+
+    key_ ^= zobrist::castlingKey(castling_rights_);
+    updateCastlingRights(move, mover);
+    key_ ^= zobrist::castlingKey(castling_rights_);
+
+    // Only record an en-passant square that an enemy pawn can actually use,
+    // so identical positions compare and hash equal.
+    std::optional<Square> en_passant;
+    if (mover.type == PieceType::Pawn && (from - to == 16 || to - from == 16)) {
+        const int passed = (from + to) / 2;
+        const Color enemy = opponent(mover.color);
+        if (pawnAttacks(mover.color, passed) & pieces(PieceType::Pawn, enemy)) {
+            en_passant = toSquare(passed);
+        }
+    }
+    setEnPassantSquare(en_passant);
+
+    return undo;
+}
+
+PlacementDelta Board::placementDelta(const Move& move) const noexcept {
+    const int from = toIndex(move.from);
+    const int to = toIndex(move.to);
+    assert(mailbox_[from].has_value());
+    const Piece mover = *mailbox_[from];
+
+    PlacementDelta delta;
+    delta.removed[delta.removed_count++] = {.piece = mover, .square = from};
+    const Piece arriving{.type = move.promotion.value_or(mover.type), .color = mover.color};
+    delta.added[delta.added_count++] = {.piece = arriving, .square = to};
+
+    if (move.en_passant) {
+        const int victim = enPassantVictim(move);
+        delta.removed[delta.removed_count++] = {.piece = *mailbox_[victim], .square = victim};
+    } else if (mailbox_[to]) {
+        delta.removed[delta.removed_count++] = {.piece = *mailbox_[to], .square = to};
+    } else if (move.castling) {
+        const auto [rook_from, rook_to] = castlingRookSquares(move);
+        const Piece rook{.type = PieceType::Rook, .color = mover.color};
+        delta.removed[delta.removed_count++] = {.piece = rook, .square = rook_from};
+        delta.added[delta.added_count++] = {.piece = rook, .square = rook_to};
+    }
+    return delta;
+}
+
+void Board::unmakeMove(const Move& move, const UndoInfo& undo) noexcept {
+    const int from = toIndex(move.from);
+    const int to = toIndex(move.to);
+    assert(mailbox_[to].has_value());
+
+    if (move.castling) {
+        const auto [rook_from, rook_to] = castlingRookSquares(move);
+        relocatePiece(rook_to, rook_from);
+    }
+
+    if (move.promotion) {
+        const Color color = mailbox_[to]->color;
+        removePiece(to);
+        putPiece(from, Piece{.type = PieceType::Pawn, .color = color});
+    } else {
+        relocatePiece(to, from);
+    }
+
+    if (undo.captured) {
+        putPiece(move.en_passant ? enPassantVictim(move) : to, *undo.captured);
+    }
+
+    castling_rights_ = undo.castling_rights;
+    en_passant_ = undo.en_passant;
+    key_ = undo.key;
+}
+
+void Board::setCastlingRights(const CastlingRights& rights) noexcept {
+    key_ ^= zobrist::castlingKey(castling_rights_) ^ zobrist::castlingKey(rights);
+    castling_rights_ = rights;
+}
+
+void Board::setEnPassantSquare(std::optional<Square> sq) noexcept {
+    if (en_passant_) key_ ^= zobrist::enPassantKey(en_passant_->file);
+    en_passant_ = sq;
+    if (en_passant_) key_ ^= zobrist::enPassantKey(en_passant_->file);
+}
+
+void Board::updateCastlingRights(const Move& move, Piece mover) noexcept {
+    // King moved: revoke both castling rights for that color
+    if (mover.type == PieceType::King) {
+        const std::size_t base = (mover.color == Color::White) ? 0 : 2;
+        castling_rights_[base] = false;
+        castling_rights_[base + 1] = false;
+    }
+
+    // Rook moved from or was captured on its initial square
+    auto revokeIfRookSquare = [this](Square sq) {
+        if (sq.rank == 7) {
+            if (sq.file == 0) castling_rights_[1] = false;      // White queenside
+            else if (sq.file == 7) castling_rights_[0] = false; // White kingside
+        } else if (sq.rank == 0) {
+            if (sq.file == 0) castling_rights_[3] = false;      // Black queenside
+            else if (sq.file == 7) castling_rights_[2] = false; // Black kingside
+        }
+    };
+
+    revokeIfRookSquare(move.from);
+    revokeIfRookSquare(move.to);
+}
+
 void Board::reset() {
     clear();
     setupInitialPosition();
+    setCastlingRights({true, true, true, true});
 }
 
 void Board::clear() {
-    for (auto& row : grid_) {
-        std::ranges::fill(row, std::nullopt);
-    }
+    std::ranges::fill(mailbox_, std::nullopt);
+    color_bb_.fill(kEmptyBitboard);
+    type_bb_.fill(kEmptyBitboard);
+    castling_rights_ = {false, false, false, false};
+    en_passant_.reset();
+    key_ = 0;
+    psq_ = {};
+    phase_ = 0;
 }
 
 std::span<const std::optional<Piece>, Board::kSize> Board::rank(int r) const noexcept {
-    return std::span<const std::optional<Piece>, kSize>(grid_[r]);
+    return std::span<const std::optional<Piece>, kSize>(mailbox_.data() + r * kSize, kSize);
+}
+
+// ============================================================================
+// Internal Placement
+// ============================================================================
+
+void Board::putPiece(int index, Piece piece) noexcept {
+    const Bitboard bit = squareBit(index);
+    color_bb_[static_cast<std::size_t>(piece.color)] |= bit;
+    type_bb_[static_cast<std::size_t>(piece.type)] |= bit;
+    mailbox_[index] = piece;
+    key_ ^= zobrist::pieceKey(piece, index);
+    psq_ += psqt::pieceScore(piece, index);
+    phase_ += psqt::phaseWeight(piece.type);
+}
+
+/// @pre mailbox_[index] holds a piece
+void Board::removePiece(int index) noexcept {
+    const Piece piece = *mailbox_[index];
+    const Bitboard bit = squareBit(index);
+    color_bb_[static_cast<std::size_t>(piece.color)] &= ~bit;
+    type_bb_[static_cast<std::size_t>(piece.type)] &= ~bit;
+    mailbox_[index].reset();
+    key_ ^= zobrist::pieceKey(piece, index);
+    psq_ -= psqt::pieceScore(piece, index);
+    phase_ -= psqt::phaseWeight(piece.type);
+}
+
+/// @pre mailbox_[from] holds a piece and mailbox_[to] is empty
+void Board::relocatePiece(int from, int to) noexcept {
+    const Piece piece = *mailbox_[from];
+    const Bitboard bits = squareBit(from) | squareBit(to);
+    color_bb_[static_cast<std::size_t>(piece.color)] ^= bits;
+    type_bb_[static_cast<std::size_t>(piece.type)] ^= bits;
+    mailbox_[to] = piece;
+    mailbox_[from].reset();
+    key_ ^= zobrist::pieceKey(piece, from) ^ zobrist::pieceKey(piece, to);
+    psq_ += psqt::pieceScore(piece, to);
+    psq_ -= psqt::pieceScore(piece, from);
 }
 
 void Board::setupInitialPosition() {
     // Black pieces (ranks 0-1)
     for (int file = 0; file < kSize; ++file) {
-        grid_[0][file] = Piece{.type = kBackRankOrder[file], .color = Color::Black};
-        grid_[1][file] = Piece{.type = PieceType::Pawn, .color = Color::Black};
+        putPiece(toIndex({0, file}), Piece{.type = kBackRankOrder[file], .color = Color::Black});
+        putPiece(toIndex({1, file}), Piece{.type = PieceType::Pawn, .color = Color::Black});
     }
 
     // White pieces (ranks 6-7)
     for (int file = 0; file < kSize; ++file) {
-        grid_[6][file] = Piece{.type = PieceType::Pawn, .color = Color::White};
-        grid_[7][file] = Piece{.type = kBackRankOrder[file], .color = Color::White};
+        putPiece(toIndex({6, file}), Piece{.type = PieceType::Pawn, .color = Color::White});
+        putPiece(toIndex({7, file}), Piece{.type = kBackRankOrder[file], .color = Color::White});
+    }
+}
+
+zobrist::Key computeKey(const Board& board) noexcept {
+    zobrist::Key key = zobrist::castlingKey(board.castlingRights());
+    if (const auto ep = board.enPassantSquare()) {
+        key ^= zobrist::enPassantKey(ep->file);
+    }
+    for (Bitboard occupied = board.occupied(); occupied;) {
+        const int index = popLsb(occupied);
+        key ^= zobrist::pieceKey(*board.at(index), index);
+    }
+    return key;
+}
+
+psqt::Score computePsqScore(const Board& board) noexcept {
+    psqt::Score score{};
+    for (Bitboard occupied = board.occupied(); occupied;) {
+        const int index = popLsb(occupied);
+        score += psqt::pieceScore(*board.at(index), index);
     }
+    return score;
 }
 
 } // namespace chess
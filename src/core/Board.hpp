@@ -2,31 +2,62 @@
 #include <array>
 #include <optional>
 #include <span>
+#include "Bitboard.hpp"
+#include "Instrumentation.hpp"
 #include "Types.hpp"
 #include "Move.hpp"
+#include "PieceSquareTables.hpp"
+#include "Zobrist.hpp"
 
 namespace chess {
 
+/// Everything Board::makeMove() destroys, so unmakeMove() can restore it
+/// (the key is restored directly rather than re-derived).
+struct UndoInfo {
+    std::optional<Piece> captured{};
+    CastlingRights castling_rights{};
+    std::optional<Square> en_passant{};
+    zobrist::Key key{};
+};
+
+/// A piece standing on a 0..63 square index.
+struct PlacedPiece {
+    Piece piece{};
+    int square{0};
+};
+
+/// Pieces a move takes off and puts on the board: at most two of each
+/// (captures take two off; castling moves two pieces).
+struct PlacementDelta {
+    std::array<PlacedPiece, 2> removed{};
+    std::array<PlacedPiece, 2> added{};
+    int removed_count{0};
+    int added_count{0};
+};
+
 /// 8x8 chess board representation.
 /// 
-/// Manages piece placement and basic board operations.
+/// Manages piece placement, castling rights and the en-passant square.
 /// Does not enforce rules - that's the responsibility of Rules/ChessGame.
+///
+/// Pieces are stored twice: as per-color and per-type bitboards (the primary
+/// representation used by move generation) and as a square-indexed mailbox
+/// so that at()/rank() stay O(1) views for the UI.
+/// @invariant mailbox_ and the bitboards always describe the same placement.
 class Board {
 public:
     static constexpr int kSize = kBoardSize;
-    using Row = std::array<std::optional<Piece>, kSize>;
-    using Grid = std::array<Row, kSize>;
+    using Mailbox = std::array<std::optional<Piece>, kSquareCount>;
 
     /// Constructs a board with the standard starting position.
     Board();
     
-    /// Access piece at square (const).
+    /// Access piece at square.
     /// @pre sq.isValid()
     [[nodiscard]] const std::optional<Piece>& at(Square sq) const noexcept;
-    
-    /// Access piece at square (mutable).
-    /// @pre sq.isValid()
-    [[nodiscard]] std::optional<Piece>& at(Square sq) noexcept;
+
+    /// Access piece at a 0..63 square index.
+    [[nodiscard]] const std::optional<Piece>& at(int index) const noexcept { return mailbox_[index]; }
     
     /// Check if a square contains a piece.
     [[nodiscard]] bool hasPieceAt(Square sq) const noexcept;
@@ -38,6 +69,21 @@ public:
     /// @pre move.from and move.to are valid squares
     /// @note Does not validate legality - caller must ensure move is legal.
     void movePiece(const Move& move);
+
+    /// Play a move in place, including castling, en-passant and promotion,
+    /// and update castling rights and the en-passant square.
+    /// @pre move is legal in this position, with its special-move flags set
+    /// @return Record to pass to unmakeMove(); may be dropped if not undoing
+    UndoInfo makeMove(const Move& move) noexcept;
+
+    /// The placement changes makeMove(move) would make, for evaluations kept
+    /// up to date incrementally alongside make/unmake.
+    /// @pre As for makeMove()
+    [[nodiscard]] PlacementDelta placementDelta(const Move& move) const noexcept;
+
+    /// Revert a move made by makeMove().
+    /// @pre move and undo are the most recent makeMove() argument and result
+    void unmakeMove(const Move& move, const UndoInfo& undo) noexcept;
     
     /// Place a piece at a square (or clear the square if nullopt).
     void setPiece(Square sq, std::optional<Piece> piece);
@@ -48,16 +94,105 @@ public:
     /// Reset board to standard starting position.
     void reset();
     
-    /// Clear all pieces from the board.
+    /// Clear all pieces from the board and revoke all castling rights.
     void clear();
     
     /// Get read-only view of a rank (row).
     [[nodiscard]] std::span<const std::optional<Piece>, kSize> rank(int r) const noexcept;
 
+    // ========================================================================
+    // Bitboard Queries
+    // ========================================================================
+
+    /// All occupied squares.
+    [[nodiscard]] Bitboard occupied() const noexcept { return color_bb_[0] | color_bb_[1]; }
+
+    /// Squares occupied by the given color.
+    [[nodiscard]] Bitboard pieces(Color color) const noexcept {
+        return color_bb_[static_cast<std::size_t>(color)];
+    }
+
+    /// Squares occupied by the given piece type (both colors).
+    [[nodiscard]] Bitboard pieces(PieceType type) const noexcept {
+        return type_bb_[static_cast<std::size_t>(type)];
+    }
+
+    /// Squares occupied by pieces of the given type and color.
+    [[nodiscard]] Bitboard pieces(PieceType type, Color color) const noexcept {
+        return pieces(type) & pieces(color);
+    }
+
+    /// Square index of the given side's king.
+    /// @pre The side has exactly one king on the board
+    [[nodiscard]] int kingSquare(Color color) const noexcept {
+        return lsbIndex(pieces(PieceType::King, color));
+    }
+
+    // ========================================================================
+    // Position State
+    // ========================================================================
+
+    [[nodiscard]] const CastlingRights& castlingRights() const noexcept { return castling_rights_; }
+
+    /// Square a pawn passed over on the last double push, if an enemy pawn
+    /// stands ready to capture it en passant.
+    [[nodiscard]] std::optional<Square> enPassantSquare() const noexcept { return en_passant_; }
+
+    /// Set castling rights (e.g. when loading a position).
+    /// @note Not validated against piece placement - Rules checks the rook is present.
+    void setCastlingRights(const CastlingRights& rights) noexcept;
+
+    /// Set the en-passant square (e.g. when loading a position).
+    /// @pre Either nullopt or a square an enemy pawn can capture on, see enPassantSquare()
+    void setEnPassantSquare(std::optional<Square> sq) noexcept;
+
+    /// Zobrist key of piece placement, castling rights and en-passant file,
+    /// maintained incrementally. Excludes the side to move; see positionKey().
+    [[nodiscard]] zobrist::Key key() const noexcept { return key_; }
+
+    // ========================================================================
+    // Evaluation Terms
+    // ========================================================================
+
+    /// Sum of material and piece-square scores from White's point of view,
+    /// maintained incrementally like key().
+    [[nodiscard]] psqt::Score psqScore() const noexcept { return psq_; }
+
+    /// Game phase from the non-pawn material on the board
+    /// (psqt::kMaxPhase at the start, 0 with only kings and pawns).
+    [[nodiscard]] int phase() const noexcept { return phase_; }
+
 private:
-    Grid grid_{};
-    
+    void putPiece(int index, Piece piece) noexcept;
+    void removePiece(int index) noexcept;
+    void relocatePiece(int from, int to) noexcept;
+    void updateCastlingRights(const Move& move, Piece mover) noexcept;
     void setupInitialPosition();
+
+    std::array<Bitboard, kColorCount> color_bb_{};
+    std::array<Bitboard, kPieceTypeCount> type_bb_{};
+    Mailbox mailbox_{};
+    CastlingRights castling_rights_{};
+    std::optional<Square> en_passant_{};
+    zobrist::Key key_{0};
+    psqt::Score psq_{};
+    int phase_{0};
+#if defined(CHESS_INSTRUMENT)
+    // Only in instrumented builds, so Board stays trivially copyable otherwise
+    instrument::CopyCounter<instrument::Counter::BoardCopies> copy_counter_;
+#endif
 };
 
+/// Zobrist key of the full position: the board key combined with the side to move.
+[[nodiscard]] inline zobrist::Key positionKey(const Board& board, Color side) noexcept {
+    return board.key() ^ zobrist::sideKey(side);
+}
+
+/// Recompute a board's key from scratch (for loading and consistency checks).
+[[nodiscard]] zobrist::Key computeKey(const Board& board) noexcept;
+
+/// Recompute a board's material and piece-square score from scratch
+/// (for consistency checks against Board::psqScore()).
+[[nodiscard]] psqt::Score computePsqScore(const Board& board) noexcept;
+
 } // namespace chess
@@ -1,4 +1,5 @@
 ﻿#include "ChessGame.hpp"
+#include "Instrumentation.hpp"
 #include <algorithm>
 #include <ranges>
 
@@ -9,14 +10,40 @@ namespace chess {
 // ============================================================================
 
 ChessGame::ChessGame() { 
+    history_.reserve(kHistoryReserve);
+    keys_.reserve(kHistoryReserve);
     newGame(); 
 }
 
 void ChessGame::newGame() {
     board_.reset();
     side_to_move_ = Color::White;
-    last_move_.reset();
-    castling_rights_ = {true, true, true, true};
+    halfmove_clock_ = 0;
+    fullmove_number_ = 1;
+    clearHistory();
+    invalidateStatus();
+}
+
+bool ChessGame::loadFen(std::string_view fen) {
+    const auto position = parseFen(fen);
+    if (!position) {
+        return false;
+    }
+    loadPosition(*position);
+    return true;
+}
+
+void ChessGame::loadPosition(const FenPosition& position) {
+    board_ = position.board;
+    side_to_move_ = position.side_to_move;
+    halfmove_clock_ = position.halfmove_clock;
+    fullmove_number_ = position.fullmove_number;
+    clearHistory();
+    invalidateStatus();
+}
+
+FenString ChessGame::fen() const noexcept {
+    return toFen(board_, side_to_move_, halfmove_clock_, fullmove_number_);
 }
 
 // ============================================================================
@@ -24,83 +51,73 @@ void ChessGame::newGame() {
 // ============================================================================
 
 bool ChessGame::makeMove(const Move& move) {
-    auto moves = rules_.legalMoves(board_, side_to_move_, last_move_, castling_rights_);
-    
-    // Find matching legal move
+    const instrument::ScopedTimer timer{instrument::Timer::GameMakeMove};
+    const MoveList& moves = status().moves;
+    instrument::count(instrument::Counter::MoveLegalityChecks);
+
+    // Find matching legal move (an unspecified promotion piece means the first
+    // generated one, a queen)
     auto it = std::ranges::find_if(moves, [&](const Move& m) {
-        return m.from == move.from && m.to == move.to;
+        return m.from == move.from && m.to == move.to &&
+               (!move.promotion || m.promotion == move.promotion);
     });
     
     if (it == moves.end()) {
         return false;
     }
 
-    const Move legal_move = *it;
-    
-    handleSpecialMoves(legal_move);
-    updateCastlingRights(legal_move);
-    
-    last_move_ = legal_move;
-    side_to_move_ = opponent(side_to_move_);
-    
+    // Moves past the current ply can no longer be redone
+    history_.resize(ply_);
+    keys_.resize(ply_);
+    history_.push_back({.move = *it, .halfmove_clock = halfmove_clock_});
+    keys_.push_back(positionKey());
+    playHistoryEntry(history_.back());
+
     return true;
 }
 
-void ChessGame::handleSpecialMoves(const Move& move) {
-    // En-passant: remove captured pawn
-    if (move.en_passant) {
-        board_.clearSquare({move.from.rank, move.to.file});
+bool ChessGame::undoMove() {
+    if (ply_ == 0) {
+        return false;
     }
 
-    // Execute the main piece movement
-    board_.movePiece(move);
-
-    // Castling: also move the rook
-    if (move.castling) {
-        const int rank = move.from.rank;
-        if (move.to.file == 6) {
-            // Kingside: rook h -> f
-            board_.movePiece({
-                .from = {rank, 7}, 
-                .to = {rank, 5}
-            });
-        } else if (move.to.file == 2) {
-            // Queenside: rook a -> d
-            board_.movePiece({
-                .from = {rank, 0}, 
-                .to = {rank, 3}
-            });
-        }
+    const HistoryEntry& entry = history_[--ply_];
+    board_.unmakeMove(entry.move, entry.undo);
+    side_to_move_ = opponent(side_to_move_);
+    halfmove_clock_ = entry.halfmove_clock;
+    if (side_to_move_ == Color::Black) {
+        --fullmove_number_;
     }
+    invalidateStatus();
+    return true;
 }
 
-void ChessGame::updateCastlingRights(const Move& move) {
-    const auto& piece = board_.at(move.to);
-    
-    // King moved: revoke both castling rights for that color
-    if (piece && piece->type == PieceType::King) {
-        if (side_to_move_ == Color::White) {
-            castling_rights_[0] = false;
-            castling_rights_[1] = false;
-        } else {
-            castling_rights_[2] = false;
-            castling_rights_[3] = false;
-        }
+bool ChessGame::redoMove() {
+    if (ply_ == history_.size()) {
+        return false;
+    }
+    playHistoryEntry(history_[ply_]);
+    return true;
+}
+
+void ChessGame::playHistoryEntry(HistoryEntry& entry) {
+    const bool pawn_move = board_.at(entry.move.from)->type == PieceType::Pawn;
+    const bool capture = entry.move.en_passant || board_.hasPieceAt(entry.move.to);
+    halfmove_clock_ = (pawn_move || capture) ? 0 : halfmove_clock_ + 1;
+    if (side_to_move_ == Color::Black) {
+        ++fullmove_number_;
     }
 
-    // Rook moved from initial square: revoke corresponding right
-    auto revokeIfRookSquare = [this](Square sq) {
-        if (sq.rank == 7) {
-            if (sq.file == 0) castling_rights_[1] = false;      // White queenside
-            else if (sq.file == 7) castling_rights_[0] = false; // White kingside
-        } else if (sq.rank == 0) {
-            if (sq.file == 0) castling_rights_[3] = false;      // Black queenside
-            else if (sq.file == 7) castling_rights_[2] = false; // Black kingside
-        }
-    };
+    entry.undo = board_.makeMove(entry.move);
+    side_to_move_ = opponent(side_to_move_);
+    ++ply_;
+    invalidateStatus();
+}
 
-    revokeIfRookSquare(move.from);
-    revokeIfRookSquare(move.to);  // Also handles rook capture
+void ChessGame::clearHistory() noexcept {
+    history_.clear();
+    keys_.clear();
+    ply_ = 0;
 }
 
 // ============================================================================
@@ -116,27 +133,86 @@ const Board& ChessGame::board() const noexcept {
 }
 
 std::vector<Move> ChessGame::legalMoves() const { 
-    return rules_.legalMoves(board_, side_to_move_, last_move_, castling_rights_); 
+    const MoveList& moves = status().moves;
+    return {moves.begin(), moves.end()};
+}
+
+zobrist::Key ChessGame::positionKey() const noexcept {
+    return chess::positionKey(board_, side_to_move_);
+}
+
+std::span<const zobrist::Key> ChessGame::repetitionKeys() const noexcept {
+    // Nothing before the last capture or pawn move can recur; positions
+    // before a loaded FEN are unknown
+    const auto reversible = std::min(static_cast<std::size_t>(halfmove_clock_), ply_);
+    return std::span(keys_).subspan(ply_ - reversible, reversible);
 }
 
 // ============================================================================
 // Game Status
 // ============================================================================
 
+const ChessGame::PositionStatus& ChessGame::status() const {
+    if (!status_valid_) {
+        const instrument::ScopedTimer timer{instrument::Timer::GamePositionStatus};
+        instrument::count(instrument::Counter::StatusCacheMisses);
+        rules_.legalMoves(board_, side_to_move_, status_.moves);
+        status_.in_check = rules_.isCheck(board_, side_to_move_);
+        status_valid_ = true;
+    }
+    return status_;
+}
+
+const LegalDestinations& ChessGame::legalDestinations() const {
+    if (!destinations_valid_) {
+        destinations_.fill(kEmptyBitboard);
+        for (const Move& move : status().moves) {
+            destinations_[toIndex(move.from)] |= squareBit(move.to);
+        }
+        destinations_valid_ = true;
+    }
+    return destinations_;
+}
+
 bool ChessGame::isCheck() const {
-    return rules_.isCheck(board_, side_to_move_);
+    return status().in_check;
 }
 
 bool ChessGame::isCheckmate() const {
-    return rules_.isCheckmate(board_, side_to_move_, last_move_, castling_rights_);
+    const PositionStatus& s = status();
+    return s.in_check && s.moves.empty();
 }
 
 bool ChessGame::isStalemate() const {
-    return rules_.isStalemate(board_, side_to_move_, last_move_, castling_rights_);
+    const PositionStatus& s = status();
+    return !s.in_check && s.moves.empty();
 }
 
 bool ChessGame::isGameOver() const {
-    return isCheckmate() || isStalemate();
+    return status().moves.empty() || isDraw();
+}
+
+bool ChessGame::isDraw() const {
+    // Checkmate on the move that reaches a draw condition still wins
+    return (isFiftyMoveDraw() || isThreefoldRepetition()) && !isCheckmate();
+}
+
+bool ChessGame::isThreefoldRepetition() const noexcept {
+    const zobrist::Key current = positionKey();
+    const auto keys = repetitionKeys();
+
+    // Same side to move: every second earlier position, newest first
+    int occurrences = 1;
+    for (auto i = static_cast<std::ptrdiff_t>(keys.size()) - 2; i >= 0; i -= 2) {
+        if (keys[static_cast<std::size_t>(i)] == current && ++occurrences == 3) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ChessGame::isFiftyMoveDraw() const noexcept {
+    return halfmove_clock_ >= kFiftyMovePlies;
 }
 
 } // namespace chess
@@ -1,18 +1,29 @@
 ﻿#pragma once
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "Fen.hpp"
 #include "IGame.hpp"
+#include "MoveList.hpp"
 #include "Rules.hpp"
-#include <array>
-#include <optional>
 
 namespace chess {
 
 /// Concrete implementation of chess game logic.
 ///
 /// Manages the complete game state including:
-/// - Board position
+/// - Board position (with castling rights and en-passant square)
 /// - Side to move
-/// - Castling rights
-/// - En-passant eligibility (via last move tracking)
+/// - Halfmove clock and fullmove number
+/// - Move history for undo/redo and repetition detection
+///
+/// Legal moves and check status are generated at most once per position: the
+/// first query after a move fills a cache that every other query (including
+/// makeMove's legality check and legalDestinations()) reads, until the next
+/// makeMove()/newGame().
+/// @note Const queries populate the cache, so concurrent access from several
+///       threads must be externally synchronized.
 class ChessGame final : public IGame {
 public:
     ChessGame();
@@ -20,25 +31,102 @@ public:
     // IGame interface
     void newGame() override;
     [[nodiscard]] bool makeMove(const Move& move) override;
+    [[nodiscard]] bool undoMove() override;
+    [[nodiscard]] bool redoMove() override;
     [[nodiscard]] Color sideToMove() const noexcept override;
     [[nodiscard]] const Board& board() const noexcept override;
     [[nodiscard]] std::vector<Move> legalMoves() const override;
+    [[nodiscard]] const LegalDestinations& legalDestinations() const override;
+    [[nodiscard]] zobrist::Key positionKey() const noexcept override;
+    [[nodiscard]] std::span<const zobrist::Key> repetitionKeys() const noexcept override;
+
+    /// Legal moves without copying, from the same cache makeMove() uses.
+    /// @note Invalidated by the next makeMove(), newGame() or load
+    [[nodiscard]] const MoveList& legalMoveList() const { return status().moves; }
 
     // Extended game status (overrides with implementations)
     [[nodiscard]] bool isCheck() const override;
     [[nodiscard]] bool isGameOver() const override;
     [[nodiscard]] bool isCheckmate() const override;
     [[nodiscard]] bool isStalemate() const override;
+    [[nodiscard]] bool isDraw() const override;
+
+    /// The current position occurred twice before with the same side to move,
+    /// castling rights and en-passant square.
+    [[nodiscard]] bool isThreefoldRepetition() const noexcept;
+
+    /// Fifty moves by each side without a capture or pawn move.
+    [[nodiscard]] bool isFiftyMoveDraw() const noexcept;
+
+    // ========================================================================
+    // Position Setup
+    // ========================================================================
+
+    /// Replace the game with the position described by a FEN string.
+    /// @return false (leaving the game unchanged) if the FEN is malformed
+    [[nodiscard]] bool loadFen(std::string_view fen);
+
+    /// Replace the game with an already parsed position.
+    void loadPosition(const FenPosition& position);
+
+    /// The current position as FEN, without allocating.
+    [[nodiscard]] FenString fen() const noexcept;
+
+    [[nodiscard]] int halfmoveClock() const noexcept override { return halfmove_clock_; }
+
+    /// Move number, starting at 1 and incremented after Black moves.
+    [[nodiscard]] int fullmoveNumber() const noexcept { return fullmove_number_; }
 
 private:
-    void updateCastlingRights(const Move& move);
-    void handleSpecialMoves(const Move& move);
+    /// Initial history capacity, so ordinary games never reallocate.
+    static constexpr std::size_t kHistoryReserve = 512;
+
+    static constexpr int kFiftyMovePlies = 100;
+
+    /// A played move and what it takes to undo it.
+    struct HistoryEntry {
+        Move move;
+        UndoInfo undo{};
+        int halfmove_clock{0};  ///< Before the move
+    };
+
+    /// Play history_[ply_] (a legal move) and advance ply_.
+    void playHistoryEntry(HistoryEntry& entry);
+
+    void clearHistory() noexcept;
+
+    /// Legal moves and check flag for the current position.
+    struct PositionStatus {
+        MoveList moves;
+        bool in_check{false};
+    };
+
+    /// Return the cached status, generating it first if stale.
+    [[nodiscard]] const PositionStatus& status() const;
+
+    /// Mark the cached status stale after the position changed.
+    void invalidateStatus() noexcept {
+        status_valid_ = false;
+        destinations_valid_ = false;
+    }
 
     Board board_;
     Rules rules_;
     Color side_to_move_{Color::White};
-    std::optional<Move> last_move_;
-    Rules::CastlingRights castling_rights_{true, true, true, true};
+    int halfmove_clock_{0};
+    int fullmove_number_{1};
+
+    /// Moves [0, ply_) are played; the rest were undone and can be redone.
+    std::vector<HistoryEntry> history_;
+    /// keys_[i] is the position key before history_[i].
+    std::vector<zobrist::Key> keys_;
+    std::size_t ply_{0};
+
+    mutable PositionStatus status_;
+    mutable bool status_valid_{false};
+    /// Derived from status_.moves on first use; bulk replay never asks for it.
+    mutable LegalDestinations destinations_{};
+    mutable bool destinations_valid_{false};
 };
 
 } // namespace chess
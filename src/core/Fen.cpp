@@ -0,0 +1,208 @@
+#include "Fen.hpp"
+#include "Attacks.hpp"
+#include "Rules.hpp"
+#include <algorithm>
+#include <charconv>
+#include <utility>
+
+namespace chess {
+
+namespace {
+
+/// Splits a string on runs of spaces without allocating.
+class FieldReader {
+public:
+    explicit FieldReader(std::string_view text) noexcept : rest_(text) {}
+
+    [[nodiscard]] std::optional<std::string_view> next() noexcept {
+        const auto start = rest_.find_first_not_of(' ');
+        if (start == std::string_view::npos) return std::nullopt;
+        rest_.remove_prefix(start);
+        const auto end = std::min(rest_.find(' '), rest_.size());
+        const auto field = rest_.substr(0, end);
+        rest_.remove_prefix(end);
+        return field;
+    }
+
+private:
+    std::string_view rest_;
+};
+
+/// Castling field letters in CastlingRights order.
+constexpr std::array<char, 4> kCastlingChars = {'K', 'Q', 'k', 'q'};
+
+[[nodiscard]] std::optional<PieceType> pieceTypeFromChar(char c) noexcept {
+    switch (c) {
+        case 'p': return PieceType::Pawn;
+        case 'n': return PieceType::Knight;
+        case 'b': return PieceType::Bishop;
+        case 'r': return PieceType::Rook;
+        case 'q': return PieceType::Queen;
+        case 'k': return PieceType::King;
+        default:  return std::nullopt;
+    }
+}
+
+[[nodiscard]] bool parsePlacement(std::string_view field, Board& board) noexcept {
+    board.clear();
+    int rank = 0;
+    int file = 0;
+    for (char c : field) {
+        if (c == '/') {
+            if (file != kBoardSize || ++rank >= kBoardSize) return false;
+            file = 0;
+        } else if (c >= '1' && c <= '8') {
+            file += c - '0';
+            if (file > kBoardSize) return false;
+        } else {
+            const bool white = (c >= 'A' && c <= 'Z');
+            const auto type = pieceTypeFromChar(white ? static_cast<char>(c - 'A' + 'a') : c);
+            if (!type || file >= kBoardSize) return false;
+            board.setPiece(Square{rank, file++},
+                           Piece{.type = *type, .color = white ? Color::White : Color::Black});
+        }
+    }
+    // Pawns on the back ranks would push off the board
+    const Bitboard back_ranks = rankMask(0) | rankMask(kBoardSize - 1);
+    return rank == kBoardSize - 1 && file == kBoardSize &&
+           (board.pieces(PieceType::Pawn) & back_ranks) == 0 &&
+           popCount(board.pieces(PieceType::King, Color::White)) == 1 &&
+           popCount(board.pieces(PieceType::King, Color::Black)) == 1;
+}
+
+[[nodiscard]] std::optional<CastlingRights> parseCastling(std::string_view field) noexcept {
+    CastlingRights rights{false, false, false, false};
+    if (field == "-") return rights;
+    for (char c : field) {
+        const auto it = std::ranges::find(kCastlingChars, c);
+        if (it == kCastlingChars.end()) return std::nullopt;
+        rights[static_cast<std::size_t>(it - kCastlingChars.begin())] = true;
+    }
+    return rights;
+}
+
+/// @return true on success; `ep` is left empty for "-"
+[[nodiscard]] bool parseEnPassant(std::string_view field, std::optional<Square>& ep) noexcept {
+    ep.reset();
+    if (field == "-") return true;
+    if (field.size() != 2) return false;
+    const int file = field[0] - 'a';
+    const int rank = '8' - field[1];
+    if (!isValidSquare(rank, file)) return false;
+    ep = Square{rank, file};
+    return true;
+}
+
+[[nodiscard]] bool parseNumber(std::string_view field, int& value) noexcept {
+    const auto* end = field.data() + field.size();
+    const auto [ptr, ec] = std::from_chars(field.data(), end, value);
+    return ec == std::errc{} && ptr == end && value >= 0;
+}
+
+} // namespace
+
+std::optional<FenPosition> parseFen(std::string_view fen) {
+    FieldReader fields(fen);
+    FenPosition position;
+
+    const auto placement = fields.next();
+    if (!placement || !parsePlacement(*placement, position.board)) return std::nullopt;
+
+    const auto side = fields.next();
+    if (!side || (*side != "w" && *side != "b")) return std::nullopt;
+    position.side_to_move = (*side == "w") ? Color::White : Color::Black;
+    // The side that just moved cannot have left its king in check
+    if (Rules{}.isCheck(position.board, opponent(position.side_to_move))) return std::nullopt;
+
+    const auto castling_field = fields.next();
+    const auto castling = castling_field ? parseCastling(*castling_field) : std::nullopt;
+    if (!castling) return std::nullopt;
+    position.board.setCastlingRights(*castling);
+
+    std::optional<Square> ep;
+    const auto ep_field = fields.next();
+    if (!ep_field || !parseEnPassant(*ep_field, ep)) return std::nullopt;
+    // Keep the square only if it is on the right rank, empty, behind an
+    // enemy pawn whose start square is empty, and one of our pawns can
+    // capture onto it.
+    const Color us = position.side_to_move;
+    const int ep_rank = (us == Color::White) ? 2 : 5;
+    const int victim_rank = (us == Color::White) ? 3 : 4;
+    const int start_rank = (us == Color::White) ? 1 : 6;
+    const Board& board = position.board;
+    if (ep && ep->rank == ep_rank && !board.at(*ep) &&
+        !board.at(Square{start_rank, ep->file}) &&
+        contains(board.pieces(PieceType::Pawn, opponent(us)),
+                 toIndex(Square{victim_rank, ep->file})) &&
+        (pawnAttacks(opponent(us), toIndex(*ep)) & board.pieces(PieceType::Pawn, us))) {
+        position.board.setEnPassantSquare(ep);
+    }
+
+    if (const auto halfmove = fields.next()) {
+        if (!parseNumber(*halfmove, position.halfmove_clock)) return std::nullopt;
+        const auto fullmove = fields.next();
+        if (!fullmove || !parseNumber(*fullmove, position.fullmove_number)) return std::nullopt;
+    }
+
+    return position;
+}
+
+// ============================================================================
+// Serialization
+// ============================================================================
+
+void FenString::pushNumber(int value) noexcept {
+    const auto [end, ec] = std::to_chars(chars_.data() + size_, chars_.data() + kCapacity,
+                                         std::max(value, 0));
+    if (ec == std::errc{}) {
+        size_ = static_cast<std::size_t>(end - chars_.data());
+    }
+}
+
+FenString toFen(const Board& board, Color side_to_move, int halfmove_clock,
+                int fullmove_number) noexcept {
+    FenString fen;
+
+    for (int rank = 0; rank < kBoardSize; ++rank) {
+        if (rank > 0) fen.push('/');
+        int empty = 0;
+        for (const auto& piece : board.rank(rank)) {
+            if (!piece) {
+                ++empty;
+                continue;
+            }
+            if (empty > 0) fen.push(static_cast<char>('0' + std::exchange(empty, 0)));
+            const char c = toChar(piece->type);
+            fen.push(piece->color == Color::White ? c : static_cast<char>(c - 'A' + 'a'));
+        }
+        if (empty > 0) fen.push(static_cast<char>('0' + empty));
+    }
+
+    fen.push(' ');
+    fen.push(side_to_move == Color::White ? 'w' : 'b');
+
+    fen.push(' ');
+    const CastlingRights& rights = board.castlingRights();
+    if (std::ranges::none_of(rights, [](bool right) { return right; })) {
+        fen.push('-');
+    }
+    for (std::size_t i = 0; i < rights.size(); ++i) {
+        if (rights[i]) fen.push(kCastlingChars[i]);
+    }
+
+    fen.push(' ');
+    if (const auto ep = board.enPassantSquare()) {
+        fen.push(fileToChar(ep->file));
+        fen.push(rankToChar(ep->rank));
+    } else {
+        fen.push('-');
+    }
+
+    fen.push(' ');
+    fen.pushNumber(halfmove_clock);
+    fen.push(' ');
+    fen.pushNumber(fullmove_number);
+    return fen;
+}
+
+} // namespace chess
@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include "Board.hpp"
+
+/// @file Fen.hpp
+/// @brief Forsyth-Edwards Notation (FEN) position parsing and serialization.
+
+namespace chess {
+
+/// FEN of the standard starting position.
+inline constexpr std::string_view kStartFen =
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+/// Complete position decoded from a FEN string.
+struct FenPosition {
+    Board board;
+    Color side_to_move{Color::White};
+    int halfmove_clock{0};
+    int fullmove_number{1};
+};
+
+/// Parse a FEN string without allocating.
+///
+/// The clock fields may be omitted (defaulting to 0 and 1), as in EPD.
+/// An en-passant square that no double push could have left (it must be
+/// empty, behind an enemy pawn, with that pawn's start square empty) or that
+/// no pawn can capture on is dropped, matching Board's en-passant invariant.
+/// @return nullopt if the string is malformed, either side does not have
+///         exactly one king, a pawn stands on the first or last rank, or the
+///         side not to move is in check
+[[nodiscard]] std::optional<FenPosition> parseFen(std::string_view fen);
+
+/// FEN text held in inline storage, so serializing never allocates.
+class FenString {
+public:
+    /// Enough for any position: 71 placement characters, the side, castling
+    /// and en-passant fields, two 10-digit clocks and separators.
+    static constexpr std::size_t kCapacity = 104;
+
+    [[nodiscard]] std::string_view view() const noexcept { return {chars_.data(), size_}; }
+    [[nodiscard]] operator std::string_view() const noexcept { return view(); }
+
+    /// Append one character.
+    /// @pre The capacity is not exceeded
+    void push(char c) noexcept { chars_[size_++] = c; }
+
+    /// Append a non-negative decimal number.
+    void pushNumber(int value) noexcept;
+
+private:
+    std::array<char, kCapacity> chars_{};
+    std::size_t size_{0};
+};
+
+/// Serialize a position to FEN without allocating.
+///
+/// The en-passant field is written only when Board holds a square, i.e. when
+/// the capture is actually available, so parseFen(toFen(p)) round-trips.
+[[nodiscard]] FenString toFen(const Board& board, Color side_to_move,
+                              int halfmove_clock = 0, int fullmove_number = 1) noexcept;
+
+[[nodiscard]] inline FenString toFen(const FenPosition& position) noexcept {
+    return toFen(position.board, position.side_to_move, position.halfmove_clock,
+                 position.fullmove_number);
+}
+
+} // namespace chess
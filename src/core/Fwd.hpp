@@ -14,6 +14,11 @@ enum class PieceType : unsigned char;
 struct Square;
 struct Piece;
 struct Move;
+class PackedMove;
+struct UndoInfo;
+
+// Containers
+class MoveList;
 
 // Classes
 class Board;
@@ -1,11 +1,17 @@
 ﻿#pragma once
+#include <array>
 #include <span>
 #include <vector>
+#include "Bitboard.hpp"
 #include "Board.hpp"
 #include "Move.hpp"
 
 namespace chess {
 
+/// Legal move destinations of a position, indexed by origin square index:
+/// bit t of entry f is set if a legal move goes from square f to square t.
+using LegalDestinations = std::array<Bitboard, kSquareCount>;
+
 /// Abstract interface for chess game state and move execution.
 ///
 /// Implementations manage the full game state including:
@@ -14,6 +20,7 @@ namespace chess {
 /// - Castling rights
 /// - En-passant eligibility
 /// - Move validation
+/// - Move history (undo/redo, repetition)
 class IGame {
 public:
     virtual ~IGame() = default;
@@ -30,6 +37,14 @@ public:
     /// @return true if move was legal and applied, false otherwise
     [[nodiscard]] virtual bool makeMove(const Move& move) = 0;
 
+    /// Take back the last move played.
+    /// @return false if there is no move to take back
+    [[nodiscard]] virtual bool undoMove() = 0;
+
+    /// Replay the last move taken back, unless a different move was made since.
+    /// @return false if there is no move to replay
+    [[nodiscard]] virtual bool redoMove() = 0;
+
     // ========================================================================
     // State Queries
     // ========================================================================
@@ -43,6 +58,24 @@ public:
     /// Get all legal moves for the current position.
     [[nodiscard]] virtual std::vector<Move> legalMoves() const = 0;
 
+    /// Get the legal destinations per origin square for the current position.
+    /// @note The reference stays valid, but its contents change with the position.
+    [[nodiscard]] virtual const LegalDestinations& legalDestinations() const = 0;
+
+    /// Get the Zobrist key of the current position (pieces, side to move,
+    /// castling rights, en-passant file). Equal positions have equal keys.
+    [[nodiscard]] virtual zobrist::Key positionKey() const noexcept = 0;
+
+    /// Keys of the earlier positions that could still repeat (those since the
+    /// last capture or pawn move), oldest first. Lets a search recognize
+    /// repetitions of positions played before its root.
+    [[nodiscard]] virtual std::span<const zobrist::Key> repetitionKeys() const noexcept {
+        return {};
+    }
+
+    /// Plies since the last capture or pawn move (for the fifty-move rule).
+    [[nodiscard]] virtual int halfmoveClock() const noexcept { return 0; }
+
     // ========================================================================
     // Game Status (optional overrides with default implementations)
     // ========================================================================
@@ -50,7 +83,7 @@ public:
     /// Check if the current side is in check.
     [[nodiscard]] virtual bool isCheck() const { return false; }
 
-    /// Check if the game is over (checkmate or stalemate).
+    /// Check if the game is over (checkmate, stalemate or a draw).
     [[nodiscard]] virtual bool isGameOver() const { return false; }
 
     /// Check if the current position is checkmate.
@@ -58,6 +91,9 @@ public:
 
     /// Check if the current position is stalemate.
     [[nodiscard]] virtual bool isStalemate() const { return false; }
+
+    /// Check if the game is drawn by threefold repetition or the fifty-move rule.
+    [[nodiscard]] virtual bool isDraw() const { return false; }
 };
 
 } // namespace chess
@@ -0,0 +1,127 @@
+#include "Instrumentation.hpp"
+#include <algorithm>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace chess::instrument {
+
+namespace {
+
+constexpr std::array<std::string_view, kCounterCount> kCounterNames = {
+    "legal_move_generations", "moves_generated",    "attack_queries",
+    "check_tests",            "board_copies",       "board_moves",
+    "move_legality_checks",   "status_cache_misses",
+};
+
+constexpr std::array<std::string_view, kTimerCount> kTimerNames = {
+    "rules_legal_moves",
+    "game_make_move",
+    "game_position_status",
+};
+
+/// Live threads' slots, plus the totals of threads that have exited.
+struct Registry {
+    std::mutex mutex;
+    std::vector<detail::ThreadSlots*> threads;
+    Snapshot retired;
+};
+
+/// Constructed before the first ThreadSlots, so it outlives all of them
+/// (thread_local objects are destroyed before statics).
+[[nodiscard]] Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+void accumulate(Snapshot& into, const detail::ThreadSlots& slots) {
+    for (std::size_t i = 0; i < kCounterCount; ++i) {
+        into.counters[i] += slots.counters[i].load(std::memory_order_relaxed);
+    }
+    for (std::size_t i = 0; i < kTimerCount; ++i) {
+        into.timers[i].calls += slots.timer_calls[i].load(std::memory_order_relaxed);
+        into.timers[i].total +=
+            std::chrono::nanoseconds{slots.timer_nanos[i].load(std::memory_order_relaxed)};
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Names
+// ============================================================================
+
+std::string_view name(Counter counter) noexcept {
+    return kCounterNames[static_cast<std::size_t>(counter)];
+}
+
+std::string_view name(Timer timer) noexcept {
+    return kTimerNames[static_cast<std::size_t>(timer)];
+}
+
+// ============================================================================
+// Thread Slots
+// ============================================================================
+
+namespace detail {
+
+ThreadSlots::ThreadSlots() {
+    Registry& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    reg.threads.push_back(this);
+}
+
+ThreadSlots::~ThreadSlots() {
+    Registry& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    accumulate(reg.retired, *this);
+    std::erase(reg.threads, this);
+}
+
+ThreadSlots& threadSlots() noexcept {
+    thread_local ThreadSlots slots;
+    return slots;
+}
+
+} // namespace detail
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+Snapshot snapshot() {
+    Registry& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    Snapshot total = reg.retired;
+    for (const detail::ThreadSlots* slots : reg.threads) {
+        accumulate(total, *slots);
+    }
+    return total;
+}
+
+void reset() {
+    Registry& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    reg.retired = {};
+    for (detail::ThreadSlots* slots : reg.threads) {
+        for (auto& counter : slots->counters) counter.store(0, std::memory_order_relaxed);
+        for (auto& calls : slots->timer_calls) calls.store(0, std::memory_order_relaxed);
+        for (auto& nanos : slots->timer_nanos) nanos.store(0, std::memory_order_relaxed);
+    }
+}
+
+void writeJson(std::ostream& out, const Snapshot& snapshot) {
+    out << "{\"enabled\": " << (kEnabled ? "true" : "false") << ", \"counters\": {";
+    for (std::size_t i = 0; i < kCounterCount; ++i) {
+        out << (i > 0 ? ", " : "") << '"' << kCounterNames[i] << "\": " << snapshot.counters[i];
+    }
+    out << "}, \"timers\": {";
+    for (std::size_t i = 0; i < kTimerCount; ++i) {
+        out << (i > 0 ? ", " : "") << '"' << kTimerNames[i] << "\": {\"calls\": "
+            << snapshot.timers[i].calls << ", \"total_ns\": " << snapshot.timers[i].total.count()
+            << '}';
+    }
+    out << "}}\n";
+}
+
+} // namespace chess::instrument
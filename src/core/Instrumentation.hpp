@@ -0,0 +1,170 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+/// @file Instrumentation.hpp
+/// @brief Hot-path event counters and scoped timers, compiled in on demand.
+///
+/// Configure with -DCHESS_INSTRUMENT=ON to enable. Otherwise kEnabled is false,
+/// count() and ScopedTimer compile to nothing, and snapshot() reports zeros,
+/// so call sites need no preprocessor guards.
+///
+/// Each thread counts into its own thread-local slots (plain relaxed
+/// stores, no read-modify-write), and snapshot() sums the slots of every
+/// thread, including threads that have already exited.
+
+namespace chess::instrument {
+
+/// True when the build counts events (CHESS_INSTRUMENT in CMakeLists.txt).
+inline constexpr bool kEnabled =
+#if defined(CHESS_INSTRUMENT)
+    true;
+#else
+    false;
+#endif
+
+// ============================================================================
+// Events
+// ============================================================================
+
+enum class Counter : std::uint8_t {
+    LegalMoveGenerations,  ///< Rules::legalMoves() calls
+    MovesGenerated,        ///< Legal moves those calls produced
+    AttackQueries,         ///< Attackers-of-square lookups (checks, pins, king safety)
+    CheckTests,            ///< Rules::isCheck() calls
+    BoardCopies,           ///< Board copy constructions and assignments
+    BoardMoves,            ///< Board::makeMove() calls
+    MoveLegalityChecks,    ///< ChessGame::makeMove() lookups in the legal move list
+    StatusCacheMisses,     ///< ChessGame positions whose legal moves had to be generated
+    kCount
+};
+
+enum class Timer : std::uint8_t {
+    RulesLegalMoves,     ///< Rules::legalMoves()
+    GameMakeMove,        ///< ChessGame::makeMove()
+    GamePositionStatus,  ///< ChessGame legal move / check status generation
+    kCount
+};
+
+inline constexpr std::size_t kCounterCount = static_cast<std::size_t>(Counter::kCount);
+inline constexpr std::size_t kTimerCount = static_cast<std::size_t>(Timer::kCount);
+
+/// snake_case name, as used in JSON output.
+[[nodiscard]] std::string_view name(Counter counter) noexcept;
+[[nodiscard]] std::string_view name(Timer timer) noexcept;
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+struct TimerTotals {
+    std::uint64_t calls{0};
+    std::chrono::nanoseconds total{0};
+};
+
+/// Totals over all threads at one point in time.
+struct Snapshot {
+    std::array<std::uint64_t, kCounterCount> counters{};
+    std::array<TimerTotals, kTimerCount> timers{};
+
+    [[nodiscard]] std::uint64_t operator[](Counter counter) const noexcept {
+        return counters[static_cast<std::size_t>(counter)];
+    }
+    [[nodiscard]] const TimerTotals& operator[](Timer timer) const noexcept {
+        return timers[static_cast<std::size_t>(timer)];
+    }
+};
+
+/// Sum the counters of all threads.
+/// @note Thread-safe; counts still being made by other threads may be missed.
+[[nodiscard]] Snapshot snapshot();
+
+/// Zero all counters, e.g. before a measured section.
+/// @note Events counted concurrently by other threads may survive the reset.
+void reset();
+
+/// Write a snapshot as one JSON object:
+/// {"enabled": bool, "counters": {name: n, ...},
+///  "timers": {name: {"calls": n, "total_ns": n}, ...}}
+void writeJson(std::ostream& out, const Snapshot& snapshot);
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+namespace detail {
+
+/// One thread's counters; registered for snapshot() while the thread lives.
+struct ThreadSlots {
+    std::array<std::atomic<std::uint64_t>, kCounterCount> counters{};
+    std::array<std::atomic<std::uint64_t>, kTimerCount> timer_calls{};
+    std::array<std::atomic<std::uint64_t>, kTimerCount> timer_nanos{};
+
+    ThreadSlots();
+    ~ThreadSlots();
+    ThreadSlots(const ThreadSlots&) = delete;
+    ThreadSlots& operator=(const ThreadSlots&) = delete;
+};
+
+[[nodiscard]] ThreadSlots& threadSlots() noexcept;
+
+/// Only the owning thread writes a slot, so a load and store suffice.
+inline void add(std::atomic<std::uint64_t>& slot, std::uint64_t amount) noexcept {
+    slot.store(slot.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+/// Record `amount` events.
+inline void count(Counter counter, std::uint64_t amount = 1) noexcept {
+    if constexpr (kEnabled) {
+        detail::add(detail::threadSlots().counters[static_cast<std::size_t>(counter)], amount);
+    }
+}
+
+/// Adds the lifetime of a scope to a timer.
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Timer timer) noexcept : timer_(timer) {
+        if constexpr (kEnabled) start_ = Clock::now();
+    }
+
+    ~ScopedTimer() {
+        if constexpr (kEnabled) {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - start_);
+            const auto index = static_cast<std::size_t>(timer_);
+            detail::ThreadSlots& slots = detail::threadSlots();
+            detail::add(slots.timer_calls[index], 1);
+            detail::add(slots.timer_nanos[index], static_cast<std::uint64_t>(elapsed.count()));
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Timer timer_;
+    Clock::time_point start_{};
+};
+
+/// Member that counts copies of the object containing it (see Board).
+template <Counter C>
+struct CopyCounter {
+    CopyCounter() = default;
+    CopyCounter(const CopyCounter&) noexcept { count(C); }
+    CopyCounter& operator=(const CopyCounter&) noexcept {
+        count(C);
+        return *this;
+    }
+    ~CopyCounter() = default;
+};
+
+} // namespace chess::instrument
@@ -0,0 +1,136 @@
+#include "MappedFile.hpp"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace chess {
+
+// ============================================================================
+// Platform Mapping
+// ============================================================================
+
+namespace {
+
+/// An empty file has nothing to map; it is represented without a mapping.
+struct Mapping {
+    const std::byte* data{nullptr};
+    std::size_t size{0};
+};
+
+#ifdef _WIN32
+
+[[nodiscard]] std::optional<Mapping> mapFile(const std::filesystem::path& path) {
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return std::nullopt;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return std::nullopt;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(file);
+        return Mapping{};
+    }
+
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);  // The mapping object keeps the file open
+    if (mapping == nullptr) return std::nullopt;
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);  // The view keeps the mapping alive
+    if (view == nullptr) return std::nullopt;
+
+    return Mapping{.data = static_cast<const std::byte*>(view),
+                   .size = static_cast<std::size_t>(size.QuadPart)};
+}
+
+void unmapFile(const std::byte* data, std::size_t /*size*/) noexcept {
+    UnmapViewOfFile(data);
+}
+
+#else
+
+[[nodiscard]] std::optional<Mapping> mapFile(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return std::nullopt;
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return std::nullopt;
+    }
+    const auto size = static_cast<std::size_t>(info.st_size);
+    if (size == 0) {
+        ::close(fd);
+        return Mapping{};
+    }
+
+    void* view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file open
+    if (view == MAP_FAILED) return std::nullopt;
+
+    return Mapping{.data = static_cast<const std::byte*>(view), .size = size};
+}
+
+void unmapFile(const std::byte* data, std::size_t size) noexcept {
+    ::munmap(const_cast<std::byte*>(data), size);
+}
+
+#endif
+
+} // namespace
+
+// ============================================================================
+// MappedFile
+// ============================================================================
+
+std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path) {
+    const auto mapping = mapFile(path);
+    if (!mapping) return std::nullopt;
+
+    MappedFile file;
+    file.data_ = mapping->data;
+    file.size_ = mapping->size;
+    return file;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+void MappedFile::unmap() noexcept {
+    if (data_ != nullptr) {
+        unmapFile(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+} // namespace chess
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+/// @file MappedFile.hpp
+/// @brief Read-only memory-mapped files.
+
+namespace chess {
+
+/// A whole file mapped read-only into memory.
+///
+/// Pages are loaded by the OS on first touch, so opening a multi-gigabyte
+/// file is cheap and sequential scans stream from the page cache without
+/// copying into user buffers. Move-only; the mapping lives as long as the
+/// object.
+class MappedFile {
+public:
+    /// Map a file.
+    /// @return nullopt if the file cannot be opened or mapped
+    [[nodiscard]] static std::optional<MappedFile> open(const std::filesystem::path& path);
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return {data_, size_}; }
+
+    [[nodiscard]] std::string_view text() const noexcept {
+        return {reinterpret_cast<const char*>(data_), size_};
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+private:
+    MappedFile() = default;
+
+    void unmap() noexcept;
+
+    const std::byte* data_{nullptr};
+    std::size_t size_{0};
+};
+
+} // namespace chess
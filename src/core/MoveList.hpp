@@ -0,0 +1,58 @@
+#pragma once
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include "Move.hpp"
+
+namespace chess {
+
+/// Fixed-capacity, stack-resident list of moves.
+///
+/// Move generation fills one of these instead of a std::vector so hot loops
+/// (search, perft, status checks) never touch the heap. Contiguous storage
+/// with begin()/end()/data()/size() makes it usable anywhere a
+/// std::span<const Move> or range is expected.
+class MoveList {
+public:
+    /// Comfortably above the maximum number of legal moves in any reachable
+    /// position (218).
+    static constexpr std::size_t kCapacity = 256;
+
+    // Storage is left uninitialized: constructing 256 moves per generation
+    // call would cost more than generating them.
+    MoveList() noexcept {}
+
+    /// @pre size() < kCapacity
+    void push_back(const Move& move) noexcept {
+        assert(size_ < kCapacity);
+        moves_[size_++] = move;
+    }
+
+    void clear() noexcept { size_ = 0; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    [[nodiscard]] Move* data() noexcept { return moves_.data(); }
+    [[nodiscard]] const Move* data() const noexcept { return moves_.data(); }
+
+    [[nodiscard]] Move* begin() noexcept { return data(); }
+    [[nodiscard]] Move* end() noexcept { return data() + size_; }
+    [[nodiscard]] const Move* begin() const noexcept { return data(); }
+    [[nodiscard]] const Move* end() const noexcept { return data() + size_; }
+
+    /// @pre index < size()
+    [[nodiscard]] Move& operator[](std::size_t index) noexcept { return moves_[index]; }
+    [[nodiscard]] const Move& operator[](std::size_t index) const noexcept { return moves_[index]; }
+
+    [[nodiscard]] std::span<const Move> view() const noexcept { return {data(), size_}; }
+
+private:
+    std::size_t size_{0};
+    union {
+        std::array<Move, kCapacity> moves_;
+    };
+};
+
+} // namespace chess
@@ -0,0 +1,25 @@
+#pragma once
+#include <string>
+#include "Move.hpp"
+#include "Types.hpp"
+
+/// @file Notation.hpp
+/// @brief Text formatting of squares and moves.
+
+namespace chess {
+
+/// Algebraic square name, e.g. "e4".
+[[nodiscard]] inline std::string toAlgebraic(Square sq) {
+    return {fileToChar(sq.file), rankToChar(sq.rank)};
+}
+
+/// Long algebraic (UCI) move text, e.g. "e2e4" or "e7e8q".
+[[nodiscard]] inline std::string toUci(const Move& move) {
+    std::string text = toAlgebraic(move.from) + toAlgebraic(move.to);
+    if (move.promotion) {
+        text.push_back(static_cast<char>(toChar(*move.promotion) - 'A' + 'a'));
+    }
+    return text;
+}
+
+} // namespace chess
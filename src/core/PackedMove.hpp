@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include "Bitboard.hpp"
+#include "Move.hpp"
+
+namespace chess {
+
+/// Move packed into 16 bits for move stacks, transposition tables and archives.
+///
+/// Layout:
+/// - bits 0-5:   from square index (0..63, see Bitboard.hpp)
+/// - bits 6-11:  to square index
+/// - bits 12-15: flags: 0 = normal, 1 = castling, 2 = en-passant,
+///               8 | n = promotion to Knight/Bishop/Rook/Queen (n = 0..3)
+///
+/// The all-zero value (a8 -> a8) can never be a real move and serves as "no move".
+class PackedMove {
+public:
+    constexpr PackedMove() noexcept = default;
+
+    /// Pack a fully-flagged move (as produced by Rules).
+    /// @pre move.from.isValid() && move.to.isValid()
+    explicit constexpr PackedMove(const Move& move) noexcept
+        : bits_(static_cast<std::uint16_t>(chess::toIndex(move.from) |
+                                           (chess::toIndex(move.to) << kToShift) |
+                                           (flagsOf(move) << kFlagShift))) {}
+
+    /// Reinterpret a raw 16-bit value (e.g. read from disk).
+    [[nodiscard]] static constexpr PackedMove fromRaw(std::uint16_t bits) noexcept {
+        PackedMove move;
+        move.bits_ = bits;
+        return move;
+    }
+
+    [[nodiscard]] constexpr std::uint16_t raw() const noexcept { return bits_; }
+    [[nodiscard]] constexpr bool isNull() const noexcept { return bits_ == 0; }
+
+    [[nodiscard]] constexpr int fromIndex() const noexcept { return bits_ & kSquareMask; }
+    [[nodiscard]] constexpr int toIndex() const noexcept { return (bits_ >> kToShift) & kSquareMask; }
+    [[nodiscard]] constexpr Square from() const noexcept { return toSquare(fromIndex()); }
+    [[nodiscard]] constexpr Square to() const noexcept { return toSquare(toIndex()); }
+
+    [[nodiscard]] constexpr bool isCastling() const noexcept { return flags() == kCastlingFlag; }
+    [[nodiscard]] constexpr bool isEnPassant() const noexcept { return flags() == kEnPassantFlag; }
+    [[nodiscard]] constexpr bool isPromotion() const noexcept { return (flags() & kPromotionFlag) != 0; }
+
+    /// Unpack into the UI-facing Move representation.
+    [[nodiscard]] constexpr Move toMove() const noexcept {
+        Move move{.from = from(), .to = to()};
+        move.castling = isCastling();
+        move.en_passant = isEnPassant();
+        if (isPromotion()) {
+            move.promotion = static_cast<PieceType>(
+                static_cast<int>(PieceType::Knight) + (flags() & kPromotionPieceMask));
+        }
+        return move;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const PackedMove&) const noexcept = default;
+
+private:
+    static constexpr int kToShift = 6;
+    static constexpr int kFlagShift = 12;
+    static constexpr int kSquareMask = 0x3F;
+    static constexpr int kCastlingFlag = 1;
+    static constexpr int kEnPassantFlag = 2;
+    static constexpr int kPromotionFlag = 8;
+    static constexpr int kPromotionPieceMask = 3;
+
+    [[nodiscard]] constexpr int flags() const noexcept { return bits_ >> kFlagShift; }
+
+    [[nodiscard]] static constexpr int flagsOf(const Move& move) noexcept {
+        if (move.promotion) {
+            return kPromotionFlag |
+                   (static_cast<int>(*move.promotion) - static_cast<int>(PieceType::Knight));
+        }
+        if (move.castling) return kCastlingFlag;
+        if (move.en_passant) return kEnPassantFlag;
+        return 0;
+    }
+
+    std::uint16_t bits_{0};
+};
+
+static_assert(sizeof(PackedMove) == 2);
+
+} // namespace chess
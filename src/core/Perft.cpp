@@ -0,0 +1,38 @@
+#include "Perft.hpp"
+#include "Rules.hpp"
+
+namespace chess {
+
+std::uint64_t perft(Board& board, Color side, int depth) {
+    if (depth == 0) return 1;
+
+    MoveList moves;
+    Rules{}.legalMoves(board, side, moves);
+
+    // Bulk counting: the leaves are exactly the legal moves at depth 1
+    if (depth == 1) return moves.size();
+
+    std::uint64_t nodes = 0;
+    for (const Move& move : moves) {
+        const UndoInfo undo = board.makeMove(move);
+        nodes += perft(board, opponent(side), depth - 1);
+        board.unmakeMove(move, undo);
+    }
+    return nodes;
+}
+
+std::vector<PerftDivideEntry> perftDivide(Board& board, Color side, int depth) {
+    MoveList moves;
+    Rules{}.legalMoves(board, side, moves);
+
+    std::vector<PerftDivideEntry> entries;
+    entries.reserve(moves.size());
+    for (const Move& move : moves) {
+        const UndoInfo undo = board.makeMove(move);
+        entries.push_back({.move = move, .nodes = perft(board, opponent(side), depth - 1)});
+        board.unmakeMove(move, undo);
+    }
+    return entries;
+}
+
+} // namespace chess
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Board.hpp"
+
+/// @file Perft.hpp
+/// @brief Move-path enumeration for validating and timing move generation.
+
+namespace chess {
+
+/// Node count below one root move.
+struct PerftDivideEntry {
+    Move move{};
+    std::uint64_t nodes{0};
+};
+
+/// Count leaf nodes of the legal move tree to `depth` plies.
+/// @param board Position to search; restored to its original state on return
+/// @pre depth >= 0
+[[nodiscard]] std::uint64_t perft(Board& board, Color side, int depth);
+
+/// Per-root-move perft counts, for locating move generator bugs.
+/// @pre depth >= 1
+[[nodiscard]] std::vector<PerftDivideEntry> perftDivide(Board& board, Color side, int depth);
+
+} // namespace chess
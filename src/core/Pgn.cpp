@@ -0,0 +1,185 @@
+#include "Pgn.hpp"
+#include <algorithm>
+
+namespace chess {
+
+namespace {
+
+[[nodiscard]] constexpr bool isSpace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+[[nodiscard]] constexpr bool isDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+/// Position just past the next occurrence of `c` at or after `pos`, or the end.
+[[nodiscard]] std::size_t skipPast(std::string_view text, std::size_t pos, char c) noexcept {
+    const auto found = text.find(c, pos);
+    return found == std::string_view::npos ? text.size() : found + 1;
+}
+
+[[nodiscard]] std::size_t skipSpaces(std::string_view text, std::size_t pos) noexcept {
+    while (pos < text.size() && isSpace(text[pos])) ++pos;
+    return pos;
+}
+
+} // namespace
+
+GameResult parseGameResult(std::string_view text) noexcept {
+    if (text == "1-0") return GameResult::WhiteWins;
+    if (text == "0-1") return GameResult::BlackWins;
+    if (text == "1/2-1/2") return GameResult::Draw;
+    return GameResult::Unknown;
+}
+
+// ============================================================================
+// PgnGame
+// ============================================================================
+
+std::optional<std::string_view> PgnGame::tag(std::string_view name) const noexcept {
+    std::size_t pos = 0;
+    while ((pos = tags.find('[', pos)) != std::string_view::npos) {
+        const std::size_t line_end = std::min(tags.find('\n', pos), tags.size());
+        const std::string_view line = tags.substr(pos + 1, line_end - pos - 1);
+        pos = line_end;
+
+        // [Name "Value"]
+        const std::size_t name_end = line.find_first_of(" \t");
+        if (line.substr(0, name_end) != name) continue;
+        const std::size_t open = line.find('"', name_end);
+        const std::size_t close = line.rfind('"');
+        if (open == std::string_view::npos || close <= open) return std::nullopt;
+        return line.substr(open + 1, close - open - 1);
+    }
+    return std::nullopt;
+}
+
+GameResult PgnGame::result() const noexcept {
+    const auto value = tag("Result");
+    return value ? parseGameResult(*value) : GameResult::Unknown;
+}
+
+// ============================================================================
+// PgnReader
+// ============================================================================
+
+std::optional<PgnGame> PgnReader::next() noexcept {
+    std::size_t pos = skipSpaces(text_, pos_);
+    if (pos >= text_.size()) {
+        pos_ = pos;
+        return std::nullopt;
+    }
+
+    // Tag pair section: consecutive lines starting with '['
+    const std::size_t tags_begin = pos;
+    std::size_t tags_end = pos;
+    while (pos < text_.size() && text_[pos] == '[') {
+        pos = skipPast(text_, pos, '\n');
+        tags_end = pos;
+        pos = skipSpaces(text_, pos);
+    }
+
+    // Movetext: up to a '[' starting a line outside any comment
+    const std::size_t movetext_begin = pos;
+    while (pos < text_.size()) {
+        pos = text_.find_first_of("{;\n", pos);
+        if (pos == std::string_view::npos) {
+            pos = text_.size();
+            break;
+        }
+        const char c = text_[pos];
+        if (c == '{') {
+            pos = skipPast(text_, pos, '}');
+        } else if (c == ';') {
+            pos = text_.find('\n', pos);
+            if (pos == std::string_view::npos) pos = text_.size();
+        } else if (pos + 1 < text_.size() && text_[pos + 1] == '[') {
+            ++pos;
+            break;
+        } else {
+            ++pos;
+        }
+    }
+
+    pos_ = pos;
+    return PgnGame{
+        .tags = text_.substr(tags_begin, tags_end - tags_begin),
+        .movetext = text_.substr(movetext_begin, pos - movetext_begin),
+    };
+}
+
+// ============================================================================
+// MovetextReader
+// ============================================================================
+
+std::optional<std::string_view> MovetextReader::next() noexcept {
+    while (true) {
+        std::size_t pos = skipSpaces(rest_, 0);
+        if (pos >= rest_.size()) {
+            rest_ = {};
+            return std::nullopt;
+        }
+
+        const char c = rest_[pos];
+        if (c == '{') {
+            rest_.remove_prefix(skipPast(rest_, pos, '}'));
+            continue;
+        }
+        if (c == ';') {
+            rest_.remove_prefix(skipPast(rest_, pos, '\n'));
+            continue;
+        }
+        if (c == '(') {
+            // Variations nest and may contain comments with parentheses
+            int depth = 0;
+            while (pos < rest_.size()) {
+                const char v = rest_[pos];
+                if (v == '{') {
+                    pos = skipPast(rest_, pos, '}');
+                    continue;
+                }
+                if (v == ';') {
+                    pos = skipPast(rest_, pos, '\n');
+                    continue;
+                }
+                ++pos;
+                if (v == '(') ++depth;
+                if (v == ')' && --depth == 0) break;
+            }
+            rest_.remove_prefix(pos);
+            continue;
+        }
+        if (c == '[') {
+            // Start of the next game's tags; PgnReader normally stops before it
+            rest_ = {};
+            return std::nullopt;
+        }
+
+        std::size_t end = pos;
+        while (end < rest_.size() && !isSpace(rest_[end]) &&
+               std::string_view{"{};()"}.find(rest_[end]) == std::string_view::npos) {
+            ++end;
+        }
+        std::string_view token = rest_.substr(pos, end - pos);
+        rest_.remove_prefix(end);
+
+        if (token == "*" || parseGameResult(token) != GameResult::Unknown) {
+            rest_ = {};
+            return std::nullopt;
+        }
+        if (token.front() == '$' || token == ")") continue;  // NAG or stray close
+
+        // Move number, possibly glued to the move ("12.e4", "12...Nf6");
+        // "0-0" castling also starts with a digit but has no dot
+        if (isDigit(token.front())) {
+            const auto digits_end = static_cast<std::size_t>(
+                std::ranges::find_if_not(token, isDigit) - token.begin());
+            if (digits_end == token.size()) continue;  // Bare number
+            if (token[digits_end] == '.') token.remove_prefix(digits_end);
+        }
+        while (!token.empty() && token.front() == '.') token.remove_prefix(1);
+        if (token.empty()) continue;
+        return token;
+    }
+}
+
+} // namespace chess
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/// @file Pgn.hpp
+/// @brief Streaming Portable Game Notation (PGN) reading.
+///
+/// Everything here works on views into the caller's buffer (typically a
+/// MappedFile) and never allocates: a game is two slices of the input, and
+/// its moves are tokenized on demand.
+
+namespace chess {
+
+/// Outcome recorded for a game.
+enum class GameResult : std::uint8_t {
+    WhiteWins,  ///< "1-0"
+    BlackWins,  ///< "0-1"
+    Draw,       ///< "1/2-1/2"
+    Unknown     ///< "*" or missing
+};
+
+/// Decode a PGN result token ("1-0", "0-1", "1/2-1/2"); anything else is Unknown.
+[[nodiscard]] GameResult parseGameResult(std::string_view text) noexcept;
+
+/// One game as slices of the PGN input.
+struct PgnGame {
+    std::string_view tags;      ///< Tag pair lines, e.g. `[Event "..."]`
+    std::string_view movetext;  ///< Moves, comments, variations and result
+
+    /// Value of a tag pair, without quotes or unescaping.
+    [[nodiscard]] std::optional<std::string_view> tag(std::string_view name) const noexcept;
+
+    /// Result from the Result tag.
+    [[nodiscard]] GameResult result() const noexcept;
+};
+
+/// Splits PGN text into games.
+///
+/// A game is its tag pair section followed by movetext, which runs until the
+/// next tag line outside a comment. Only tag lines and comments are scanned,
+/// so splitting stays cheap enough for one thread to feed many replay workers.
+class PgnReader {
+public:
+    explicit PgnReader(std::string_view text) noexcept : text_(text) {}
+
+    /// The next game, or nullopt at end of input.
+    [[nodiscard]] std::optional<PgnGame> next() noexcept;
+
+    /// Bytes of input consumed so far.
+    [[nodiscard]] std::size_t offset() const noexcept { return pos_; }
+
+private:
+    std::string_view text_;
+    std::size_t pos_{0};
+};
+
+/// Yields the SAN moves of a game's main line.
+///
+/// Skips move numbers, comments (`{...}` and `;` to end of line), recursive
+/// variations, numeric annotation glyphs and the result token.
+class MovetextReader {
+public:
+    explicit MovetextReader(std::string_view movetext) noexcept : rest_(movetext) {}
+
+    /// The next move's SAN text, or nullopt at the end of the main line.
+    [[nodiscard]] std::optional<std::string_view> next() noexcept;
+
+private:
+    std::string_view rest_;
+};
+
+} // namespace chess
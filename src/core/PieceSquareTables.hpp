@@ -0,0 +1,199 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include "Bitboard.hpp"
+#include "Types.hpp"
+
+/// @file PieceSquareTables.hpp
+/// @brief Material and piece-square values for midgame and endgame.
+///
+/// Board sums pieceScore() incrementally as pieces move, so the base
+/// evaluation of any position is available in O(1). The combined tables are
+/// built at compile time and live in read-only data.
+
+namespace chess::psqt {
+
+/// Midgame/endgame score pair, in centipawns.
+struct Score {
+    int mg{0};
+    int eg{0};
+
+    [[nodiscard]] constexpr bool operator==(const Score&) const noexcept = default;
+
+    constexpr Score& operator+=(Score other) noexcept {
+        mg += other.mg;
+        eg += other.eg;
+        return *this;
+    }
+
+    constexpr Score& operator-=(Score other) noexcept {
+        mg -= other.mg;
+        eg -= other.eg;
+        return *this;
+    }
+
+    [[nodiscard]] constexpr Score operator-() const noexcept { return {-mg, -eg}; }
+};
+
+/// Game phase of the starting material; 0 means bare kings and pawns.
+inline constexpr int kMaxPhase = 24;
+
+namespace detail {
+
+using Table = std::array<int, kSquareCount>;
+
+/// Indexed by PieceType.
+inline constexpr std::array<int, kPieceTypeCount> kMidgameMaterial = {82, 337, 365, 477, 1025, 0};
+inline constexpr std::array<int, kPieceTypeCount> kEndgameMaterial = {94, 281, 297, 512, 936, 0};
+inline constexpr std::array<int, kPieceTypeCount> kPhaseWeights = {0, 1, 1, 2, 4, 0};
+
+// Tables are from White's point of view in square index order (a8 first),
+// so they read like a diagram. Black uses the rank-mirrored square.
+
+inline constexpr Table kPawnMidgame = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+     50,  50,  50,  50,  50,  50,  50,  50,
+     10,  10,  20,  30,  30,  20,  10,  10,
+      5,   5,  10,  25,  25,  10,   5,   5,
+      0,   0,   0,  20,  20,   0,   0,   0,
+      5,  -5, -10,   0,   0, -10,  -5,   5,
+      5,  10,  10, -20, -20,  10,  10,   5,
+      0,   0,   0,   0,   0,   0,   0,   0,
+};
+
+inline constexpr Table kPawnEndgame = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+     80,  80,  80,  80,  80,  80,  80,  80,
+     50,  50,  50,  50,  50,  50,  50,  50,
+     30,  30,  30,  30,  30,  30,  30,  30,
+     15,  15,  15,  15,  15,  15,  15,  15,
+      5,   5,   5,   5,   5,   5,   5,   5,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+};
+
+inline constexpr Table kKnight = {
+    -50, -40, -30, -30, -30, -30, -40, -50,
+    -40, -20,   0,   0,   0,   0, -20, -40,
+    -30,   0,  10,  15,  15,  10,   0, -30,
+    -30,   5,  15,  20,  20,  15,   5, -30,
+    -30,   0,  15,  20,  20,  15,   0, -30,
+    -30,   5,  10,  15,  15,  10,   5, -30,
+    -40, -20,   0,   5,   5,   0, -20, -40,
+    -50, -40, -30, -30, -30, -30, -40, -50,
+};
+
+inline constexpr Table kBishop = {
+    -20, -10, -10, -10, -10, -10, -10, -20,
+    -10,   0,   0,   0,   0,   0,   0, -10,
+    -10,   0,   5,  10,  10,   5,   0, -10,
+    -10,   5,   5,  10,  10,   5,   5, -10,
+    -10,   0,  10,  10,  10,  10,   0, -10,
+    -10,  10,  10,  10,  10,  10,  10, -10,
+    -10,   5,   0,   0,   0,   0,   5, -10,
+    -20, -10, -10, -10, -10, -10, -10, -20,
+};
+
+inline constexpr Table kRookMidgame = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+      5,  10,  10,  10,  10,  10,  10,   5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+      0,   0,   0,   5,   5,   0,   0,   0,
+};
+
+inline constexpr Table kRookEndgame = {
+     10,  10,  10,  10,  10,  10,  10,  10,
+     15,  15,  15,  15,  15,  15,  15,  15,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,
+};
+
+inline constexpr Table kQueen = {
+    -20, -10, -10,  -5,  -5, -10, -10, -20,
+    -10,   0,   0,   0,   0,   0,   0, -10,
+    -10,   0,   5,   5,   5,   5,   0, -10,
+     -5,   0,   5,   5,   5,   5,   0,  -5,
+      0,   0,   5,   5,   5,   5,   0,  -5,
+    -10,   5,   5,   5,   5,   5,   0, -10,
+    -10,   0,   5,   0,   0,   0,   0, -10,
+    -20, -10, -10,  -5,  -5, -10, -10, -20,
+};
+
+inline constexpr Table kKingMidgame = {
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -20, -30, -30, -40, -40, -30, -30, -20,
+    -10, -20, -20, -20, -20, -20, -20, -10,
+     20,  20,   0,   0,   0,   0,  20,  20,
+     20,  30,  10,   0,   0,  10,  30,  20,
+};
+
+inline constexpr Table kKingEndgame = {
+    -50, -40, -30, -20, -20, -30, -40, -50,
+    -30, -20, -10,   0,   0, -10, -20, -30,
+    -30, -10,  20,  30,  30,  20, -10, -30,
+    -30, -10,  30,  40,  40,  30, -10, -30,
+    -30, -10,  30,  40,  40,  30, -10, -30,
+    -30, -10,  20,  30,  30,  20, -10, -30,
+    -30, -30,   0,   0,   0,   0, -30, -30,
+    -50, -30, -30, -30, -30, -30, -30, -50,
+};
+
+/// Indexed by PieceType.
+inline constexpr std::array<const Table*, kPieceTypeCount> kMidgameTables = {
+    &kPawnMidgame, &kKnight, &kBishop, &kRookMidgame, &kQueen, &kKingMidgame
+};
+inline constexpr std::array<const Table*, kPieceTypeCount> kEndgameTables = {
+    &kPawnEndgame, &kKnight, &kBishop, &kRookEndgame, &kQueen, &kKingEndgame
+};
+
+/// Material plus placement per [color][type][square], signed so that
+/// White's pieces add and Black's subtract.
+inline constexpr auto kScores = [] {
+    std::array<std::array<std::array<Score, kSquareCount>, kPieceTypeCount>, kColorCount> scores{};
+    for (int type = 0; type < kPieceTypeCount; ++type) {
+        for (int index = 0; index < kSquareCount; ++index) {
+            const Score white{
+                kMidgameMaterial[type] + (*kMidgameTables[type])[index],
+                kEndgameMaterial[type] + (*kEndgameTables[type])[index]
+            };
+            scores[static_cast<std::size_t>(Color::White)][type][index] = white;
+            // Mirroring the rank maps a Black square onto White's table
+            scores[static_cast<std::size_t>(Color::Black)][type][index ^ 56] = -white;
+        }
+    }
+    return scores;
+}();
+
+} // namespace detail
+
+/// Score contribution of a piece on a 0..63 square index, from White's
+/// point of view.
+[[nodiscard]] constexpr Score pieceScore(Piece piece, int index) noexcept {
+    return detail::kScores[static_cast<std::size_t>(piece.color)]
+                          [static_cast<std::size_t>(piece.type)][index];
+}
+
+/// Contribution of a piece type to the game phase.
+[[nodiscard]] constexpr int phaseWeight(PieceType type) noexcept {
+    return detail::kPhaseWeights[static_cast<std::size_t>(type)];
+}
+
+/// Blend midgame and endgame scores by game phase.
+/// @note Phases above kMaxPhase (extra queens from promotion) count as midgame.
+[[nodiscard]] constexpr int taper(Score score, int phase) noexcept {
+    const int mg_phase = std::min(phase, kMaxPhase);
+    return (score.mg * mg_phase + score.eg * (kMaxPhase - mg_phase)) / kMaxPhase;
+}
+
+} // namespace chess::psqt
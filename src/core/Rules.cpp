@@ -1,7 +1,8 @@
 ﻿#include "Rules.hpp"
+#include "Attacks.hpp"
+#include "Instrumentation.hpp"
 #include <array>
 #include <cassert>
-#include <cmath>
 #include <optional>
 #include <ranges>
 #include <utility>
@@ -10,295 +11,260 @@ namespace chess {
 
 namespace {
 
-// Direction vectors for piece movement
-constexpr std::array<std::pair<int, int>, 8> kKnightMoves = {{
-    {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
-    {1, -2}, {1, 2}, {2, -1}, {2, 1}
-}};
-
-constexpr std::array<std::pair<int, int>, 8> kAllDirections = {{
-    {-1, 0}, {1, 0}, {0, -1}, {0, 1},      // Rook directions
-    {-1, -1}, {-1, 1}, {1, -1}, {1, 1}     // Bishop directions
-}};
-
-constexpr std::array<std::pair<int, int>, 4> kRookDirections = {{
-    {-1, 0}, {1, 0}, {0, -1}, {0, 1}
-}};
-
-constexpr std::array<std::pair<int, int>, 4> kBishopDirections = {{
-    {-1, -1}, {-1, 1}, {1, -1}, {1, 1}
-}};
-
 // ============================================================================
 // Square Attack Detection
 // ============================================================================
 
-[[nodiscard]] std::optional<Square> findKing(const Board& board, Color side) noexcept {
-    for (int r = 0; r < Board::kSize; ++r) {
-        for (int f = 0; f < Board::kSize; ++f) {
-            Square sq{r, f};
-            const auto& piece = board.at(sq);
-            if (piece && piece->type == PieceType::King && piece->color == side) {
-                return sq;
-            }
-        }
-    }
-    return std::nullopt;
+/// Pieces of both colors attacking `index`, with sliders seeing through
+/// everything not in `occupied`.
+[[nodiscard]] Bitboard attackersTo(const Board& board, int index, Bitboard occupied) noexcept {
+    instrument::count(instrument::Counter::AttackQueries);
+    const Bitboard queens = board.pieces(PieceType::Queen);
+    return (pawnAttacks(Color::White, index) & board.pieces(PieceType::Pawn, Color::Black)) |
+           (pawnAttacks(Color::Black, index) & board.pieces(PieceType::Pawn, Color::White)) |
+           (knightAttacks(index) & board.pieces(PieceType::Knight)) |
+           (kingAttacks(index) & board.pieces(PieceType::King)) |
+           (bishopAttacks(index, occupied) & (board.pieces(PieceType::Bishop) | queens)) |
+           (rookAttacks(index, occupied) & (board.pieces(PieceType::Rook) | queens));
 }
 
-[[nodiscard]] bool isAttackedByPawn(const Board& board, Square target, Color attacker) noexcept {
-    const int pawn_direction = (attacker == Color::White) ? -1 : 1;
-    const std::array<std::pair<int, int>, 2> offsets = {{{pawn_direction, -1}, {pawn_direction, 1}}};
-    
-    for (auto [dr, df] : offsets) {
-        Square sq{target.rank + dr, target.file + df};
-        if (!sq.isValid()) continue;
-        
-        const auto& piece = board.at(sq);
-        if (piece && piece->type == PieceType::Pawn && piece->color == attacker) {
-            return true;
-        }
-    }
-    return false;
+[[nodiscard]] bool isSquareAttacked(const Board& board, Square target, Color attacker) noexcept {
+    return (attackersTo(board, toIndex(target), board.occupied()) & board.pieces(attacker)) != 0;
 }
 
-[[nodiscard]] bool isAttackedByKnight(const Board& board, Square target, Color attacker) noexcept {
-    for (auto [dr, df] : kKnightMoves) {
-        Square sq{target.rank + dr, target.file + df};
-        if (!sq.isValid()) continue;
-        
-        const auto& piece = board.at(sq);
-        if (piece && piece->type == PieceType::Knight && piece->color == attacker) {
-            return true;
+// ============================================================================
+// Position Analysis
+// ============================================================================
+
+/// Per-position facts computed once and shared by all piece generators.
+struct MoveContext {
+    const Board& board;
+    Color side;
+    int king;
+    Bitboard own;
+    Bitboard enemies;
+    Bitboard occupied;
+    Bitboard checkers;
+    Bitboard pinned;
+    /// Destinations that resolve any check: everything not own when not in
+    /// check, the checker or the interposition squares in single check.
+    Bitboard evasion_mask;
+};
+
+/// Own pieces that are the sole blocker between their king and an enemy slider.
+[[nodiscard]] Bitboard pinnedPieces(const Board& board, Color side, int king) noexcept {
+    const Color enemy = opponent(side);
+    const Bitboard queens = board.pieces(PieceType::Queen, enemy);
+    Bitboard snipers =
+        (rookAttacks(king, kEmptyBitboard) & (board.pieces(PieceType::Rook, enemy) | queens)) |
+        (bishopAttacks(king, kEmptyBitboard) & (board.pieces(PieceType::Bishop, enemy) | queens));
+
+    Bitboard pinned = kEmptyBitboard;
+    while (snipers) {
+        const Bitboard blockers = betweenBits(king, popLsb(snipers)) & board.occupied();
+        if (popCount(blockers) == 1) {
+            pinned |= blockers & board.pieces(side);
         }
     }
-    return false;
+    return pinned;
 }
 
-[[nodiscard]] bool isAttackedBySlider(const Board& board, Square target, Color attacker) noexcept {
-    for (std::size_t i = 0; i < kAllDirections.size(); ++i) {
-        auto [dr, df] = kAllDirections[i];
-        const bool is_diagonal = (i >= 4);
-        
-        int r = target.rank + dr;
-        int f = target.file + df;
-        int distance = 1;
-        
-        while (isValidSquare(r, f)) {
-            const auto& piece = board.at(Square{r, f});
-            if (piece) {
-                if (piece->color == attacker) {
-                    // King can attack from distance 1
-                    if (distance == 1 && piece->type == PieceType::King) return true;
-                    // Rook/Queen for orthogonal, Bishop/Queen for diagonal
-                    if (!is_diagonal && (piece->type == PieceType::Rook || piece->type == PieceType::Queen)) return true;
-                    if (is_diagonal && (piece->type == PieceType::Bishop || piece->type == PieceType::Queen)) return true;
-                }
-                break; // Blocked by piece
-            }
-            ++distance;
-            r += dr;
-            f += df;
-        }
+[[nodiscard]] MoveContext analyze(const Board& board, Color side) noexcept {
+    const int king = board.kingSquare(side);
+    const Bitboard own = board.pieces(side);
+    const Bitboard enemies = board.pieces(opponent(side));
+    const Bitboard occupied = board.occupied();
+    const Bitboard checkers = attackersTo(board, king, occupied) & enemies;
+
+    Bitboard evasion_mask = ~own;
+    if (checkers) {
+        evasion_mask = checkers | betweenBits(king, lsbIndex(checkers));
     }
-    return false;
+
+    return MoveContext{
+        .board = board,
+        .side = side,
+        .king = king,
+        .own = own,
+        .enemies = enemies,
+        .occupied = occupied,
+        .checkers = checkers,
+        .pinned = pinnedPieces(board, side, king),
+        .evasion_mask = evasion_mask
+    };
 }
 
-[[nodiscard]] bool isSquareAttacked(const Board& board, Square target, Color attacker) noexcept {
-    return isAttackedByPawn(board, target, attacker) ||
-           isAttackedByKnight(board, target, attacker) ||
-           isAttackedBySlider(board, target, attacker);
+/// Destinations allowed for the piece on `from`: pinned pieces may only
+/// slide along the pin ray.
+[[nodiscard]] Bitboard allowedTargets(const MoveContext& ctx, int from) noexcept {
+    return contains(ctx.pinned, from) ? ctx.evasion_mask & lineBits(ctx.king, from)
+                                      : ctx.evasion_mask;
 }
 
 // ============================================================================
 // Move Generation Helpers
 // ============================================================================
 
-[[nodiscard]] bool isMoveLegal(const Board& board, const Move& move, Color side) {
-    Board copy = board;
-    copy.movePiece(move);
-    
-    // Handle en-passant capture
-    if (move.en_passant) {
-        Square captured{move.from.rank, move.to.file};
-        copy.clearSquare(captured);
-    }
-    
-    auto king_sq = findKing(copy, side);
-    if (!king_sq) return false;
-    
-    return !isSquareAttacked(copy, *king_sq, opponent(side));
+void addMove(MoveList& moves, int from, int to) {
+    moves.push_back(Move{.from = toSquare(from), .to = toSquare(to)});
 }
 
-void addMoveIfLegal(std::vector<Move>& moves, const Board& board, 
-                    Square from, Square to, Color side) {
-    Move move{.from = from, .to = to};
-    if (isMoveLegal(board, move, side)) {
-        moves.push_back(move);
+/// Queen first so that callers matching only from/to (the UI) auto-queen.
+constexpr std::array<PieceType, 4> kPromotionOrder = {
+    PieceType::Queen, PieceType::Rook, PieceType::Bishop, PieceType::Knight
+};
+
+void addPawnMove(MoveList& moves, int from, int to) {
+    const int to_rank = toSquare(to).rank;
+    if (to_rank == 0 || to_rank == Board::kSize - 1) {
+        for (PieceType promotion : kPromotionOrder) {
+            moves.push_back(Move{
+                .from = toSquare(from),
+                .to = toSquare(to),
+                .promotion = promotion
+            });
+        }
+    } else {
+        addMove(moves, from, to);
     }
 }
 
-void generatePawnMoves(std::vector<Move>& moves, const Board& board, 
-                       Square from, Color side, const std::optional<Move>& last_move) {
-    const int forward = (side == Color::White) ? -1 : 1;
-    const int start_rank = (side == Color::White) ? 6 : 1;
-    const Color enemy = opponent(side);
-    
-    // Single push
-    Square one{from.rank + forward, from.file};
-    if (one.isValid() && !board.hasPieceAt(one)) {
-        addMoveIfLegal(moves, board, from, one, side);
-        
-        // Double push from starting position
-        Square two{from.rank + 2 * forward, from.file};
-        if (from.rank == start_rank && two.isValid() && !board.hasPieceAt(two)) {
-            addMoveIfLegal(moves, board, from, two, side);
+/// En-passant removes two pieces from one rank, which can expose the king
+/// along that rank even when neither pawn is pinned, so it is verified by
+/// recomputing attacks on the post-capture occupancy.
+[[nodiscard]] bool isEnPassantLegal(const MoveContext& ctx, int from, int to, int victim) noexcept {
+    const Bitboard occupied =
+        (ctx.occupied ^ squareBit(from) ^ squareBit(victim)) | squareBit(to);
+    const Bitboard enemies = ctx.enemies & ~squareBit(victim);
+    return (attackersTo(ctx.board, ctx.king, occupied) & enemies) == 0;
+}
+
+void generatePawnMoves(MoveList& moves, const MoveContext& ctx) {
+    const Board& board = ctx.board;
+    const int forward = (ctx.side == Color::White) ? -Board::kSize : Board::kSize;
+    const int start_rank = (ctx.side == Color::White) ? 6 : 1;
+    const auto ep = board.enPassantSquare();
+
+    Bitboard pawns = board.pieces(PieceType::Pawn, ctx.side);
+    while (pawns) {
+        const int from = popLsb(pawns);
+        const Bitboard allowed = allowedTargets(ctx, from);
+
+        // Pushes
+        Bitboard targets = kEmptyBitboard;
+        const int one = from + forward;
+        if (!contains(ctx.occupied, one)) {
+            targets |= squareBit(one);
+            const int two = one + forward;
+            if (toSquare(from).rank == start_rank && !contains(ctx.occupied, two)) {
+                targets |= squareBit(two);
+            }
         }
-    }
-    
-    // Captures
-    for (int df : {-1, 1}) {
-        Square cap{from.rank + forward, from.file + df};
-        if (!cap.isValid()) continue;
-        
-        if (board.hasPieceAt(cap, enemy)) {
-            addMoveIfLegal(moves, board, from, cap, side);
+
+        // Captures
+        targets |= pawnAttacks(ctx.side, from) & ctx.enemies;
+
+        for (targets &= allowed; targets;) {
+            addPawnMove(moves, from, popLsb(targets));
         }
-    }
-    
-    // En-passant
-    if (last_move) {
-        const auto& lm = *last_move;
-        if (const auto& moved_piece = board.at(lm.to)) {
-            // Check if last move was a double pawn push by opponent
-            if (moved_piece->type == PieceType::Pawn && 
-                moved_piece->color == enemy &&
-                std::abs(lm.from.rank - lm.to.rank) == 2) {
-                
-                // Check if our pawn is adjacent
-                if (from.rank == lm.to.rank && std::abs(from.file - lm.to.file) == 1) {
-                    int passed_rank = (lm.from.rank + lm.to.rank) / 2;
-                    Move ep_move{
-                        .from = from, 
-                        .to = Square{passed_rank, lm.to.file},
-                        .en_passant = true
-                    };
-                    if (isMoveLegal(board, ep_move, side)) {
-                        moves.push_back(ep_move);
-                    }
-                }
+
+        // En-passant
+        if (ep && (pawnAttacks(ctx.side, from) & squareBit(*ep))) {
+            const int to = toIndex(*ep);
+            const int victim = toIndex(Square{toSquare(from).rank, ep->file});
+            if (isEnPassantLegal(ctx, from, to, victim)) {
+                moves.push_back(Move{
+                    .from = toSquare(from),
+                    .to = *ep,
+                    .en_passant = true
+                });
             }
         }
     }
 }
 
-void generateKnightMoves(std::vector<Move>& moves, const Board& board,
-                         Square from, Color side) {
-    for (auto [dr, df] : kKnightMoves) {
-        Square to{from.rank + dr, from.file + df};
-        if (!to.isValid()) continue;
-        if (board.hasPieceAt(to, side)) continue;
-        
-        addMoveIfLegal(moves, board, from, to, side);
-    }
-}
+void generatePieceMoves(MoveList& moves, const MoveContext& ctx, PieceType type) {
+    Bitboard pieces = ctx.board.pieces(type, ctx.side);
+    while (pieces) {
+        const int from = popLsb(pieces);
 
-void generateSlidingMoves(std::vector<Move>& moves, const Board& board,
-                          Square from, Color side,
-                          std::span<const std::pair<int, int>> directions) {
-    for (auto [dr, df] : directions) {
-        int r = from.rank + dr;
-        int f = from.file + df;
-        
-        while (isValidSquare(r, f)) {
-            Square to{r, f};
-            const auto& dest = board.at(to);
-            
-            if (dest) {
-                if (dest->color != side) {
-                    addMoveIfLegal(moves, board, from, to, side);
-                }
-                break; // Blocked
-            }
-            
-            addMoveIfLegal(moves, board, from, to, side);
-            r += dr;
-            f += df;
+        Bitboard attacks = kEmptyBitboard;
+        switch (type) {
+            case PieceType::Knight: attacks = knightAttacks(from); break;
+            case PieceType::Bishop: attacks = bishopAttacks(from, ctx.occupied); break;
+            case PieceType::Rook:   attacks = rookAttacks(from, ctx.occupied); break;
+            case PieceType::Queen:  attacks = queenAttacks(from, ctx.occupied); break;
+            default: break;
         }
-    }
-}
 
-void generateKingMoves(std::vector<Move>& moves, const Board& board,
-                       Square from, Color side,
-                       const std::array<bool, 4>& castling_rights) {
-    const Color enemy = opponent(side);
-    
-    // Normal king moves
-    for (int dr = -1; dr <= 1; ++dr) {
-        for (int df = -1; df <= 1; ++df) {
-            if (dr == 0 && df == 0) continue;
-            
-            Square to{from.rank + dr, from.file + df};
-            if (!to.isValid()) continue;
-            if (board.hasPieceAt(to, side)) continue;
-            
-            addMoveIfLegal(moves, board, from, to, side);
+        for (Bitboard targets = attacks & allowedTargets(ctx, from); targets;) {
+            addMove(moves, from, popLsb(targets));
         }
     }
-    
-    // Castling
-    const int home_rank = (side == Color::White) ? 7 : 0;
-    const int king_file = 4;
-    
+}
+
+void generateCastling(MoveList& moves, const MoveContext& ctx) {
+    const Board& board = ctx.board;
+    const Color enemy = opponent(ctx.side);
+    const int home_rank = (ctx.side == Color::White) ? 7 : 0;
+    const Square king_home{home_rank, 4};
+
     // Only consider if king is on home square and not in check
-    if (from.rank != home_rank || from.file != king_file) return;
-    if (isSquareAttacked(board, from, enemy)) return;
-    
-    const bool kingside = (side == Color::White) ? castling_rights[0] : castling_rights[2];
-    const bool queenside = (side == Color::White) ? castling_rights[1] : castling_rights[3];
-    
-    // Kingside castling
-    if (kingside) {
-        const auto& rook = board.at(Square{home_rank, 7});
-        if (rook && rook->type == PieceType::Rook && rook->color == side) {
-            if (!board.hasPieceAt(Square{home_rank, 5}) && 
-                !board.hasPieceAt(Square{home_rank, 6})) {
-                if (!isSquareAttacked(board, Square{home_rank, 5}, enemy) &&
-                    !isSquareAttacked(board, Square{home_rank, 6}, enemy)) {
-                    Move castle{
-                        .from = from, 
-                        .to = Square{home_rank, 6},
-                        .castling = true
-                    };
-                    if (isMoveLegal(board, castle, side)) {
-                        moves.push_back(castle);
-                    }
-                }
-            }
+    if (ctx.king != toIndex(king_home) || ctx.checkers) return;
+
+    const auto& castling_rights = board.castlingRights();
+    const bool kingside = (ctx.side == Color::White) ? castling_rights[0] : castling_rights[2];
+    const bool queenside = (ctx.side == Color::White) ? castling_rights[1] : castling_rights[3];
+
+    auto tryCastle = [&](int rook_file, Bitboard path, std::array<int, 2> transit, int king_file) {
+        const auto& rook = board.at(Square{home_rank, rook_file});
+        if (!rook || rook->type != PieceType::Rook || rook->color != ctx.side) return;
+        if (ctx.occupied & path) return;
+        for (int file : transit) {
+            if (isSquareAttacked(board, Square{home_rank, file}, enemy)) return;
         }
+        moves.push_back(Move{
+            .from = king_home,
+            .to = Square{home_rank, king_file},
+            .castling = true
+        });
+    };
+
+    if (kingside) {
+        tryCastle(7, betweenBits(ctx.king, toIndex({home_rank, 7})), {5, 6}, 6);
     }
-    
-    // Queenside castling
     if (queenside) {
-        const auto& rook = board.at(Square{home_rank, 0});
-        if (rook && rook->type == PieceType::Rook && rook->color == side) {
-            if (!board.hasPieceAt(Square{home_rank, 1}) &&
-                !board.hasPieceAt(Square{home_rank, 2}) &&
-                !board.hasPieceAt(Square{home_rank, 3})) {
-                if (!isSquareAttacked(board, Square{home_rank, 2}, enemy) &&
-                    !isSquareAttacked(board, Square{home_rank, 3}, enemy)) {
-                    Move castle{
-                        .from = from, 
-                        .to = Square{home_rank, 2},
-                        .castling = true
-                    };
-                    if (isMoveLegal(board, castle, side)) {
-                        moves.push_back(castle);
-                    }
-                }
-            }
+        tryCastle(0, betweenBits(ctx.king, toIndex({home_rank, 0})), {3, 2}, 2);
+    }
+}
+
+void generateKingMoves(MoveList& moves, const MoveContext& ctx) {
+    // The king itself is lifted from the occupancy so that sliders checking
+    // it also cover the squares directly behind it.
+    const Bitboard occupied = ctx.occupied ^ squareBit(ctx.king);
+    for (Bitboard targets = kingAttacks(ctx.king) & ~ctx.own; targets;) {
+        const int to = popLsb(targets);
+        if ((attackersTo(ctx.board, to, occupied) & ctx.enemies) == 0) {
+            addMove(moves, ctx.king, to);
         }
     }
+    generateCastling(moves, ctx);
+}
+
+void generateLegalMoves(const Board& board, Color side, MoveList& moves) {
+    moves.clear();
+    if (!board.pieces(PieceType::King, side)) return;
+
+    const MoveContext ctx = analyze(board, side);
+    generateKingMoves(moves, ctx);
+
+    // In double check only the king may move
+    if (popCount(ctx.checkers) > 1) return;
+
+    generatePawnMoves(moves, ctx);
+    for (PieceType type : {PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen}) {
+        generatePieceMoves(moves, ctx, type);
+    }
 }
 
 } // namespace
@@ -307,64 +273,35 @@ void generateKingMoves(std::vector<Move>& moves, const Board& board,
 // Rules Public Interface
 // ============================================================================
 
-std::vector<Move> Rules::legalMoves(const Board& board, Color side,
-                                    const std::optional<Move>& last_move,
-                                    const std::array<bool, 4>& castling_rights) const {
-    std::vector<Move> moves;
-    moves.reserve(64); // Reasonable initial capacity
-    
-    for (int r = 0; r < Board::kSize; ++r) {
-        for (int f = 0; f < Board::kSize; ++f) {
-            Square from{r, f};
-            const auto& piece = board.at(from);
-            if (!piece || piece->color != side) continue;
-            
-            switch (piece->type) {
-                case PieceType::Pawn:
-                    generatePawnMoves(moves, board, from, side, last_move);
-                    break;
-                    
-                case PieceType::Knight:
-                    generateKnightMoves(moves, board, from, side);
-                    break;
-                    
-                case PieceType::Bishop:
-                    generateSlidingMoves(moves, board, from, side, kBishopDirections);
-                    break;
-                    
-                case PieceType::Rook:
-                    generateSlidingMoves(moves, board, from, side, kRookDirections);
-                    break;
-                    
-                case PieceType::Queen:
-                    generateSlidingMoves(moves, board, from, side, kAllDirections);
-                    break;
-                    
-                case PieceType::King:
-                    generateKingMoves(moves, board, from, side, castling_rights);
-                    break;
-            }
-        }
-    }
-    
-    return moves;
+void Rules::legalMoves(const Board& board, Color side, MoveList& moves) const {
+    const instrument::ScopedTimer timer{instrument::Timer::RulesLegalMoves};
+    instrument::count(instrument::Counter::LegalMoveGenerations);
+    generateLegalMoves(board, side, moves);
+    instrument::count(instrument::Counter::MovesGenerated, moves.size());
+}
+
+std::vector<Move> Rules::legalMoves(const Board& board, Color side) const {
+    MoveList moves;
+    legalMoves(board, side, moves);
+    return {moves.begin(), moves.end()};
 }
 
 bool Rules::isCheck(const Board& board, Color side) const {
-    auto king_sq = findKing(board, side);
-    return king_sq && isSquareAttacked(board, *king_sq, opponent(side));
+    instrument::count(instrument::Counter::CheckTests);
+    return board.pieces(PieceType::King, side) &&
+           isSquareAttacked(board, toSquare(board.kingSquare(side)), opponent(side));
 }
 
-bool Rules::isCheckmate(const Board& board, Color side,
-                        const std::optional<Move>& last_move,
-                        const std::array<bool, 4>& castling_rights) const {
-    return isCheck(board, side) && legalMoves(board, side, last_move, castling_rights).empty();
+bool Rules::isCheckmate(const Board& board, Color side) const {
+    MoveList moves;
+    legalMoves(board, side, moves);
+    return moves.empty() && isCheck(board, side);
 }
 
-bool Rules::isStalemate(const Board& board, Color side,
-                        const std::optional<Move>& last_move,
-                        const std::array<bool, 4>& castling_rights) const {
-    return !isCheck(board, side) && legalMoves(board, side, last_move, castling_rights).empty();
+bool Rules::isStalemate(const Board& board, Color side) const {
+    MoveList moves;
+    legalMoves(board, side, moves);
+    return moves.empty() && !isCheck(board, side);
 }
 
 } // namespace chess
@@ -1,8 +1,7 @@
 ﻿#pragma once
-#include <array>
-#include <optional>
 #include <vector>
 #include "Board.hpp"
+#include "MoveList.hpp"
 
 namespace chess {
 
@@ -14,38 +13,26 @@ namespace chess {
 /// - Special moves (castling, en-passant)
 class Rules {
 public:
-    /// Castling rights array indices.
-    /// Order: [WhiteKingside, WhiteQueenside, BlackKingside, BlackQueenside]
-    using CastlingRights = std::array<bool, 4>;
+    /// Castling rights array indices (kept here for existing callers).
+    using CastlingRights = chess::CastlingRights;
     
-    /// Generate all legal moves for the given position.
-    /// @param board Current board state
+    /// Generate all legal moves for the given position into a caller-provided list.
+    /// @param board Current board state, including castling rights and en-passant square
     /// @param side Color to move
-    /// @param last_move Previous move (for en-passant detection)
-    /// @param castling_rights Current castling availability
-    /// @return Vector of legal moves
-    [[nodiscard]] std::vector<Move> legalMoves(
-        const Board& board, 
-        Color side,
-        const std::optional<Move>& last_move,
-        const CastlingRights& castling_rights) const;
+    /// @param moves Cleared, then filled with the legal moves; never allocates
+    void legalMoves(const Board& board, Color side, MoveList& moves) const;
+
+    /// Convenience wrapper returning the legal moves as a vector (for the UI).
+    [[nodiscard]] std::vector<Move> legalMoves(const Board& board, Color side) const;
     
     /// Check if the given side's king is in check.
     [[nodiscard]] bool isCheck(const Board& board, Color side) const;
     
     /// Check if position is checkmate (king in check with no legal moves).
-    [[nodiscard]] bool isCheckmate(
-        const Board& board, 
-        Color side,
-        const std::optional<Move>& last_move,
-        const CastlingRights& castling_rights) const;
+    [[nodiscard]] bool isCheckmate(const Board& board, Color side) const;
     
     /// Check if position is stalemate (not in check but no legal moves).
-    [[nodiscard]] bool isStalemate(
-        const Board& board, 
-        Color side,
-        const std::optional<Move>& last_move,
-        const CastlingRights& castling_rights) const;
+    [[nodiscard]] bool isStalemate(const Board& board, Color side) const;
 };
 
 } // namespace chess
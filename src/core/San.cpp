@@ -0,0 +1,108 @@
+#include "San.hpp"
+
+namespace chess {
+
+namespace {
+
+[[nodiscard]] std::optional<PieceType> pieceFromLetter(char c) noexcept {
+    switch (c) {
+        case 'N': return PieceType::Knight;
+        case 'B': return PieceType::Bishop;
+        case 'R': return PieceType::Rook;
+        case 'Q': return PieceType::Queen;
+        case 'K': return PieceType::King;
+        default:  return std::nullopt;
+    }
+}
+
+[[nodiscard]] constexpr bool isFileChar(char c) noexcept { return c >= 'a' && c <= 'h'; }
+[[nodiscard]] constexpr bool isRankChar(char c) noexcept { return c >= '1' && c <= '8'; }
+
+/// Drop trailing check/mate marks and move annotations.
+[[nodiscard]] std::string_view stripSuffixes(std::string_view san) noexcept {
+    while (!san.empty() && std::string_view{"+#!?"}.find(san.back()) != std::string_view::npos) {
+        san.remove_suffix(1);
+    }
+    return san;
+}
+
+/// Castling side of "O-O"/"O-O-O" (or with zeros), as the king's target file.
+[[nodiscard]] std::optional<int> castlingFile(std::string_view san) noexcept {
+    if (san == "O-O" || san == "0-0") return 6;
+    if (san == "O-O-O" || san == "0-0-0") return 2;
+    return std::nullopt;
+}
+
+/// The unique move satisfying `matches`, or nullopt if none or several do.
+template <typename Predicate>
+[[nodiscard]] std::optional<Move> uniqueMatch(std::span<const Move> moves, Predicate matches) noexcept {
+    std::optional<Move> found;
+    for (const Move& move : moves) {
+        if (!matches(move)) continue;
+        if (found) return std::nullopt;
+        found = move;
+    }
+    return found;
+}
+
+} // namespace
+
+std::optional<Move> parseSan(const Board& board, std::span<const Move> legal_moves,
+                             std::string_view san) noexcept {
+    san = stripSuffixes(san);
+
+    if (const auto king_file = castlingFile(san)) {
+        return uniqueMatch(legal_moves, [&](const Move& move) {
+            return move.castling && move.to.file == *king_file;
+        });
+    }
+
+    // Piece letter (pawn moves have none)
+    PieceType piece = PieceType::Pawn;
+    if (!san.empty()) {
+        if (const auto type = pieceFromLetter(san.front())) {
+            piece = *type;
+            san.remove_prefix(1);
+        }
+    }
+
+    // Promotion suffix, with or without '='
+    std::optional<PieceType> promotion;
+    if (piece == PieceType::Pawn && !san.empty()) {
+        if (const auto type = pieceFromLetter(san.back()); type && *type != PieceType::King) {
+            promotion = type;
+            san.remove_suffix(1);
+            if (!san.empty() && san.back() == '=') san.remove_suffix(1);
+        }
+    }
+
+    // Destination square
+    if (san.size() < 2 || !isFileChar(san[san.size() - 2]) || !isRankChar(san.back())) {
+        return std::nullopt;
+    }
+    const Square to{.rank = '8' - san.back(), .file = san[san.size() - 2] - 'a'};
+    san.remove_suffix(2);
+
+    // Disambiguation: origin file and/or rank, then capture or long-form marks
+    std::optional<int> from_file;
+    std::optional<int> from_rank;
+    for (const char c : san) {
+        if (isFileChar(c) && !from_file) {
+            from_file = c - 'a';
+        } else if (isRankChar(c) && !from_rank) {
+            from_rank = '8' - c;
+        } else if (c != 'x' && c != ':' && c != '-') {
+            return std::nullopt;
+        }
+    }
+
+    return uniqueMatch(legal_moves, [&](const Move& move) {
+        const auto& moving = board.at(move.from);
+        return move.to == to && moving && moving->type == piece && !move.castling &&
+               move.promotion == promotion &&
+               (!from_file || move.from.file == *from_file) &&
+               (!from_rank || move.from.rank == *from_rank);
+    });
+}
+
+} // namespace chess
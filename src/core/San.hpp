@@ -0,0 +1,24 @@
+#pragma once
+#include <optional>
+#include <span>
+#include <string_view>
+#include "Board.hpp"
+#include "Move.hpp"
+
+/// @file San.hpp
+/// @brief Standard Algebraic Notation (SAN) move parsing.
+
+namespace chess {
+
+/// Find the legal move written in SAN, e.g. "Nbd7", "exd6", "e8=Q+", "O-O".
+///
+/// Resolves the text against the position's legal moves, so only as much
+/// disambiguation as SAN requires is needed; redundant disambiguation,
+/// check/mate marks and annotations ("!?") are accepted, as are "0-0"
+/// castling and promotions written without '='.
+/// @param legal_moves All legal moves of the side to move in `board`
+/// @return nullopt if the text is malformed, matches no legal move or is ambiguous
+[[nodiscard]] std::optional<Move> parseSan(const Board& board, std::span<const Move> legal_moves,
+                                           std::string_view san) noexcept;
+
+} // namespace chess
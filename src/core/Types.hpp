@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <cstdint>
 #include <string_view>
 
@@ -59,6 +60,10 @@ struct Piece {
     [[nodiscard]] constexpr bool operator==(const Piece&) const noexcept = default;
 };
 
+/// Castling rights array indices.
+/// Order: [WhiteKingside, WhiteQueenside, BlackKingside, BlackQueenside]
+using CastlingRights = std::array<bool, 4>;
+
 // ============================================================================
 // Utility Functions
 // ============================================================================
@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Types.hpp"
+
+/// @file Zobrist.hpp
+/// @brief Zobrist hashing keys for position identification.
+///
+/// Keys are generated at compile time from a fixed seed, so hashes are stable
+/// across runs and builds (required for on-disk caches and books).
+
+namespace chess::zobrist {
+
+using Key = std::uint64_t;
+
+namespace detail {
+
+inline constexpr int kSquares = kBoardSize * kBoardSize;
+
+struct KeyTables {
+    std::array<std::array<std::array<Key, kSquares>, 6>, 2> pieces{};
+    std::array<Key, 4> castling{};
+    std::array<Key, kBoardSize> en_passant_file{};
+    Key black_to_move{};
+};
+
+/// SplitMix64: small, well-distributed and constexpr-friendly.
+[[nodiscard]] constexpr Key splitMix64(Key& state) noexcept {
+    Key z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+inline constexpr KeyTables kTables = [] {
+    KeyTables tables;
+    Key state = 0x2545F4914F6CDD1DULL;
+    for (auto& color : tables.pieces) {
+        for (auto& type : color) {
+            for (auto& key : type) key = splitMix64(state);
+        }
+    }
+    for (auto& key : tables.castling) key = splitMix64(state);
+    for (auto& key : tables.en_passant_file) key = splitMix64(state);
+    tables.black_to_move = splitMix64(state);
+    return tables;
+}();
+
+} // namespace detail
+
+/// Key for a piece standing on a 0..63 square index.
+[[nodiscard]] constexpr Key pieceKey(Piece piece, int index) noexcept {
+    return detail::kTables.pieces[static_cast<std::size_t>(piece.color)]
+                                 [static_cast<std::size_t>(piece.type)][index];
+}
+
+/// Combined key of all granted castling rights.
+[[nodiscard]] constexpr Key castlingKey(const CastlingRights& rights) noexcept {
+    Key key = 0;
+    for (std::size_t i = 0; i < rights.size(); ++i) {
+        if (rights[i]) key ^= detail::kTables.castling[i];
+    }
+    return key;
+}
+
+/// Key for an en-passant square on the given file.
+[[nodiscard]] constexpr Key enPassantKey(int file) noexcept {
+    return detail::kTables.en_passant_file[file];
+}
+
+/// Key toggled when Black is to move.
+[[nodiscard]] constexpr Key sideKey(Color side) noexcept {
+    return (side == Color::Black) ? detail::kTables.black_to_move : 0;
+}
+
+} // namespace chess::zobrist
@@ -0,0 +1,105 @@
+#include "AsyncEngine.hpp"
+#include <utility>
+
+namespace engine {
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+AsyncEngine::AsyncEngine(std::size_t hash_mb, int threads)
+    : engine_(hash_mb, threads),
+      worker_([this](std::stop_token shutdown) { workerLoop(std::move(shutdown)); }) {}
+
+AsyncEngine::~AsyncEngine() {
+    cancel();
+    // worker_ is destroyed first: its destructor requests shutdown and joins
+}
+
+// ============================================================================
+// Owning Thread
+// ============================================================================
+
+std::uint64_t AsyncEngine::start(const chess::Board& board, chess::Color side,
+                                 const SearchLimits& limits, GameHistory game_history,
+                                 int halfmove_clock) {
+    current_id_ = ++next_id_;
+    Request request{
+        .id = current_id_,
+        .board = board,
+        .side = side,
+        .limits = limits,
+        .game_history = {game_history.begin(), game_history.end()},
+        .halfmove_clock = halfmove_clock,
+    };
+    {
+        std::scoped_lock lock(mutex_);
+        active_search_.request_stop();
+        pending_ = std::move(request);
+    }
+    wake_.notify_one();
+    return current_id_;
+}
+
+void AsyncEngine::cancel() {
+    current_id_ = 0;
+    std::scoped_lock lock(mutex_);
+    pending_.reset();
+    active_search_.request_stop();
+}
+
+std::optional<EngineUpdate> AsyncEngine::poll() {
+    while (auto update = updates_.tryPop()) {
+        if (update->search_id == current_id_) {
+            return update;
+        }
+        // Left over from a cancelled or superseded search
+    }
+    return std::nullopt;
+}
+
+// ============================================================================
+// Worker Thread
+// ============================================================================
+
+void AsyncEngine::workerLoop(std::stop_token shutdown) {
+    while (true) {
+        std::optional<Request> request;
+        std::stop_token cancel;
+        {
+            std::unique_lock lock(mutex_);
+            if (!wake_.wait(lock, shutdown, [this] { return pending_.has_value(); })) {
+                return;
+            }
+            request = std::move(pending_);
+            pending_.reset();
+            active_search_ = std::stop_source{};
+            cancel = active_search_.get_token();
+        }
+
+        const std::uint64_t id = request->id;
+        const auto on_iteration = [&](const SearchInfo& info) {
+            // Progress is best-effort: drop it rather than stall the search
+            EngineUpdate update{.kind = EngineUpdate::Kind::Info, .search_id = id, .info = info};
+            static_cast<void>(updates_.tryPush(std::move(update)));
+        };
+
+        SearchResult result =
+            engine_.search(request->board, request->side, request->limits, on_iteration, cancel,
+                           request->game_history, request->halfmove_clock);
+
+        EngineUpdate final_update{
+            .kind = EngineUpdate::Kind::BestMove,
+            .search_id = id,
+            .info = std::move(result.info),
+            .best_move = result.best_move,
+        };
+        // The result must arrive, so wait for the consumer to make room;
+        // nobody is waiting for a cancelled search
+        while (!cancel.stop_requested() && !updates_.tryPush(std::move(final_update))) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace engine
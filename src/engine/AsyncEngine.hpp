@@ -0,0 +1,96 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+#include "Engine.hpp"
+#include "SpscQueue.hpp"
+
+/// @file AsyncEngine.hpp
+/// @brief Engine running on a worker thread, for callers that must not block.
+
+namespace engine {
+
+/// Progress or result of a background search.
+struct EngineUpdate {
+    enum class Kind : std::uint8_t {
+        Info,     ///< An iteration completed; info holds its PV
+        BestMove  ///< The search finished; info is the final report
+    };
+
+    Kind kind{Kind::Info};
+    std::uint64_t search_id{0};
+    SearchInfo info;
+    /// Set for BestMove unless the position had no legal moves.
+    std::optional<chess::Move> best_move{};
+};
+
+/// Runs Engine searches on a dedicated worker thread.
+///
+/// The owning thread (e.g. a UI frame loop) starts and cancels searches and
+/// drains updates with poll(), which never blocks. Updates travel through a
+/// lock-free single-producer/single-consumer queue; only starting a search
+/// takes a lock, briefly, to hand over the position.
+///
+/// @note start(), cancel() and poll() must all be called from the same thread.
+class AsyncEngine {
+public:
+    explicit AsyncEngine(std::size_t hash_mb = TranspositionTable::kDefaultSizeMb,
+                         int threads = 1);
+
+    /// Cancels any running search and joins the worker.
+    ~AsyncEngine();
+
+    AsyncEngine(const AsyncEngine&) = delete;
+    AsyncEngine& operator=(const AsyncEngine&) = delete;
+    AsyncEngine(AsyncEngine&&) = delete;
+    AsyncEngine& operator=(AsyncEngine&&) = delete;
+
+    /// Search a position in the background, cancelling the current search.
+    /// @param game_history Positions before `board` (copied), see Engine::search()
+    /// @param halfmove_clock See Engine::search()
+    /// @return Id carried by every update of this search
+    std::uint64_t start(const chess::Board& board, chess::Color side, const SearchLimits& limits,
+                        GameHistory game_history = {}, int halfmove_clock = 0);
+
+    /// Stop the current search. Updates it has not delivered yet are discarded.
+    void cancel();
+
+    /// Next pending update of the current search, if any.
+    [[nodiscard]] std::optional<EngineUpdate> poll();
+
+private:
+    struct Request {
+        std::uint64_t id{0};
+        chess::Board board;
+        chess::Color side{chess::Color::White};
+        SearchLimits limits{};
+        std::vector<chess::zobrist::Key> game_history;
+        int halfmove_clock{0};
+    };
+
+    static constexpr std::size_t kQueueCapacity = 64;
+
+    void workerLoop(std::stop_token shutdown);
+
+    Engine engine_;
+
+    std::mutex mutex_;
+    std::condition_variable_any wake_;
+    std::optional<Request> pending_;   // Guarded by mutex_
+    std::stop_source active_search_;   // Guarded by mutex_
+
+    // Owning-thread only
+    std::uint64_t next_id_{0};
+    std::uint64_t current_id_{0};  // 0 = no search wanted
+
+    SpscQueue<EngineUpdate, kQueueCapacity> updates_;
+
+    std::jthread worker_;  // Last: starts after, and stops before, everything above
+};
+
+} // namespace engine
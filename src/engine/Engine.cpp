@@ -0,0 +1,152 @@
+#include "Engine.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+/// Rescale a main-thread report to the node count of all threads. The main
+/// thread's nps was measured over the same interval, so scaling it keeps the
+/// microsecond precision of the original measurement.
+void applyTotalNodes(SearchInfo& info, std::uint64_t total_nodes) noexcept {
+    if (info.nodes != 0) {
+        info.nps = static_cast<std::uint64_t>(static_cast<double>(info.nps) *
+                                              static_cast<double>(total_nodes) /
+                                              static_cast<double>(info.nodes));
+    }
+    info.nodes = total_nodes;
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+Engine::Engine(std::size_t hash_mb, int threads)
+    : tt_(hash_mb) {
+    setThreads(threads);
+}
+
+Engine::~Engine() = default;
+
+void Engine::setThreads(int count) {
+    const auto size = static_cast<std::size_t>(std::clamp(count, 1, kMaxThreads));
+
+    searches_.resize(std::min(searches_.size(), size));
+    while (searches_.size() < size) {
+        const int thread_id = static_cast<int>(searches_.size());
+        searches_.push_back(std::make_unique<Search>(tt_, stop_, thread_id));
+        searches_.back()->setTablebase(tablebase_.get());
+        searches_.back()->setNetwork(network_.get());
+    }
+}
+
+void Engine::setTablebase(std::shared_ptr<const Tablebase> tablebase) {
+    tablebase_ = std::move(tablebase);
+    for (const auto& search : searches_) {
+        search->setTablebase(tablebase_.get());
+    }
+}
+
+void Engine::setNetwork(std::shared_ptr<const nnue::Network> network) {
+    network_ = std::move(network);
+    for (const auto& search : searches_) {
+        search->setNetwork(network_.get());
+    }
+}
+
+// ============================================================================
+// Search
+// ============================================================================
+
+SearchResult Engine::search(const chess::Board& board, chess::Color side,
+                            const SearchLimits& limits, const InfoCallback& on_iteration,
+                            std::stop_token cancel, GameHistory game_history,
+                            int halfmove_clock) {
+    if (auto answer = probeRoot(board, side, halfmove_clock)) {
+        if (on_iteration) on_iteration(answer->info);
+        return *std::move(answer);
+    }
+
+    stop_.store(false, std::memory_order_relaxed);
+    // Runs immediately if cancellation was already requested
+    const std::stop_callback on_cancel(cancel, [this] { stop(); });
+    tt_.newSearch();
+    for (const auto& search : searches_) {
+        search->resetNodes();
+    }
+
+    // Helpers only obey the depth limit; the main thread stops them
+    SearchResult result;
+    {
+        std::vector<std::jthread> helpers;
+        helpers.reserve(searches_.size() - 1);
+        const SearchLimits helper_limits{.depth = limits.depth};
+        for (std::size_t i = 1; i < searches_.size(); ++i) {
+            helpers.emplace_back([&, i] {
+                static_cast<void>(searches_[i]->run(board, side, helper_limits, {}, game_history));
+            });
+        }
+
+        InfoCallback report;
+        if (on_iteration) {
+            report = [&](const SearchInfo& info) {
+                SearchInfo total = info;
+                applyTotalNodes(total, totalNodes());
+                total.hashfull = tt_.hashfull();
+                on_iteration(total);
+            };
+        }
+        result = searches_[0]->run(board, side, limits, report, game_history);
+
+        stop_.store(true, std::memory_order_relaxed);
+    } // Joins the helpers
+
+    applyTotalNodes(result.info, totalNodes());
+    result.info.hashfull = tt_.hashfull();
+    result.threads.reserve(searches_.size());
+    for (const auto& search : searches_) {
+        result.threads.push_back({.nodes = search->nodes(), .depth = search->completedDepth()});
+    }
+    return result;
+}
+
+std::optional<SearchResult> Engine::probeRoot(const chess::Board& board, chess::Color side,
+                                              int halfmove_clock) const {
+    if (!tablebase_ || !tablebase_->covers(board)) return std::nullopt;
+    const auto answer = tablebase_->probeRoot(board, side);
+    if (!answer) return std::nullopt;
+
+    // A win the fifty-move counter runs out on first is only a draw
+    constexpr int kFiftyMovePlies = 100;
+    Wdl wdl = answer->wdl;
+    const bool decisive = wdl == Wdl::Win || wdl == Wdl::Loss;
+    if (decisive && std::abs(answer->dtz) + std::max(halfmove_clock, 0) > kFiftyMovePlies) {
+        wdl = Wdl::Draw;
+    }
+
+    // Filled in field by field: GCC 12 warns about the nested initializer
+    // lists (a false -Wuse-after-free)
+    SearchResult result;
+    result.best_move = answer->move;
+    result.info.depth = 1;
+    result.info.score = tablebaseScore(wdl, 0);
+    result.info.pv.push_back(answer->move);
+    result.info.hashfull = tt_.hashfull();
+    result.threads.resize(searches_.size());
+    return result;
+}
+
+std::uint64_t Engine::totalNodes() const noexcept {
+    std::uint64_t total = 0;
+    for (const auto& search : searches_) {
+        total += search->nodes();
+    }
+    return total;
+}
+
+} // namespace engine
@@ -0,0 +1,107 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <vector>
+#include "Nnue.hpp"
+#include "Search.hpp"
+#include "Tablebase.hpp"
+#include "TranspositionTable.hpp"
+
+/// @file Engine.hpp
+/// @brief Move-selection front door: owns the hash table and the searchers.
+
+namespace engine {
+
+/// Chess engine: picks a move for a position within the given limits.
+///
+/// search() blocks the calling thread; any other thread may call stop() to
+/// make it return early with the best move found so far.
+///
+/// With more than one thread the search runs Lazy SMP: helper threads search
+/// the same root without coordination, sharing work only through the
+/// transposition table. The calling thread is the main searcher; it applies
+/// the limits, reports progress and chooses the move, then stops the helpers.
+///
+/// With a tablebase set, a root position it covers is answered by the
+/// tablebase without searching, and the searchers probe it below the root.
+class Engine {
+public:
+    static constexpr int kMaxThreads = 256;
+
+    explicit Engine(std::size_t hash_mb = TranspositionTable::kDefaultSizeMb, int threads = 1);
+
+    // The searcher keeps references to the table and stop flag
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+    Engine(Engine&&) = delete;
+    Engine& operator=(Engine&&) = delete;
+    ~Engine();
+
+    /// Search `board` with `side` to move.
+    /// @param on_iteration Invoked on the calling thread after each depth,
+    ///        with node counts summed over all threads
+    /// @param cancel Alternative to stop() that cannot be missed: a request
+    ///        made before the search starts still stops it
+    /// @param game_history Positions before `board`, for repetition detection
+    /// @param halfmove_clock Plies since the last capture or pawn move; a
+    ///        tablebase win at the root that the fifty-move rule cuts off is a draw
+    /// @note The node limit applies to the main thread only.
+    [[nodiscard]] SearchResult search(const chess::Board& board, chess::Color side,
+                                      const SearchLimits& limits,
+                                      const InfoCallback& on_iteration = {},
+                                      std::stop_token cancel = {},
+                                      GameHistory game_history = {}, int halfmove_clock = 0);
+
+    /// Ask a running search to return as soon as possible.
+    /// @note Thread-safe. Has no effect on a search started afterwards.
+    void stop() noexcept { stop_.store(true, std::memory_order_relaxed); }
+
+    /// Reallocate the transposition table (discards its contents).
+    /// @pre No search is running
+    void setHashSize(std::size_t size_mb) { tt_.resize(size_mb); }
+
+    /// Forget all previous search results, e.g. before a new game.
+    /// @pre No search is running
+    void clearHash() noexcept { tt_.clear(); }
+
+    /// Set the number of search threads, clamped to [1, kMaxThreads].
+    /// @pre No search is running
+    void setThreads(int count);
+
+    [[nodiscard]] int threads() const noexcept { return static_cast<int>(searches_.size()); }
+
+    /// Use `tablebase` for endgames, or stop probing if it is null.
+    /// @pre No search is running
+    void setTablebase(std::shared_ptr<const Tablebase> tablebase);
+
+    [[nodiscard]] const Tablebase* tablebase() const noexcept { return tablebase_.get(); }
+
+    /// Evaluate with `network`, or with the piece-square tables if it is null.
+    /// @pre No search is running
+    void setNetwork(std::shared_ptr<const nnue::Network> network);
+
+    [[nodiscard]] const nnue::Network* network() const noexcept { return network_.get(); }
+
+    [[nodiscard]] const TranspositionTable& hashTable() const noexcept { return tt_; }
+
+private:
+    [[nodiscard]] std::uint64_t totalNodes() const noexcept;
+
+    /// The tablebase's move for the root, if it covers the position.
+    [[nodiscard]] std::optional<SearchResult> probeRoot(const chess::Board& board,
+                                                        chess::Color side,
+                                                        int halfmove_clock) const;
+
+    TranspositionTable tt_;
+    std::shared_ptr<const Tablebase> tablebase_;
+    std::shared_ptr<const nnue::Network> network_;
+    std::atomic<bool> stop_{false};
+    // One searcher per thread, each with its own history and killers.
+    // Heap-allocated because of their large tables.
+    std::vector<std::unique_ptr<Search>> searches_;
+};
+
+} // namespace engine
@@ -0,0 +1,26 @@
+#pragma once
+#include "core/Board.hpp"
+#include "core/PieceSquareTables.hpp"
+
+/// @file Evaluator.hpp
+/// @brief Static position evaluation for the search.
+
+namespace engine {
+
+/// Tapered material + piece-square evaluation.
+///
+/// Board keeps the midgame/endgame sums and the game phase up to date in
+/// make/unmake, so evaluate() only blends two numbers: O(1) per leaf.
+class Evaluator {
+public:
+    /// Small bonus for having the move, damping odd/even iteration swings.
+    static constexpr int kTempo = 10;
+
+    /// Score in centipawns from `side`'s point of view.
+    [[nodiscard]] int evaluate(const chess::Board& board, chess::Color side) const noexcept {
+        const int white = chess::psqt::taper(board.psqScore(), board.phase());
+        return (side == chess::Color::White ? white : -white) + kTempo;
+    }
+};
+
+} // namespace engine
@@ -0,0 +1,168 @@
+#include "Nnue.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <span>
+#include "core/Bitboard.hpp"
+
+namespace engine::nnue {
+
+namespace {
+
+// ============================================================================
+// File Layout
+// ============================================================================
+
+constexpr std::array<char, 4> kMagic = {'M', 'C', 'N', 'N'};
+constexpr std::uint32_t kVersion = 1;
+
+constexpr std::size_t kHeaderSize = 64;
+constexpr std::size_t kVersionOffset = 4;
+constexpr std::size_t kInputsOffset = 8;
+constexpr std::size_t kHiddenOffset = 12;
+constexpr std::size_t kOutputQuantOffset = 16;
+constexpr std::size_t kEvalScaleOffset = 20;
+
+constexpr std::size_t kFeatureWeightsOffset = kHeaderSize;
+constexpr std::size_t kFeatureBiasesOffset =
+    kFeatureWeightsOffset + sizeof(std::int16_t) * kInputs * kHidden;
+constexpr std::size_t kOutputWeightsOffset =
+    kFeatureBiasesOffset + sizeof(std::int16_t) * kHidden;
+constexpr std::size_t kOutputBiasOffset =
+    kOutputWeightsOffset + sizeof(std::int16_t) * 2 * kHidden;
+constexpr std::size_t kFileSize = kOutputBiasOffset + sizeof(std::int32_t);
+
+// Rows stay 64-byte aligned in a page-aligned mapping
+static_assert(kFeatureWeightsOffset % 64 == 0 && kFeatureBiasesOffset % 64 == 0 &&
+              kOutputWeightsOffset % 64 == 0);
+
+constexpr int kSquares = chess::kSquareCount;
+constexpr int kPieceTypes = chess::kPieceTypeCount;
+static_assert(kInputs == chess::kColorCount * kPieceTypes * kSquares);
+
+/// Most pieces a legal position has, i.e. accumulator inputs set at once.
+constexpr int kMaxActiveInputs = 32;
+
+template <typename T>
+[[nodiscard]] T loadLe(std::span<const std::byte> bytes, std::size_t offset) noexcept {
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));  // Host is little-endian
+    return value;
+}
+
+[[nodiscard]] const std::int16_t* int16At(std::span<const std::byte> bytes,
+                                          std::size_t offset) noexcept {
+    return reinterpret_cast<const std::int16_t*>(bytes.data() + offset);
+}
+
+[[nodiscard]] constexpr int inputIndex(chess::Color perspective, chess::Piece piece,
+                                       int square) noexcept {
+    const int enemy = piece.color == perspective ? 0 : 1;
+    // Board indices run from a8; the network's from a1, mirrored for Black
+    const int relative = perspective == chess::Color::White ? square ^ 56 : square;
+    return (enemy * kPieceTypes + static_cast<int>(piece.type)) * kSquares + relative;
+}
+
+} // namespace
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+std::optional<Network> Network::load(const std::filesystem::path& path) {
+    if constexpr (std::endian::native != std::endian::little) return std::nullopt;
+
+    auto file = chess::MappedFile::open(path);
+    if (!file) return std::nullopt;
+    const std::span<const std::byte> bytes = file->bytes();
+    if (bytes.size() != kFileSize ||
+        std::memcmp(bytes.data(), kMagic.data(), kMagic.size()) != 0 ||
+        loadLe<std::uint32_t>(bytes, kVersionOffset) != kVersion ||
+        loadLe<std::uint32_t>(bytes, kInputsOffset) != kInputs ||
+        loadLe<std::uint32_t>(bytes, kHiddenOffset) != kHidden) {
+        return std::nullopt;
+    }
+    const auto output_quant = loadLe<std::int32_t>(bytes, kOutputQuantOffset);
+    const auto eval_scale = loadLe<std::int32_t>(bytes, kEvalScaleOffset);
+    if (output_quant <= 0 || eval_scale <= 0) return std::nullopt;
+
+    Network network(std::move(*file));
+    network.feature_weights_ = int16At(bytes, kFeatureWeightsOffset);
+    network.feature_biases_ = int16At(bytes, kFeatureBiasesOffset);
+    network.output_weights_ = int16At(bytes, kOutputWeightsOffset);
+    network.output_bias_ = loadLe<std::int32_t>(bytes, kOutputBiasOffset);
+    network.output_divisor_ = std::int64_t{kActivationMax} * output_quant;
+    network.eval_scale_ = eval_scale;
+
+    // The kernels sum the output layer in 32 bits
+    std::int64_t bound = std::abs(std::int64_t{network.output_bias_});
+    for (int i = 0; i < 2 * kHidden; ++i) {
+        bound += std::int64_t{kActivationMax} * std::abs(network.output_weights_[i]);
+    }
+    if (bound > std::numeric_limits<std::int32_t>::max()) return std::nullopt;
+    return network;
+}
+
+// ============================================================================
+// Accumulators
+// ============================================================================
+
+const std::int16_t* Network::row(chess::Color perspective,
+                                 const chess::PlacedPiece& placed) const noexcept {
+    const auto index = inputIndex(perspective, placed.piece, placed.square);
+    return feature_weights_ + static_cast<std::ptrdiff_t>(index) * kHidden;
+}
+
+void Network::refresh(const chess::Board& board, Accumulator& accumulator) const noexcept {
+    std::array<chess::PlacedPiece, kMaxActiveInputs> placed;
+    int count = 0;
+    for (chess::Bitboard bb = board.occupied(); bb != 0 && count < kMaxActiveInputs;) {
+        const int square = chess::popLsb(bb);
+        placed[count++] = {.piece = *board.at(square), .square = square};
+    }
+
+    for (int color = 0; color < chess::kColorCount; ++color) {
+        const auto perspective = static_cast<chess::Color>(color);
+        std::array<const std::int16_t*, kMaxActiveInputs> rows;
+        for (int i = 0; i < count; ++i) rows[i] = row(perspective, placed[i]);
+        kernels_->update(feature_biases_, accumulator.values[color].data(), rows.data(), count,
+                         nullptr, 0);
+    }
+}
+
+void Network::update(const Accumulator& before, const chess::PlacementDelta& delta,
+                     Accumulator& after) const noexcept {
+    for (int color = 0; color < chess::kColorCount; ++color) {
+        const auto perspective = static_cast<chess::Color>(color);
+        std::array<const std::int16_t*, 2> added;
+        std::array<const std::int16_t*, 2> removed;
+        for (int i = 0; i < delta.added_count; ++i) added[i] = row(perspective, delta.added[i]);
+        for (int i = 0; i < delta.removed_count; ++i) {
+            removed[i] = row(perspective, delta.removed[i]);
+        }
+        kernels_->update(before.values[color].data(), after.values[color].data(), added.data(),
+                         delta.added_count, removed.data(), delta.removed_count);
+    }
+}
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+int Network::evaluate(const Accumulator& accumulator, chess::Color side) const noexcept {
+    const auto us = static_cast<std::size_t>(side);
+    const auto them = static_cast<std::size_t>(chess::opponent(side));
+    const std::int32_t sum = kernels_->output(accumulator.values[us].data(),
+                                              accumulator.values[them].data(), output_weights_);
+    return static_cast<int>((std::int64_t{sum} + output_bias_) * eval_scale_ / output_divisor_);
+}
+
+int Network::evaluate(const chess::Board& board, chess::Color side) const noexcept {
+    Accumulator accumulator;
+    refresh(board, accumulator);
+    return evaluate(accumulator, side);
+}
+
+} // namespace engine::nnue
@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include "core/Board.hpp"
+#include "core/MappedFile.hpp"
+#include "NnueKernels.hpp"
+
+/// @file Nnue.hpp
+/// @brief Efficiently updatable neural network evaluation.
+
+namespace engine::nnue {
+
+/// First-layer outputs for both perspectives, indexed by Color. This is
+/// what make/unmake keeps current: a move changes at most four inputs.
+struct Accumulator {
+    alignas(64) std::array<std::array<std::int16_t, kHidden>, chess::kColorCount> values;
+};
+
+/// A (768 -> 256) x 2 -> 1 network read from a memory-mapped weights file.
+///
+/// Each perspective sees every piece as (own or enemy, type, square), with
+/// squares mirrored vertically for Black, through shared first-layer
+/// weights. The side to move's accumulator and the opponent's are clipped
+/// to [0, kActivationMax] and concatenated into the output layer.
+///
+/// File layout (little-endian):
+///   - 64-byte header: "MCNN", then u32 version (1), inputs (768), hidden
+///     size (256), output quantization Q and evaluation scale S, zero-padded
+///   - i16 first-layer weights [kInputs][kHidden], input index
+///     (6 * enemy + type) * 64 + square with a1 = 0 from the perspective
+///   - i16 first-layer biases [kHidden]
+///   - i16 output weights [2][kHidden]: side to move, then opponent
+///   - i32 output bias
+///
+/// Score = (output layer sum + bias) * S / (kActivationMax * Q) centipawns.
+/// The weights are used in place from the mapping, so every process and
+/// thread evaluating with the same file shares one copy of them.
+///
+/// @note Move-only; all const members are thread-safe.
+class Network {
+public:
+    /// Map and validate a weights file.
+    /// @return nullopt if it cannot be mapped, does not match the layout
+    ///         above, could overflow the output sum, or the CPU is big-endian
+    [[nodiscard]] static std::optional<Network> load(const std::filesystem::path& path);
+
+    /// Compute both perspectives from scratch.
+    void refresh(const chess::Board& board, Accumulator& accumulator) const noexcept;
+
+    /// `after` = `before` with a move's placement changes applied.
+    /// @param delta As returned by Board::placementDelta() before the move
+    void update(const Accumulator& before, const chess::PlacementDelta& delta,
+                Accumulator& after) const noexcept;
+
+    /// Score in centipawns from `side`'s point of view.
+    [[nodiscard]] int evaluate(const Accumulator& accumulator, chess::Color side) const noexcept;
+
+    /// Score of a board without a maintained accumulator (refreshes one).
+    [[nodiscard]] int evaluate(const chess::Board& board, chess::Color side) const noexcept;
+
+    /// Instruction set the kernels were chosen for, e.g. "avx2".
+    [[nodiscard]] std::string_view kernelName() const noexcept { return kernels_->name; }
+
+private:
+    explicit Network(chess::MappedFile file) noexcept : file_(std::move(file)) {}
+
+    /// First-layer weights of an input.
+    [[nodiscard]] const std::int16_t* row(chess::Color perspective,
+                                          const chess::PlacedPiece& placed) const noexcept;
+
+    // The pointers are into the mapping, which stays put when file_ moves
+    chess::MappedFile file_;
+    const std::int16_t* feature_weights_{nullptr};
+    const std::int16_t* feature_biases_{nullptr};
+    const std::int16_t* output_weights_{nullptr};
+    std::int32_t output_bias_{0};
+    std::int64_t output_divisor_{1};
+    std::int64_t eval_scale_{1};
+    const Kernels* kernels_{&bestKernels()};
+};
+
+} // namespace engine::nnue
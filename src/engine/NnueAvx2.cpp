@@ -0,0 +1,75 @@
+#include "NnueKernels.hpp"
+
+// Built with AVX2 enabled on x86 (see CMakeLists.txt); only reached once
+// CPU detection has found AVX2. Include nothing else: see NnueKernels.hpp.
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace engine::nnue {
+
+#if defined(__AVX2__)
+
+namespace {
+
+constexpr int kLanes = 16;  // 16-bit values per register
+static_assert(kHidden % kLanes == 0);
+
+[[nodiscard]] __m256i load(const std::int16_t* values) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+}
+
+void update(const std::int16_t* in, std::int16_t* out, const std::int16_t* const* added,
+            int added_count, const std::int16_t* const* removed, int removed_count) noexcept {
+    for (int i = 0; i < kHidden; i += kLanes) {
+        __m256i value = load(in + i);
+        for (int k = 0; k < added_count; ++k) {
+            value = _mm256_add_epi16(value, load(added[k] + i));
+        }
+        for (int k = 0; k < removed_count; ++k) {
+            value = _mm256_sub_epi16(value, load(removed[k] + i));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), value);
+    }
+}
+
+/// Clipped values times weights, summed pairwise into 32-bit lanes of `sum`.
+[[nodiscard]] __m256i accumulate(__m256i sum, const std::int16_t* values,
+                                 const std::int16_t* weights) noexcept {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max = _mm256_set1_epi16(kActivationMax);
+    for (int i = 0; i < kHidden; i += kLanes) {
+        const __m256i clipped = _mm256_min_epi16(_mm256_max_epi16(load(values + i), zero), max);
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(clipped, load(weights + i)));
+    }
+    return sum;
+}
+
+std::int32_t output(const std::int16_t* us, const std::int16_t* them,
+                    const std::int16_t* weights) noexcept {
+    __m256i sum = accumulate(_mm256_setzero_si256(), us, weights);
+    sum = accumulate(sum, them, weights + kHidden);
+
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(half);
+}
+
+constexpr Kernels kAvx2{.name = "avx2", .update = update, .output = output};
+
+} // namespace
+
+const Kernels* avx2Kernels() noexcept {
+    return &kAvx2;
+}
+
+#else
+
+const Kernels* avx2Kernels() noexcept {
+    return nullptr;
+}
+
+#endif
+
+} // namespace engine::nnue
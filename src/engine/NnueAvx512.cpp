@@ -0,0 +1,77 @@
+#include "NnueKernels.hpp"
+
+// Built with AVX-512 F/BW enabled on x86 (see CMakeLists.txt); only reached
+// once CPU detection has found both. Include nothing else: see NnueKernels.hpp.
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#include <immintrin.h>
+#endif
+
+namespace engine::nnue {
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+
+namespace {
+
+constexpr int kLanes = 32;  // 16-bit values per register
+static_assert(kHidden % kLanes == 0);
+
+[[nodiscard]] __m512i load(const std::int16_t* values) noexcept {
+    return _mm512_loadu_si512(values);
+}
+
+void update(const std::int16_t* in, std::int16_t* out, const std::int16_t* const* added,
+            int added_count, const std::int16_t* const* removed, int removed_count) noexcept {
+    for (int i = 0; i < kHidden; i += kLanes) {
+        __m512i value = load(in + i);
+        for (int k = 0; k < added_count; ++k) {
+            value = _mm512_add_epi16(value, load(added[k] + i));
+        }
+        for (int k = 0; k < removed_count; ++k) {
+            value = _mm512_sub_epi16(value, load(removed[k] + i));
+        }
+        _mm512_storeu_si512(out + i, value);
+    }
+}
+
+/// Clipped values times weights, summed pairwise into 32-bit lanes of `sum`.
+[[nodiscard]] __m512i accumulate(__m512i sum, const std::int16_t* values,
+                                 const std::int16_t* weights) noexcept {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i max = _mm512_set1_epi16(kActivationMax);
+    for (int i = 0; i < kHidden; i += kLanes) {
+        const __m512i clipped = _mm512_min_epi16(_mm512_max_epi16(load(values + i), zero), max);
+        sum = _mm512_add_epi32(sum, _mm512_madd_epi16(clipped, load(weights + i)));
+    }
+    return sum;
+}
+
+std::int32_t output(const std::int16_t* us, const std::int16_t* them,
+                    const std::int16_t* weights) noexcept {
+    __m512i sum = accumulate(_mm512_setzero_si512(), us, weights);
+    sum = accumulate(sum, them, weights + kHidden);
+
+    // Through memory: GCC 12's lane-extracting intrinsics trip -Wuninitialized
+    alignas(64) std::int32_t lanes[16];
+    _mm512_store_si512(lanes, sum);
+    std::int32_t total = 0;
+    for (const std::int32_t lane : lanes) total += lane;
+    return total;
+}
+
+constexpr Kernels kAvx512{.name = "avx512", .update = update, .output = output};
+
+} // namespace
+
+const Kernels* avx512Kernels() noexcept {
+    return &kAvx512;
+}
+
+#else
+
+const Kernels* avx512Kernels() noexcept {
+    return nullptr;
+}
+
+#endif
+
+} // namespace engine::nnue
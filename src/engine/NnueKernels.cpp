@@ -0,0 +1,181 @@
+#include "NnueKernels.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace engine::nnue {
+
+namespace {
+
+// ============================================================================
+// Scalar
+// ============================================================================
+
+void scalarUpdate(const std::int16_t* in, std::int16_t* out, const std::int16_t* const* added,
+                  int added_count, const std::int16_t* const* removed,
+                  int removed_count) noexcept {
+    for (int i = 0; i < kHidden; ++i) {
+        int value = in[i];
+        for (int k = 0; k < added_count; ++k) value += added[k][i];
+        for (int k = 0; k < removed_count; ++k) value -= removed[k][i];
+        out[i] = static_cast<std::int16_t>(value);
+    }
+}
+
+std::int32_t scalarOutput(const std::int16_t* us, const std::int16_t* them,
+                          const std::int16_t* weights) noexcept {
+    std::int32_t sum = 0;
+    for (int i = 0; i < kHidden; ++i) {
+        sum += std::clamp<std::int32_t>(us[i], 0, kActivationMax) * weights[i];
+        sum += std::clamp<std::int32_t>(them[i], 0, kActivationMax) * weights[kHidden + i];
+    }
+    return sum;
+}
+
+constexpr Kernels kScalar{.name = "scalar", .update = scalarUpdate, .output = scalarOutput};
+
+// ============================================================================
+// NEON (always present on AArch64, so no runtime check)
+// ============================================================================
+
+#if defined(__ARM_NEON)
+
+constexpr int kNeonLanes = 8;
+static_assert(kHidden % kNeonLanes == 0);
+
+void neonUpdate(const std::int16_t* in, std::int16_t* out, const std::int16_t* const* added,
+                int added_count, const std::int16_t* const* removed,
+                int removed_count) noexcept {
+    for (int i = 0; i < kHidden; i += kNeonLanes) {
+        int16x8_t value = vld1q_s16(in + i);
+        for (int k = 0; k < added_count; ++k) {
+            value = vaddq_s16(value, vld1q_s16(added[k] + i));
+        }
+        for (int k = 0; k < removed_count; ++k) {
+            value = vsubq_s16(value, vld1q_s16(removed[k] + i));
+        }
+        vst1q_s16(out + i, value);
+    }
+}
+
+std::int32_t neonOutput(const std::int16_t* us, const std::int16_t* them,
+                        const std::int16_t* weights) noexcept {
+    const int16x8_t zero = vdupq_n_s16(0);
+    const int16x8_t max = vdupq_n_s16(kActivationMax);
+    int32x4_t sum = vdupq_n_s32(0);
+    const auto accumulate = [&](const std::int16_t* values, const std::int16_t* row) {
+        for (int i = 0; i < kHidden; i += kNeonLanes) {
+            const int16x8_t clipped = vminq_s16(vmaxq_s16(vld1q_s16(values + i), zero), max);
+            const int16x8_t weight = vld1q_s16(row + i);
+            sum = vmlal_s16(sum, vget_low_s16(clipped), vget_low_s16(weight));
+            sum = vmlal_high_s16(sum, clipped, weight);
+        }
+    };
+    accumulate(us, weights);
+    accumulate(them, weights + kHidden);
+    return vaddvq_s32(sum);
+}
+
+constexpr Kernels kNeon{.name = "neon", .update = neonUpdate, .output = neonOutput};
+
+#endif
+
+// ============================================================================
+// CPU Detection
+// ============================================================================
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+
+/// CPUID leaf 7 feature bits, and whether the OS saves the wide registers.
+[[nodiscard]] bool cpuSupports(int leaf7_ebx_bit, unsigned long long xcr0_mask) noexcept {
+    std::array<int, 4> regs{};
+    __cpuid(regs.data(), 1);
+    constexpr int kOsxsave = 1 << 27;
+    if ((regs[2] & kOsxsave) == 0 || (_xgetbv(0) & xcr0_mask) != xcr0_mask) return false;
+    __cpuidex(regs.data(), 7, 0);
+    return (regs[1] & leaf7_ebx_bit) != 0;
+}
+
+[[nodiscard]] bool hasAvx2() noexcept {
+    constexpr unsigned long long kYmmState = 0x6;  // SSE and AVX registers
+    return cpuSupports(1 << 5, kYmmState);
+}
+
+[[nodiscard]] bool hasAvx512() noexcept {
+    constexpr unsigned long long kZmmState = 0xE6;  // Also opmask and upper ZMM registers
+    return cpuSupports(1 << 16, kZmmState) && cpuSupports(1 << 30, kZmmState);  // F and BW
+}
+
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+// The builtins also check that the OS saves the wide registers
+[[nodiscard]] bool hasAvx2() noexcept {
+    return __builtin_cpu_supports("avx2");
+}
+
+[[nodiscard]] bool hasAvx512() noexcept {
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+}
+
+#else
+
+[[nodiscard]] bool hasAvx2() noexcept { return false; }
+[[nodiscard]] bool hasAvx512() noexcept { return false; }
+
+#endif
+
+/// The usable sets, fastest first.
+struct Supported {
+    std::array<const Kernels*, 4> sets{};
+    std::size_t count{0};
+};
+
+[[nodiscard]] Supported detect() noexcept {
+    Supported supported;
+    const auto add = [&](const Kernels* kernels, bool usable) {
+        if (kernels != nullptr && usable) supported.sets[supported.count++] = kernels;
+    };
+    add(avx512Kernels(), hasAvx512());
+    add(avx2Kernels(), hasAvx2());
+    add(neonKernels(), true);
+    add(scalarKernels(), true);
+    return supported;
+}
+
+} // namespace
+
+// ============================================================================
+// Selection
+// ============================================================================
+
+const Kernels* scalarKernels() noexcept {
+    return &kScalar;
+}
+
+const Kernels* neonKernels() noexcept {
+#if defined(__ARM_NEON)
+    return &kNeon;
+#else
+    return nullptr;
+#endif
+}
+
+std::span<const Kernels* const> supportedKernels() noexcept {
+    static const Supported supported = detect();
+    return {supported.sets.data(), supported.count};
+}
+
+const Kernels& bestKernels() noexcept {
+    return *supportedKernels().front();
+}
+
+} // namespace engine::nnue
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+/// @file NnueKernels.hpp
+/// @brief Vector kernels of the NNUE evaluator, one set per instruction set.
+///
+/// The AVX2 and AVX-512 sets live in translation units compiled with those
+/// instruction sets enabled. To keep such code from being linked into paths
+/// that run on older CPUs, those files include nothing but this header and
+/// the intrinsics, and this header declares no inline functions.
+
+namespace engine::nnue {
+
+/// Inputs: one per (piece color, piece type, square), seen from one side.
+inline constexpr int kInputs = 2 * 6 * 64;
+
+/// Accumulator width per perspective (the first layer's outputs).
+inline constexpr int kHidden = 256;
+
+/// Accumulator values are clipped to [0, kActivationMax] before the output layer.
+inline constexpr int kActivationMax = 255;
+
+/// One instruction set's implementation of the two hot loops.
+struct Kernels {
+    const char* name;
+
+    /// out[i] = in[i] + sum of added[k][i] - sum of removed[k][i], for
+    /// i < kHidden, in wrapping 16-bit arithmetic. `out` may equal `in`.
+    void (*update)(const std::int16_t* in, std::int16_t* out, const std::int16_t* const* added,
+                   int added_count, const std::int16_t* const* removed,
+                   int removed_count) noexcept;
+
+    /// Sum over i < kHidden of clip(us[i]) * weights[i] + clip(them[i]) *
+    /// weights[kHidden + i], with clip() clamping to [0, kActivationMax].
+    std::int32_t (*output)(const std::int16_t* us, const std::int16_t* them,
+                           const std::int16_t* weights) noexcept;
+};
+
+/// Portable reference implementation; always available.
+[[nodiscard]] const Kernels* scalarKernels() noexcept;
+
+/// nullptr when the build does not include the instruction set. Having a
+/// set compiled in does not mean the running CPU supports it.
+[[nodiscard]] const Kernels* neonKernels() noexcept;
+[[nodiscard]] const Kernels* avx2Kernels() noexcept;
+[[nodiscard]] const Kernels* avx512Kernels() noexcept;
+
+/// Every set compiled in that the running CPU supports, fastest first.
+[[nodiscard]] std::span<const Kernels* const> supportedKernels() noexcept;
+
+/// The fastest supported set, detected once.
+[[nodiscard]] const Kernels& bestKernels() noexcept;
+
+} // namespace engine::nnue
@@ -0,0 +1,249 @@
+#include "OpeningBook.hpp"
+#include <algorithm>
+#include <concepts>
+#include <fstream>
+#include <utility>
+#include "core/Attacks.hpp"
+#include "core/MoveList.hpp"
+#include "core/Rules.hpp"
+#include "PolyglotRandom.hpp"
+
+namespace engine {
+
+namespace {
+
+constexpr std::size_t kMoveOffset = 8;
+constexpr std::size_t kWeightOffset = 10;
+
+constexpr int kRowShift = 3;
+constexpr int kFromShift = 6;
+constexpr int kPromotionShift = 12;
+
+constexpr std::uint32_t kMaxWeight = 0xFFFF;
+
+template <std::unsigned_integral T>
+void appendBe(std::vector<char>& out, T value) {
+    for (std::size_t i = sizeof(T); i-- > 0;) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+/// @pre offset + sizeof(T) <= bytes.size()
+template <std::unsigned_integral T>
+[[nodiscard]] T loadBe(std::span<const std::byte> bytes, std::size_t offset) noexcept {
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        value = static_cast<T>((value << 8) | static_cast<T>(bytes[offset + i]));
+    }
+    return value;
+}
+
+/// Polyglot square bits: file, then row counted from rank 1.
+[[nodiscard]] constexpr int encodeSquare(int rank, int file) noexcept {
+    return file | ((chess::kBoardSize - 1 - rank) << kRowShift);
+}
+
+/// Score of the side that played a move, given the game's result.
+[[nodiscard]] constexpr std::uint16_t scoreFor(chess::Color mover,
+                                               chess::GameResult result) noexcept {
+    switch (result) {
+        case chess::GameResult::WhiteWins: return mover == chess::Color::White ? 2 : 0;
+        case chess::GameResult::BlackWins: return mover == chess::Color::Black ? 2 : 0;
+        case chess::GameResult::Draw:
+        case chess::GameResult::Unknown:   return 1;
+    }
+    return 1;
+}
+
+} // namespace
+
+// ============================================================================
+// Book
+// ============================================================================
+
+std::optional<OpeningBook> OpeningBook::open(const std::filesystem::path& path) {
+    auto file = chess::MappedFile::open(path);
+    if (!file || file->size() % kEntrySize != 0) return std::nullopt;
+    return OpeningBook(std::move(*file));
+}
+
+std::vector<BookMove> OpeningBook::lookup(const chess::Board& board, chess::Color side) const {
+    const auto bytes = file_.bytes();
+    const std::uint64_t key = polyglotKey(board, side);
+    const auto keyAt = [&](std::size_t entry) {
+        return loadBe<std::uint64_t>(bytes, entry * kEntrySize);
+    };
+
+    // First entry with this key
+    std::size_t low = 0;
+    std::size_t high = size();
+    while (low < high) {
+        const std::size_t mid = low + (high - low) / 2;
+        if (keyAt(mid) < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    std::vector<BookMove> moves;
+    if (low == size() || keyAt(low) != key) return moves;
+
+    chess::MoveList legal;
+    chess::Rules{}.legalMoves(board, side, legal);
+    for (std::size_t entry = low; entry < size() && keyAt(entry) == key; ++entry) {
+        const std::size_t offset = entry * kEntrySize;
+        const auto raw = loadBe<std::uint16_t>(bytes, offset + kMoveOffset);
+        const auto it = std::ranges::find_if(
+            legal, [&](const chess::Move& move) { return encodeMove(move) == raw; });
+        if (it != legal.end()) {
+            moves.push_back({.move = *it,
+                             .weight = loadBe<std::uint16_t>(bytes, offset + kWeightOffset)});
+        }
+    }
+    std::ranges::stable_sort(moves, std::ranges::greater{}, &BookMove::weight);
+    return moves;
+}
+
+std::optional<chess::Move> OpeningBook::pick(const chess::Board& board, chess::Color side,
+                                             std::uint64_t random) const {
+    const std::vector<BookMove> moves = lookup(board, side);
+    std::uint64_t total = 0;
+    for (const BookMove& entry : moves) total += entry.weight;
+    if (total == 0) return std::nullopt;
+
+    std::uint64_t target = random % total;
+    for (const BookMove& entry : moves) {
+        if (target < entry.weight) return entry.move;
+        target -= entry.weight;
+    }
+    return std::nullopt;  // Unreachable
+}
+
+std::uint64_t OpeningBook::polyglotKey(const chess::Board& board, chess::Color side) noexcept {
+    std::uint64_t key = 0;
+    for (int color = 0; color < chess::kColorCount; ++color) {
+        for (int type = 0; type < chess::kPieceTypeCount; ++type) {
+            // Kinds alternate black, white per type
+            const int kind = 2 * type + (color == static_cast<int>(chess::Color::White) ? 1 : 0);
+            chess::Bitboard pieces =
+                board.pieces(static_cast<chess::PieceType>(type), static_cast<chess::Color>(color));
+            while (pieces) {
+                const chess::Square square = chess::toSquare(chess::popLsb(pieces));
+                key ^= polyglot::kRandom64[static_cast<std::size_t>(
+                    chess::kSquareCount * kind + encodeSquare(square.rank, square.file))];
+            }
+        }
+    }
+
+    const auto& rights = board.castlingRights();
+    for (std::size_t i = 0; i < rights.size(); ++i) {
+        if (rights[i]) key ^= polyglot::kRandom64[polyglot::kCastlingOffset + i];
+    }
+
+    if (const auto ep = board.enPassantSquare();
+        ep && (chess::pawnAttacks(chess::opponent(side), chess::toIndex(*ep)) &
+               board.pieces(chess::PieceType::Pawn, side))) {
+        key ^= polyglot::kRandom64[static_cast<std::size_t>(polyglot::kEnPassantOffset + ep->file)];
+    }
+
+    if (side == chess::Color::White) key ^= polyglot::kRandom64[polyglot::kTurnOffset];
+    return key;
+}
+
+std::uint16_t OpeningBook::encodeMove(const chess::Move& move) noexcept {
+    int to_file = move.to.file;
+    if (move.castling) {
+        // King "captures" its own rook
+        to_file = move.to.file > move.from.file ? chess::kBoardSize - 1 : 0;
+    }
+    int bits = encodeSquare(move.to.rank, to_file) |
+               (encodeSquare(move.from.rank, move.from.file) << kFromShift);
+    if (move.promotion) {
+        const int piece =
+            static_cast<int>(*move.promotion) - static_cast<int>(chess::PieceType::Knight) + 1;
+        bits |= piece << kPromotionShift;
+    }
+    return static_cast<std::uint16_t>(bits);
+}
+
+// ============================================================================
+// Builder
+// ============================================================================
+
+OpeningBookBuilder::OpeningBookBuilder(int max_plies) : max_plies_(std::max(max_plies, 0)) {}
+
+bool OpeningBookBuilder::addGame(std::span<const chess::PackedMove> moves,
+                                 chess::GameResult result, std::string_view start_fen) {
+    if (start_fen.empty()) {
+        game_.newGame();
+    } else if (!game_.loadFen(start_fen)) {
+        return false;
+    }
+
+    game_samples_.clear();
+    const std::size_t plies = std::min(moves.size(), static_cast<std::size_t>(max_plies_));
+    for (const chess::PackedMove packed : moves.first(plies)) {
+        const chess::Move wanted = packed.toMove();
+        const chess::MoveList& legal = game_.legalMoveList();
+        const auto it = std::ranges::find_if(legal, [&](const chess::Move& move) {
+            return move.from == wanted.from && move.to == wanted.to &&
+                   move.promotion == wanted.promotion;
+        });
+        if (it == legal.end()) return false;
+
+        const chess::Move move = *it;
+        game_samples_.push_back({
+            .key = OpeningBook::polyglotKey(game_.board(), game_.sideToMove()),
+            .move = OpeningBook::encodeMove(move),
+            .score = scoreFor(game_.sideToMove(), result),
+        });
+        static_cast<void>(game_.makeMove(move));
+    }
+
+    samples_.insert(samples_.end(), game_samples_.begin(), game_samples_.end());
+    return true;
+}
+
+bool OpeningBookBuilder::write(const std::filesystem::path& path) const {
+    std::vector<Sample> sorted = samples_;
+    std::ranges::sort(sorted, {}, [](const Sample& s) { return std::pair{s.key, s.move}; });
+
+    // One entry per position and move, weights summed
+    std::vector<Sample> entries;
+    for (std::size_t i = 0; i < sorted.size();) {
+        std::uint32_t weight = 0;
+        std::size_t j = i;
+        for (; j < sorted.size() && sorted[j].key == sorted[i].key &&
+               sorted[j].move == sorted[i].move;
+             ++j) {
+            weight += sorted[j].score;
+        }
+        if (weight > 0) {
+            entries.push_back({.key = sorted[i].key,
+                               .move = sorted[i].move,
+                               .score = static_cast<std::uint16_t>(std::min(weight, kMaxWeight))});
+        }
+        i = j;
+    }
+    // Polyglot order: by key, heaviest move first
+    std::ranges::stable_sort(entries, [](const Sample& a, const Sample& b) {
+        return a.key != b.key ? a.key < b.key : a.score > b.score;
+    });
+
+    std::vector<char> buffer;
+    buffer.reserve(entries.size() * OpeningBook::kEntrySize);
+    for (const Sample& entry : entries) {
+        appendBe(buffer, entry.key);
+        appendBe(buffer, entry.move);
+        appendBe(buffer, entry.score);
+        appendBe(buffer, std::uint32_t{0});  // Learn field, unused
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.close();
+    return !out.fail();
+}
+
+} // namespace engine
@@ -0,0 +1,114 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "core/Board.hpp"
+#include "core/ChessGame.hpp"
+#include "core/MappedFile.hpp"
+#include "core/PackedMove.hpp"
+#include "core/Pgn.hpp"
+
+/// @file OpeningBook.hpp
+/// @brief Opening books in the Polyglot file layout, read through a memory map.
+///
+/// A book is a flat array of 16-byte entries sorted by position key (all
+/// integers big-endian): key (u64), move (u16), weight (u16), learn (u32).
+/// Keys are Polyglot's (see polyglotKey()), so books written by other tools
+/// and by OpeningBookBuilder (e.g. `pgn_replay --write-book`) both work.
+/// Moves use the Polyglot encoding: to-file (bits 0-2), to-row (3-5),
+/// from-file (6-8), from-row (9-11) and promotion piece (12-14, 1 = Knight
+/// .. 4 = Queen), with rows counted from rank 1 and castling written as the
+/// king capturing its own rook.
+
+namespace engine {
+
+/// A book move with its relative weight.
+struct BookMove {
+    chess::Move move;
+    std::uint16_t weight{0};
+};
+
+/// Read-only opening book.
+///
+/// Opening maps the file and checks its size, nothing more, so a book costs
+/// nothing at startup; each lookup is a binary search touching a few pages.
+class OpeningBook {
+public:
+    static constexpr std::size_t kEntrySize = 16;
+
+    /// Map a book file.
+    /// @return nullopt if the file cannot be mapped or is not a whole number of entries
+    [[nodiscard]] static std::optional<OpeningBook> open(const std::filesystem::path& path);
+
+    /// Number of entries (position/move pairs).
+    [[nodiscard]] std::size_t size() const noexcept { return file_.size() / kEntrySize; }
+
+    /// Legal book moves for a position, highest weight first.
+    /// Entries that do not decode to a legal move (key collisions) are skipped.
+    [[nodiscard]] std::vector<BookMove> lookup(const chess::Board& board, chess::Color side) const;
+
+    /// Choose a book move with probability proportional to its weight.
+    /// @param random Uniformly distributed value selecting the move
+    /// @return nullopt if the position is not in the book
+    [[nodiscard]] std::optional<chess::Move> pick(const chess::Board& board, chess::Color side,
+                                                  std::uint64_t random) const;
+
+    /// Polyglot key of a position: its Random64 entries for every piece, the
+    /// castling rights, the side to move if White, and the en-passant file
+    /// only when a pawn of `side` stands ready to capture onto the square.
+    [[nodiscard]] static std::uint64_t polyglotKey(const chess::Board& board,
+                                                   chess::Color side) noexcept;
+
+    /// Polyglot encoding of a fully-flagged move (as produced by Rules).
+    [[nodiscard]] static std::uint16_t encodeMove(const chess::Move& move) noexcept;
+
+private:
+    explicit OpeningBook(chess::MappedFile file) noexcept : file_(std::move(file)) {}
+
+    chess::MappedFile file_;
+};
+
+/// Collects moves from games and writes them as an opening book.
+///
+/// A move's weight is the score its side got from the games it was played
+/// in: 2 per win, 1 per draw or unknown result, 0 per loss. Moves that only
+/// ever lost are left out.
+class OpeningBookBuilder {
+public:
+    static constexpr int kDefaultMaxPlies = 20;
+
+    /// @param max_plies Depth into each game up to which moves are recorded
+    explicit OpeningBookBuilder(int max_plies = kDefaultMaxPlies);
+
+    /// Record the first max_plies moves of a game.
+    /// @param start_fen Starting position; empty for the standard one
+    /// @return false (recording nothing) if the FEN is invalid or a move is illegal
+    [[nodiscard]] bool addGame(std::span<const chess::PackedMove> moves, chess::GameResult result,
+                               std::string_view start_fen = {});
+
+    /// Merge the recorded moves and write them, sorted, to a book file.
+    /// @return false if the file cannot be written
+    [[nodiscard]] bool write(const std::filesystem::path& path) const;
+
+    /// Number of moves recorded so far, before merging duplicates.
+    [[nodiscard]] std::size_t sampleCount() const noexcept { return samples_.size(); }
+
+private:
+    struct Sample {
+        std::uint64_t key{0};
+        std::uint16_t move{0};
+        std::uint16_t score{0};
+    };
+
+    int max_plies_;
+    std::vector<Sample> samples_;
+    std::vector<Sample> game_samples_;  // Scratch buffer for one game
+    chess::ChessGame game_;             // Validates moves
+};
+
+} // namespace engine
@@ -0,0 +1,463 @@
+#include "Search.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace engine {
+
+using chess::Board;
+using chess::Color;
+using chess::Move;
+using chess::MoveList;
+using chess::PackedMove;
+using chess::PieceType;
+using chess::UndoInfo;
+
+namespace {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+/// Piece values for MVV-LVA ordering, indexed by PieceType.
+constexpr std::array<int, chess::kPieceTypeCount> kPieceValues = {100, 320, 330, 500, 900, 0};
+
+// Move ordering bands: TT move, then captures (MVV-LVA), promotions,
+// killers, and finally quiet moves by history score.
+constexpr int kTTMoveScore = 1'000'000;
+constexpr int kCaptureScore = 500'000;
+constexpr int kPromotionScore = 400'000;
+constexpr int kKillerScore = 300'000;
+
+/// History scores are halved once any entry exceeds this, keeping them
+/// below the killer band.
+constexpr int kHistoryLimit = 100'000;
+
+/// Clock and stop flag are polled once per this many nodes (power of two).
+constexpr std::uint64_t kPollInterval = 2048;
+
+/// Earliest ply distance at which a position can repeat.
+constexpr int kRepetitionDistance = 4;
+
+[[nodiscard]] constexpr int pieceIndex(PieceType type) noexcept {
+    return static_cast<int>(type);
+}
+
+[[nodiscard]] constexpr int sideIndex(Color color) noexcept {
+    return static_cast<int>(color);
+}
+
+/// Mate and tablebase scores are stored relative to the node, not the root,
+/// so they stay correct when the entry is reached at a different ply.
+[[nodiscard]] constexpr int scoreToTable(int score, int ply) noexcept {
+    if (score >= kTablebaseThreshold) return score + ply;
+    if (score <= -kTablebaseThreshold) return score - ply;
+    return score;
+}
+
+[[nodiscard]] constexpr int scoreFromTable(int score, int ply) noexcept {
+    if (score >= kTablebaseThreshold) return score - ply;
+    if (score <= -kTablebaseThreshold) return score + ply;
+    return score;
+}
+
+/// Move the highest-scored remaining move to position `index`.
+void pickNext(MoveList& moves, std::span<int> scores, std::size_t index) noexcept {
+    std::size_t best = index;
+    for (std::size_t i = index + 1; i < moves.size(); ++i) {
+        if (scores[i] > scores[best]) best = i;
+    }
+    std::swap(moves[index], moves[best]);
+    std::swap(scores[index], scores[best]);
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+Search::Search(TranspositionTable& tt, const std::atomic<bool>& stop, int thread_id) noexcept
+    : tt_(tt), stop_(stop), thread_id_(thread_id) {}
+
+void Search::setNetwork(const nnue::Network* network) {
+    network_ = network;
+    if (network_ == nullptr) {
+        accumulators_ = {};
+    } else {
+        accumulators_.resize(kMaxPly + 1);
+    }
+}
+
+// ============================================================================
+// Iterative Deepening
+// ============================================================================
+
+SearchResult Search::run(const Board& board, Color side, const SearchLimits& limits,
+                         const InfoCallback& on_iteration, GameHistory game_history) {
+    board_ = board;
+    side_ = side;
+    if (network_ != nullptr) network_->refresh(board_, accumulators_[0]);
+    limits_ = limits;
+    start_ = Clock::now();
+    nodes_.store(0, std::memory_order_relaxed);
+    completed_depth_.store(0, std::memory_order_relaxed);
+    aborted_ = false;
+    // Helpers have nothing to report, so they may stop at any time
+    can_abort_ = thread_id_ != 0;
+
+    killers_ = {};
+    for (auto& side_history : history_) {
+        for (auto& from_history : side_history) {
+            for (int& value : from_history) value /= 2;
+        }
+    }
+    path_keys_[0] = chess::positionKey(board_, side_);
+    game_keys_.assign(game_history.begin(), game_history.end());
+
+    SearchResult result;
+    MoveList root_moves;
+    rules_.legalMoves(board_, side_, root_moves);
+    if (root_moves.empty()) {
+        result.info = makeInfo(0, rules_.isCheck(board_, side_) ? -kMateScore : 0);
+        return result;
+    }
+    result.best_move = root_moves[0];
+
+    // Odd helpers skip depth 1 so half the threads run one iteration ahead
+    const int max_depth = std::clamp(limits.depth, 1, kMaxPly - 1);
+    const int start_depth = std::min(1 + thread_id_ % 2, max_depth);
+    for (int depth = start_depth; depth <= max_depth; ++depth) {
+        const int score = alphaBeta(-kInfinity, kInfinity, depth, 0);
+        if (aborted_) break;
+
+        result.best_move = pv_[0][0].toMove();
+        result.info = makeInfo(depth, score);
+        completed_depth_.store(depth, std::memory_order_relaxed);
+        can_abort_ = true;
+        if (on_iteration) on_iteration(result.info);
+
+        // A mate inside the full-width horizon cannot be improved on
+        if (isMateScore(score) && kMateScore - std::abs(score) <= depth) break;
+
+        // The next iteration typically costs more than all previous ones
+        if (limits_.move_time && (Clock::now() - start_) * 2 >= *limits_.move_time) break;
+        if (limits_.nodes != 0 && nodes() >= limits_.nodes) break;
+        if (stop_.load(std::memory_order_relaxed)) break;
+    }
+
+    return result;
+}
+
+// ============================================================================
+// Alpha-Beta
+// ============================================================================
+
+int Search::alphaBeta(int alpha, int beta, int depth, int ply) {
+    pv_length_[ply] = ply;
+
+    const bool in_check = rules_.isCheck(board_, side_);
+    if (in_check) ++depth;
+    if (depth <= 0) return quiescence(alpha, beta, ply);
+
+    countNode();
+    checkLimits();
+    if (aborted_) return 0;
+
+    if (ply > 0 && isRepetition(ply)) return 0;
+    if (ply >= kMaxPly - 1) return evaluate(ply);
+
+    const bool pv_node = beta - alpha > 1;
+    const chess::zobrist::Key key = path_keys_[ply];
+
+    PackedMove tt_move{};
+    if (const auto entry = tt_.probe(key)) {
+        tt_move = entry->move;
+        if (!pv_node && entry->depth >= depth) {
+            const int score = scoreFromTable(entry->score, ply);
+            if (entry->bound == Bound::Exact ||
+                (entry->bound == Bound::Lower && score >= beta) ||
+                (entry->bound == Bound::Upper && score <= alpha)) {
+                return score;
+            }
+        }
+    }
+
+    // Right after a capture or pawn move the fifty-move counter is zero, so
+    // the WDL value is exact
+    if (tablebase_ != nullptr && ply > 0 && zeroing_[ply] && tablebase_->covers(board_)) {
+        if (const auto wdl = tablebase_->probeWdl(board_, side_)) {
+            const int score = tablebaseScore(*wdl, ply);
+            tt_.store(key, PackedMove{}, scoreToTable(score, ply), kMaxPly - 1, Bound::Exact);
+            return score;
+        }
+    }
+
+    MoveList moves;
+    rules_.legalMoves(board_, side_, moves);
+    if (moves.empty()) {
+        return in_check ? -kMateScore + ply : 0;
+    }
+
+    std::array<int, MoveList::kCapacity> score_storage;
+    const std::span<int> scores{score_storage.data(), moves.size()};
+    scoreMoves(moves, scores, tt_move, ply);
+
+    const int original_alpha = alpha;
+    int best_score = -kInfinity;
+    PackedMove best_move{};
+
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        pickNext(moves, scores, i);
+        const Move& move = moves[i];
+
+        const UndoInfo undo_info = play(move, ply);
+        int score;
+        if (i == 0) {
+            score = -alphaBeta(-beta, -alpha, depth - 1, ply + 1);
+        } else {
+            // Prove the move is worse with a null window; re-search if not
+            score = -alphaBeta(-alpha - 1, -alpha, depth - 1, ply + 1);
+            if (score > alpha && score < beta) {
+                score = -alphaBeta(-beta, -alpha, depth - 1, ply + 1);
+            }
+        }
+        undo(move, undo_info);
+
+        if (aborted_) return 0;
+
+        if (score > best_score) {
+            best_score = score;
+            best_move = PackedMove{move};
+
+            if (score > alpha) {
+                alpha = score;
+
+                pv_[ply][ply] = best_move;
+                for (int next = ply + 1; next < pv_length_[ply + 1]; ++next) {
+                    pv_[ply][next] = pv_[ply + 1][next];
+                }
+                pv_length_[ply] = std::max(pv_length_[ply + 1], ply + 1);
+
+                if (alpha >= beta) {
+                    if (!isCapture(move) && !move.isPromotion()) {
+                        updateQuietHistory(move, depth, ply);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    const Bound bound = best_score >= beta           ? Bound::Lower
+                        : best_score > original_alpha ? Bound::Exact
+                                                      : Bound::Upper;
+    tt_.store(key, bound == Bound::Upper ? PackedMove{} : best_move,
+              scoreToTable(best_score, ply), depth, bound);
+
+    return best_score;
+}
+
+// ============================================================================
+// Quiescence
+// ============================================================================
+
+int Search::quiescence(int alpha, int beta, int ply) {
+    pv_length_[ply] = ply;
+
+    countNode();
+    checkLimits();
+    if (aborted_) return 0;
+
+    if (ply >= kMaxPly - 1) return evaluate(ply);
+
+    // In check every evasion is searched and standing pat is not an option
+    const bool in_check = rules_.isCheck(board_, side_);
+    int best_score = -kInfinity;
+    if (!in_check) {
+        best_score = evaluate(ply);
+        if (best_score >= beta) return best_score;
+        alpha = std::max(alpha, best_score);
+    }
+
+    MoveList moves;
+    rules_.legalMoves(board_, side_, moves);
+    if (moves.empty()) {
+        return in_check ? -kMateScore + ply : 0;
+    }
+
+    std::array<int, MoveList::kCapacity> score_storage;
+    const std::span<int> scores{score_storage.data(), moves.size()};
+    scoreMoves(moves, scores, PackedMove{}, ply);
+
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        pickNext(moves, scores, i);
+        const Move& move = moves[i];
+
+        const bool tactical = isCapture(move) || move.promotion == PieceType::Queen;
+        if (!in_check && !tactical) continue;
+
+        const UndoInfo undo_info = play(move, ply);
+        const int score = -quiescence(-beta, -alpha, ply + 1);
+        undo(move, undo_info);
+
+        if (aborted_) return 0;
+
+        if (score > best_score) {
+            best_score = score;
+            if (score > alpha) {
+                alpha = score;
+
+                pv_[ply][ply] = PackedMove{move};
+                for (int next = ply + 1; next < pv_length_[ply + 1]; ++next) {
+                    pv_[ply][next] = pv_[ply + 1][next];
+                }
+                pv_length_[ply] = std::max(pv_length_[ply + 1], ply + 1);
+
+                if (alpha >= beta) break;
+            }
+        }
+    }
+
+    return best_score;
+}
+
+// ============================================================================
+// Move Ordering
+// ============================================================================
+
+void Search::scoreMoves(const MoveList& moves, std::span<int> scores, PackedMove tt_move,
+                        int ply) const noexcept {
+    const auto& history = history_[sideIndex(side_)];
+
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        const Move& move = moves[i];
+        const PackedMove packed{move};
+
+        if (packed == tt_move) {
+            scores[i] = kTTMoveScore;
+        } else if (isCapture(move)) {
+            // Most valuable victim first, least valuable attacker breaking ties
+            const PieceType victim = move.en_passant ? PieceType::Pawn : board_.at(move.to)->type;
+            const PieceType attacker = board_.at(move.from)->type;
+            scores[i] = kCaptureScore + kPieceValues[pieceIndex(victim)] * 8 -
+                        pieceIndex(attacker);
+        } else if (move.promotion) {
+            scores[i] = kPromotionScore + pieceIndex(*move.promotion);
+        } else if (packed == killers_[ply][0]) {
+            scores[i] = kKillerScore;
+        } else if (packed == killers_[ply][1]) {
+            scores[i] = kKillerScore - 1;
+        } else {
+            scores[i] = history[packed.fromIndex()][packed.toIndex()];
+        }
+    }
+}
+
+void Search::updateQuietHistory(const Move& move, int depth, int ply) noexcept {
+    const PackedMove packed{move};
+    if (killers_[ply][0] != packed) {
+        killers_[ply][1] = killers_[ply][0];
+        killers_[ply][0] = packed;
+    }
+
+    auto& side_history = history_[sideIndex(side_)];
+    int& value = side_history[packed.fromIndex()][packed.toIndex()];
+    value += depth * depth;
+    if (value > kHistoryLimit) {
+        for (auto& from_history : side_history) {
+            for (int& entry : from_history) entry /= 2;
+        }
+    }
+}
+
+bool Search::isCapture(const Move& move) const noexcept {
+    return move.en_passant || board_.hasPieceAt(move.to);
+}
+
+// ============================================================================
+// Position Helpers
+// ============================================================================
+
+int Search::evaluate(int ply) const noexcept {
+    if (network_ == nullptr) return evaluator_.evaluate(board_, side_);
+    // Keep network output clear of the tablebase and mate score bands
+    constexpr int kMaxEvaluation = kTablebaseThreshold - 1;
+    return std::clamp(network_->evaluate(accumulators_[ply], side_), -kMaxEvaluation,
+                      kMaxEvaluation);
+}
+
+bool Search::isRepetition(int ply) const noexcept {
+    const chess::zobrist::Key key = path_keys_[ply];
+    int earlier = ply - kRepetitionDistance;
+    for (; earlier >= 0; earlier -= 2) {
+        if (path_keys_[earlier] == key) return true;
+    }
+    // Continue into the game: game_keys_.back() is one ply before the root
+    for (auto i = static_cast<std::ptrdiff_t>(game_keys_.size()) + earlier; i >= 0; i -= 2) {
+        if (game_keys_[static_cast<std::size_t>(i)] == key) return true;
+    }
+    return false;
+}
+
+UndoInfo Search::play(const Move& move, int ply) noexcept {
+    zeroing_[ply + 1] = isCapture(move) || board_.at(move.from)->type == PieceType::Pawn;
+    if (network_ != nullptr) {
+        network_->update(accumulators_[ply], board_.placementDelta(move), accumulators_[ply + 1]);
+    }
+    const UndoInfo undo_info = board_.makeMove(move);
+    side_ = chess::opponent(side_);
+    path_keys_[ply + 1] = chess::positionKey(board_, side_);
+    return undo_info;
+}
+
+void Search::undo(const Move& move, const UndoInfo& undo_info) noexcept {
+    board_.unmakeMove(move, undo_info);
+    side_ = chess::opponent(side_);
+}
+
+// ============================================================================
+// Limits and Reporting
+// ============================================================================
+
+void Search::checkLimits() noexcept {
+    if (!can_abort_) return;
+
+    const std::uint64_t nodes = this->nodes();
+    if (limits_.nodes != 0 && nodes >= limits_.nodes) {
+        aborted_ = true;
+        return;
+    }
+    if (nodes % kPollInterval != 0) return;
+
+    if (stop_.load(std::memory_order_relaxed) ||
+        (limits_.move_time && Clock::now() - start_ >= *limits_.move_time)) {
+        aborted_ = true;
+    }
+}
+
+std::vector<Move> Search::principalVariation() const {
+    std::vector<Move> pv;
+    pv.reserve(static_cast<std::size_t>(pv_length_[0]));
+    for (int ply = 0; ply < pv_length_[0]; ++ply) {
+        pv.push_back(pv_[0][ply].toMove());
+    }
+    return pv;
+}
+
+SearchInfo Search::makeInfo(int depth, int score) const {
+    const auto elapsed = Clock::now() - start_;
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    const std::uint64_t nodes = this->nodes();
+
+    return SearchInfo{
+        .depth = depth,
+        .score = score,
+        .nodes = nodes,
+        .elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed),
+        .nps = nodes * 1'000'000 / static_cast<std::uint64_t>(std::max<long long>(micros, 1)),
+        .pv = depth > 0 ? principalVariation() : std::vector<Move>{},
+    };
+}
+
+} // namespace engine
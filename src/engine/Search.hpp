@@ -0,0 +1,225 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+#include "core/Board.hpp"
+#include "core/MoveList.hpp"
+#include "core/PackedMove.hpp"
+#include "core/Rules.hpp"
+#include "Evaluator.hpp"
+#include "Nnue.hpp"
+#include "Tablebase.hpp"
+#include "TranspositionTable.hpp"
+
+/// @file Search.hpp
+/// @brief Iterative-deepening principal variation search.
+
+namespace engine {
+
+// ============================================================================
+// Scores and Limits
+// ============================================================================
+
+/// Maximum search depth in plies, including quiescence.
+inline constexpr int kMaxPly = 128;
+
+/// Score of being checkmated at the root; mate in N plies scores kMateScore - N.
+inline constexpr int kMateScore = 32000;
+
+/// Window bound strictly outside every reachable score.
+inline constexpr int kInfinity = kMateScore + 1;
+
+/// Scores at or beyond this magnitude are forced mates.
+inline constexpr int kMateThreshold = kMateScore - kMaxPly;
+
+[[nodiscard]] constexpr bool isMateScore(int score) noexcept {
+    return score >= kMateThreshold || score <= -kMateThreshold;
+}
+
+/// Score of a tablebase win N plies from the root: kTablebaseWinScore - N,
+/// below every mate but above every evaluation.
+inline constexpr int kTablebaseWinScore = kMateThreshold - 1;
+
+/// Scores at or beyond this magnitude are tablebase results or mates.
+inline constexpr int kTablebaseThreshold = kTablebaseWinScore - kMaxPly;
+
+/// Search score of a tablebase value `ply` plies from the root. Cursed wins
+/// and blessed losses are draws under the fifty-move rule.
+[[nodiscard]] constexpr int tablebaseScore(Wdl wdl, int ply) noexcept {
+    if (wdl == Wdl::Win) return kTablebaseWinScore - ply;
+    if (wdl == Wdl::Loss) return -kTablebaseWinScore + ply;
+    return 0;
+}
+
+/// When to stop searching. The first iteration always completes so a move is
+/// available; all other limits are checked while searching.
+struct SearchLimits {
+    /// Deepest iteration to run, in plies.
+    int depth{kMaxPly - 1};
+
+    /// Wall-clock budget; nullopt searches until another limit or stop().
+    std::optional<std::chrono::milliseconds> move_time{};
+
+    /// Node budget; 0 = unlimited.
+    std::uint64_t nodes{0};
+};
+
+/// Progress after one completed iteration.
+struct SearchInfo {
+    int depth{0};
+    int score{0};  ///< From the side to move's point of view, in centipawns
+    std::uint64_t nodes{0};
+    std::chrono::milliseconds elapsed{0};
+    std::uint64_t nps{0};
+    int hashfull{0};  ///< Permille of the transposition table in use (Engine fills it in)
+    std::vector<chess::Move> pv;
+};
+
+/// Work done by one search thread.
+struct ThreadStats {
+    std::uint64_t nodes{0};
+    int depth{0};  ///< Deepest completed iteration
+};
+
+struct SearchResult {
+    /// nullopt when the root position has no legal moves.
+    std::optional<chess::Move> best_move{};
+    SearchInfo info;
+    /// One entry per search thread; index 0 is the main thread.
+    std::vector<ThreadStats> threads;
+};
+
+/// Called after every completed iteration.
+using InfoCallback = std::function<void(const SearchInfo&)>;
+
+/// Keys of the positions played before the search root, oldest first, back to
+/// the last capture or pawn move (see chess::IGame::repetitionKeys()). Lets the
+/// search score returns to game positions as draws, not only repetitions
+/// inside its own tree.
+using GameHistory = std::span<const chess::zobrist::Key>;
+
+// ============================================================================
+// Search
+// ============================================================================
+
+/// One single-threaded searcher: alpha-beta with principal variation search,
+/// quiescence on captures, and move ordering from the transposition table,
+/// MVV-LVA, killer moves and the history heuristic.
+///
+/// Works on a private copy of the root board using make/unmake. History scores
+/// are aged rather than cleared between run() calls so the next search of a
+/// related position starts with useful ordering.
+///
+/// Several instances can search the same root concurrently (Lazy SMP): they
+/// share only the transposition table and the stop flag, and helpers
+/// (thread_id > 0) stagger their start depth so threads diverge.
+class Search {
+public:
+    /// @param tt        Table shared with the owning Engine
+    /// @param stop      Raised by another thread to abort the search
+    /// @param thread_id 0 for the main thread, > 0 for helpers
+    Search(TranspositionTable& tt, const std::atomic<bool>& stop, int thread_id = 0) noexcept;
+
+    /// Search the position with iterative deepening until a limit is hit.
+    [[nodiscard]] SearchResult run(const chess::Board& board, chess::Color side,
+                                   const SearchLimits& limits,
+                                   const InfoCallback& on_iteration = {},
+                                   GameHistory game_history = {});
+
+    /// Nodes searched so far by the current or last run().
+    /// @note Safe to read from another thread while run() is in progress.
+    [[nodiscard]] std::uint64_t nodes() const noexcept {
+        return nodes_.load(std::memory_order_relaxed);
+    }
+
+    /// Zero the node count before run() is started on another thread, so
+    /// readers never see the previous run's total.
+    void resetNodes() noexcept {
+        nodes_.store(0, std::memory_order_relaxed);
+    }
+
+    /// Deepest iteration completed by the current or last run().
+    [[nodiscard]] int completedDepth() const noexcept {
+        return completed_depth_.load(std::memory_order_relaxed);
+    }
+
+    /// Probe `tablebase` (may be null) after captures and pawn moves.
+    /// @pre No run() is in progress; the tablebase outlives every later run()
+    void setTablebase(const Tablebase* tablebase) noexcept { tablebase_ = tablebase; }
+
+    /// Evaluate with `network`, or with the piece-square tables if it is null.
+    /// @pre No run() is in progress; the network outlives every later run()
+    void setNetwork(const nnue::Network* network);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    [[nodiscard]] int alphaBeta(int alpha, int beta, int depth, int ply);
+    [[nodiscard]] int quiescence(int alpha, int beta, int ply);
+
+    /// Score every move in `moves` for ordering into `scores`.
+    void scoreMoves(const chess::MoveList& moves, std::span<int> scores,
+                    chess::PackedMove tt_move, int ply) const noexcept;
+
+    [[nodiscard]] bool isCapture(const chess::Move& move) const noexcept;
+    [[nodiscard]] int evaluate(int ply) const noexcept;
+    [[nodiscard]] bool isRepetition(int ply) const noexcept;
+
+    /// Record a quiet move that caused a beta cutoff.
+    void updateQuietHistory(const chess::Move& move, int depth, int ply) noexcept;
+
+    /// Play a move on the search board, tracking side to move and path keys.
+    [[nodiscard]] chess::UndoInfo play(const chess::Move& move, int ply) noexcept;
+    void undo(const chess::Move& move, const chess::UndoInfo& undo) noexcept;
+
+    /// Count a visited node. Only the owning thread writes the counter, so a
+    /// plain load/store pair suffices (no locked read-modify-write).
+    void countNode() noexcept {
+        nodes_.store(nodes_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /// Poll limits periodically; sets aborted_ once any is exceeded.
+    void checkLimits() noexcept;
+
+    [[nodiscard]] std::vector<chess::Move> principalVariation() const;
+    [[nodiscard]] SearchInfo makeInfo(int depth, int score) const;
+
+    TranspositionTable& tt_;
+    const std::atomic<bool>& stop_;
+    const Tablebase* tablebase_{nullptr};
+    int thread_id_{0};
+    chess::Rules rules_;
+    Evaluator evaluator_;
+    const nnue::Network* network_{nullptr};
+    // Network inputs of the position at each ply, updated by play(); undo()
+    // needs nothing since the previous ply's entry is still intact
+    std::vector<nnue::Accumulator> accumulators_;
+
+    chess::Board board_;
+    chess::Color side_{chess::Color::White};
+
+    SearchLimits limits_{};
+    Clock::time_point start_{};
+    std::atomic<std::uint64_t> nodes_{0};
+    std::atomic<int> completed_depth_{0};
+    bool aborted_{false};
+    bool can_abort_{false};
+
+    std::array<chess::zobrist::Key, kMaxPly + 1> path_keys_{};
+    std::array<bool, kMaxPly + 1> zeroing_{};  // Reached by a capture or pawn move
+    std::vector<chess::zobrist::Key> game_keys_;  // Before path_keys_[0]
+    std::array<std::array<chess::PackedMove, 2>, kMaxPly> killers_{};
+    std::array<std::array<std::array<int, chess::kSquareCount>, chess::kSquareCount>,
+               chess::kColorCount> history_{};
+
+    // Triangular principal variation table
+    std::array<std::array<chess::PackedMove, kMaxPly>, kMaxPly> pv_{};
+    std::array<int, kMaxPly> pv_length_{};
+};
+
+} // namespace engine
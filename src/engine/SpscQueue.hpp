@@ -0,0 +1,63 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+/// @file SpscQueue.hpp
+/// @brief Bounded lock-free queue for one producer and one consumer thread.
+
+namespace engine {
+
+/// Fixed-capacity ring buffer safe for exactly one pushing thread and one
+/// popping thread. Neither side ever blocks: tryPush() fails when full and
+/// tryPop() returns nullopt when empty.
+///
+/// The head and tail counters increase monotonically; each is written by one
+/// side only and published with release/acquire, so a popped slot is always
+/// fully constructed and a pushed slot is never still being read.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && std::has_single_bit(Capacity),
+                  "Capacity must be a power of two");
+
+public:
+    /// Producer side. `value` is moved from only on success, so a failed push
+    /// can simply be retried.
+    /// @return false if the queue is full
+    [[nodiscard]] bool tryPush(T&& value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots_[tail & kMask] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side.
+    [[nodiscard]] std::optional<T> tryPop() {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        std::optional<T> value{std::move(slots_[head & kMask])};
+        head_.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    /// Keeps the two counters on separate cache lines so the producer and
+    /// consumer do not invalidate each other on every operation.
+    static constexpr std::size_t kCacheLine = 64;
+
+    alignas(kCacheLine) std::atomic<std::size_t> head_{0};
+    alignas(kCacheLine) std::atomic<std::size_t> tail_{0};
+    alignas(kCacheLine) std::array<T, Capacity> slots_{};
+};
+
+} // namespace engine
@@ -0,0 +1,398 @@
+#include "SyzygyIndex.hpp"
+#include <algorithm>
+#include <utility>
+#include "core/Bitboard.hpp"
+
+namespace engine::syzygy {
+
+using chess::Bitboard;
+using chess::Board;
+using chess::Color;
+using chess::PieceType;
+
+namespace {
+
+constexpr int kSquares = chess::kSquareCount;
+
+// ============================================================================
+// Square Encoding
+// ============================================================================
+
+// The format numbers squares from a1 (0) to h8 (63); Board counts from a8.
+
+[[nodiscard]] constexpr int fromBoardIndex(int index) noexcept { return index ^ 56; }
+[[nodiscard]] constexpr int fileOf(int square) noexcept { return square & 7; }
+[[nodiscard]] constexpr int rankOf(int square) noexcept { return square >> 3; }
+[[nodiscard]] constexpr int flipFile(int square) noexcept { return square ^ 7; }
+[[nodiscard]] constexpr int flipRank(int square) noexcept { return square ^ 56; }
+[[nodiscard]] constexpr int flipDiagonal(int square) noexcept {
+    return ((square >> 3) | (square << 3)) & 63;
+}
+
+/// Above (> 0), on (0) or below (< 0) the a1-h8 diagonal.
+[[nodiscard]] constexpr int offDiagonal(int square) noexcept {
+    return rankOf(square) - fileOf(square);
+}
+
+[[nodiscard]] constexpr bool kingsTouch(int a, int b) noexcept {
+    const int files = fileOf(a) - fileOf(b);
+    const int ranks = rankOf(a) - rankOf(b);
+    return files >= -1 && files <= 1 && ranks >= -1 && ranks <= 1;
+}
+
+/// Index tables shared by every table of the format.
+struct EncodingTables {
+    /// binomial[k][n]: ways to choose k of n squares
+    std::array<std::array<std::uint64_t, kSquares>, kMaxPieces - 1> binomial{};
+    std::array<int, kSquares> map_b1h1h7{};  ///< Squares below the diagonal -> 0..27
+    std::array<int, kSquares> map_a1d1d4{};  ///< a1-d1-d4 triangle -> 0..9, diagonal last
+    /// Both kings, the first in the triangle, as 0..461
+    std::array<std::array<int, kSquares>, 10> map_kk{};
+    int king_pairs{0};
+    /// a2-h7 -> 0..47, highest for the pawn nearest the edge and rank 2
+    std::array<int, kSquares> map_pawns{};
+    std::array<std::array<int, kSquares>, kMaxPieces - 1> lead_pawn_idx{};
+    std::array<std::array<int, 4>, kMaxPieces - 1> lead_pawns_size{};
+};
+
+inline constexpr EncodingTables kEncoding = [] {
+    EncodingTables tables;
+
+    int code = 0;
+    for (int s = 0; s < kSquares; ++s) {
+        if (offDiagonal(s) < 0) tables.map_b1h1h7[s] = code++;
+    }
+
+    constexpr int kD4 = 27;
+    std::array<int, 4> diagonal{};
+    std::size_t diagonal_count = 0;
+    code = 0;
+    for (int s = 0; s <= kD4; ++s) {
+        if (fileOf(s) > 3) continue;
+        if (offDiagonal(s) < 0) {
+            tables.map_a1d1d4[s] = code++;
+        } else if (offDiagonal(s) == 0) {
+            diagonal[diagonal_count++] = s;
+        }
+    }
+    for (std::size_t i = 0; i < diagonal_count; ++i) tables.map_a1d1d4[diagonal[i]] = code++;
+
+    // With the first king on the diagonal the second is never above it
+    constexpr int kB1 = 1;
+    std::array<std::pair<int, int>, 32> both_on_diagonal{};
+    std::size_t both_count = 0;
+    code = 0;
+    for (int idx = 0; idx < 10; ++idx) {
+        for (int s1 = 0; s1 <= kD4; ++s1) {
+            if (tables.map_a1d1d4[s1] != idx || (idx == 0 && s1 != kB1)) continue;
+            for (int s2 = 0; s2 < kSquares; ++s2) {
+                if (kingsTouch(s1, s2)) continue;
+                if (offDiagonal(s1) == 0 && offDiagonal(s2) > 0) continue;
+                if (offDiagonal(s1) == 0 && offDiagonal(s2) == 0) {
+                    both_on_diagonal[both_count++] = {idx, s2};
+                } else {
+                    tables.map_kk[idx][s2] = code++;
+                }
+            }
+        }
+    }
+    for (std::size_t i = 0; i < both_count; ++i) {
+        tables.map_kk[both_on_diagonal[i].first][both_on_diagonal[i].second] = code++;
+    }
+    tables.king_pairs = code;
+
+    tables.binomial[0][0] = 1;
+    for (int n = 1; n < kSquares; ++n) {
+        for (int k = 0; k < kMaxPieces - 1 && k <= n; ++k) {
+            tables.binomial[k][n] = (k > 0 ? tables.binomial[k - 1][n - 1] : 0) +
+                                    (k < n ? tables.binomial[k][n - 1] : 0);
+        }
+    }
+
+    int available = 47;
+    for (int lead_count = 1; lead_count < kMaxPieces - 1; ++lead_count) {
+        for (int file = 0; file < 4; ++file) {
+            // The table is split by file, so every file restarts at 0
+            int idx = 0;
+            for (int rank = 1; rank <= 6; ++rank) {
+                const int s = file + 8 * rank;
+                if (lead_count == 1) {
+                    tables.map_pawns[s] = available--;
+                    tables.map_pawns[flipFile(s)] = available--;
+                }
+                tables.lead_pawn_idx[lead_count][s] = idx;
+                idx += static_cast<int>(tables.binomial[lead_count - 1][tables.map_pawns[s]]);
+            }
+            tables.lead_pawns_size[lead_count][file] = idx;
+        }
+    }
+    return tables;
+}();
+
+static_assert(kEncoding.king_pairs == 462, "legal placements of two kings, up to symmetry");
+
+/// Placements of three unique leading pieces, up to symmetry.
+constexpr std::uint64_t kUniqueTriples = 6 * 63 * 62 + 4 * 28 * 62 + 4 * 7 * 28 + 4 * 7 * 6;
+
+[[nodiscard]] bool byMapPawns(int a, int b) noexcept {
+    return kEncoding.map_pawns[a] < kEncoding.map_pawns[b];
+}
+
+constexpr int kPawn = static_cast<int>(PieceType::Pawn);
+constexpr int kKing = static_cast<int>(PieceType::King);
+
+[[nodiscard]] constexpr int pieceCode(chess::Piece piece) noexcept {
+    return static_cast<int>(piece.type) + 1 + (piece.color == Color::Black ? kBlackBit : 0);
+}
+
+} // namespace
+
+// ============================================================================
+// Material
+// ============================================================================
+
+std::uint64_t materialKey(const PieceCounts& counts) noexcept {
+    std::uint64_t key = 0;
+    for (std::size_t color = 0; color < counts.size(); ++color) {
+        for (std::size_t type = 0; type < counts[color].size(); ++type) {
+            const auto shift = 4 * (color * counts[color].size() + type);
+            key |= static_cast<std::uint64_t>(counts[color][type]) << shift;
+        }
+    }
+    return key;
+}
+
+std::uint64_t materialKey(const Board& board) noexcept {
+    PieceCounts counts{};
+    for (int color = 0; color < chess::kColorCount; ++color) {
+        for (int type = 0; type < chess::kPieceTypeCount; ++type) {
+            counts[color][type] = chess::popCount(
+                board.pieces(static_cast<PieceType>(type), static_cast<Color>(color)));
+        }
+    }
+    return materialKey(counts);
+}
+
+std::optional<PieceCounts> parseMaterial(std::string_view code) {
+    const auto split = code.find('v');
+    if (split == std::string_view::npos) return std::nullopt;
+
+    PieceCounts counts{};
+    int total = 0;
+    const std::array<std::string_view, 2> sides = {code.substr(0, split), code.substr(split + 1)};
+    for (std::size_t color = 0; color < sides.size(); ++color) {
+        for (const char letter : sides[color]) {
+            constexpr std::string_view kLetters = "PNBRQK";
+            const auto type = kLetters.find(letter);
+            if (type == std::string_view::npos) return std::nullopt;
+            ++counts[color][type];
+            ++total;
+        }
+        if (counts[color][kKing] != 1) return std::nullopt;
+    }
+    if (total > kMaxPieces) return std::nullopt;
+    return counts;
+}
+
+TableShape shapeOf(const PieceCounts& counts) noexcept {
+    TableShape shape{
+        .key = materialKey(counts),
+        .key2 = materialKey({counts[1], counts[0]}),
+    };
+    for (const auto& side : counts) {
+        for (int type = 0; type < chess::kPieceTypeCount; ++type) {
+            shape.piece_count += side[type];
+            if (type != kKing && side[type] == 1) shape.has_unique_pieces = true;
+        }
+    }
+    const int white_pawns = counts[0][kPawn];
+    const int black_pawns = counts[1][kPawn];
+    shape.has_pawns = white_pawns + black_pawns > 0;
+    const bool white_leads = black_pawns == 0 || (white_pawns != 0 && black_pawns >= white_pawns);
+    shape.pawn_count = white_leads ? std::array{white_pawns, black_pawns}
+                                   : std::array{black_pawns, white_pawns};
+    return shape;
+}
+
+// ============================================================================
+// Layout
+// ============================================================================
+
+std::uint64_t IndexLayout::size() const noexcept {
+    const auto groups = std::ranges::find(group_len, 0) - group_len.begin();
+    return group_idx[static_cast<std::size_t>(groups)];
+}
+
+void setGroups(const TableShape& shape, IndexLayout& layout, std::array<int, 2> order, int file) {
+    int n = 0;
+    int first_len = shape.has_pawns ? 0 : shape.has_unique_pieces ? 3 : 2;
+    layout.group_len[n] = 1;
+    for (int i = 1; i < shape.piece_count; ++i) {
+        if (--first_len > 0 || layout.pieces[i] == layout.pieces[i - 1]) {
+            ++layout.group_len[n];
+        } else {
+            layout.group_len[++n] = 1;
+        }
+    }
+    layout.group_len[++n] = 0;
+
+    // Groups are encoded in a per-table order: order[0] is the leading
+    // group, order[1] the remaining pawns when both sides have some
+    const bool both_pawns = shape.has_pawns && shape.pawn_count[1] > 0;
+    int next = both_pawns ? 2 : 1;
+    int free_squares = kSquares - layout.group_len[0] - (both_pawns ? layout.group_len[1] : 0);
+    std::uint64_t idx = 1;
+    for (int k = 0; next < n || k == order[0] || k == order[1]; ++k) {
+        if (k == order[0]) {
+            layout.group_idx[0] = idx;
+            idx *= shape.has_pawns ? static_cast<std::uint64_t>(
+                                         kEncoding.lead_pawns_size[layout.group_len[0]][file])
+                   : shape.has_unique_pieces ? kUniqueTriples
+                                             : static_cast<std::uint64_t>(kEncoding.king_pairs);
+        } else if (k == order[1]) {
+            layout.group_idx[1] = idx;
+            idx *= kEncoding.binomial[layout.group_len[1]][48 - layout.group_len[0]];
+        } else {
+            layout.group_idx[next] = idx;
+            idx *= kEncoding.binomial[layout.group_len[next]][free_squares];
+            free_squares -= layout.group_len[next++];
+        }
+    }
+    layout.group_idx[n] = idx;
+}
+
+// ============================================================================
+// Position Index
+// ============================================================================
+
+Placement placementOf(const Board& board, Color side, const TableShape& shape,
+                      int lead_code) noexcept {
+    // Tables are stored with the stronger side (as named) White, and only
+    // White to move when the material is symmetric: flip colors and ranks
+    // to get there
+    const bool black = side == Color::Black;
+    const bool flip = (shape.key == shape.key2 && black) || materialKey(board) != shape.key;
+    const int flip_color = flip ? kBlackBit : 0;
+    const int flip_squares = flip ? 56 : 0;
+
+    Placement placement{.stored_side = flip != black ? 1 : 0};
+    auto& squares = placement.squares;
+    int& size = placement.size;
+    Bitboard lead_pawns = 0;
+
+    // With pawns there is a sub-table per file of the leading pawn: the one
+    // nearest the edge, then nearest rank 2 (highest map_pawns[])
+    if (shape.has_pawns) {
+        const int lead = lead_code ^ flip_color;
+        const Color lead_color = (lead & kBlackBit) != 0 ? Color::Black : Color::White;
+        lead_pawns = board.pieces(PieceType::Pawn, lead_color);
+        for (Bitboard pawns = lead_pawns; pawns != 0;) {
+            squares[size++] = fromBoardIndex(chess::popLsb(pawns)) ^ flip_squares;
+        }
+        placement.lead_count = size;
+        std::swap(squares[0], *std::max_element(squares.begin(), squares.begin() + size,
+                                                byMapPawns));
+        placement.lead_file = std::min(fileOf(squares[0]), flipFile(squares[0]) & 7);
+    }
+
+    for (Bitboard rest = board.occupied() ^ lead_pawns; rest != 0;) {
+        const int index = chess::popLsb(rest);
+        squares[size] = fromBoardIndex(index) ^ flip_squares;
+        placement.pieces[size++] = pieceCode(*board.at(index)) ^ flip_color;
+    }
+    return placement;
+}
+
+std::uint64_t encode(const TableShape& shape, const IndexLayout& layout,
+                     Placement placement) noexcept {
+    auto& squares = placement.squares;
+    auto& pieces = placement.pieces;
+    const int size = placement.size;
+    const int lead_count = placement.lead_count;
+
+    // Order the pieces as the sub-table encodes them
+    for (int i = lead_count; i < size - 1; ++i) {
+        for (int j = i + 1; j < size; ++j) {
+            if (layout.pieces[i] == pieces[j]) {
+                std::swap(pieces[i], pieces[j]);
+                std::swap(squares[i], squares[j]);
+                break;
+            }
+        }
+    }
+
+    // Mirror the leading piece into files a-d
+    if (fileOf(squares[0]) > 3) {
+        for (int i = 0; i < size; ++i) squares[i] = flipFile(squares[i]);
+    }
+
+    std::uint64_t idx = 0;
+    if (shape.has_pawns) {
+        idx = static_cast<std::uint64_t>(kEncoding.lead_pawn_idx[lead_count][squares[0]]);
+        std::stable_sort(squares.begin() + 1, squares.begin() + lead_count, byMapPawns);
+        for (int i = 1; i < lead_count; ++i) {
+            idx += kEncoding.binomial[i][kEncoding.map_pawns[squares[i]]];
+        }
+    } else {
+        // Without pawns also mirror into ranks 1-4, then below the diagonal
+        if (rankOf(squares[0]) > 3) {
+            for (int i = 0; i < size; ++i) squares[i] = flipRank(squares[i]);
+        }
+        for (int i = 0; i < layout.group_len[0]; ++i) {
+            if (offDiagonal(squares[i]) == 0) continue;
+            if (offDiagonal(squares[i]) > 0) {
+                for (int j = i; j < size; ++j) squares[j] = flipDiagonal(squares[j]);
+            }
+            break;
+        }
+
+        if (shape.has_unique_pieces) {
+            const int s0 = squares[0];
+            const int s1 = squares[1];
+            const int s2 = squares[2];
+            const int adjust1 = s1 > s0;
+            const int adjust2 = (s2 > s0) + (s2 > s1);
+            int value = 0;
+            if (offDiagonal(s0) != 0) {
+                value = (kEncoding.map_a1d1d4[s0] * 63 + (s1 - adjust1)) * 62 + s2 - adjust2;
+            } else if (offDiagonal(s1) != 0) {
+                value = (6 * 63 + rankOf(s0) * 28 + kEncoding.map_b1h1h7[s1]) * 62 + s2 - adjust2;
+            } else if (offDiagonal(s2) != 0) {
+                value = 6 * 63 * 62 + 4 * 28 * 62 + rankOf(s0) * 7 * 28 +
+                        (rankOf(s1) - adjust1) * 28 + kEncoding.map_b1h1h7[s2];
+            } else {
+                value = 6 * 63 * 62 + 4 * 28 * 62 + 4 * 7 * 28 + rankOf(s0) * 7 * 6 +
+                        (rankOf(s1) - adjust1) * 6 + (rankOf(s2) - adjust2);
+            }
+            idx = static_cast<std::uint64_t>(value);
+        } else {
+            idx = static_cast<std::uint64_t>(
+                kEncoding.map_kk[kEncoding.map_a1d1d4[squares[0]]][squares[1]]);
+        }
+    }
+
+    // Remaining groups: each a combination of the squares not taken by
+    // earlier groups (the other side's pawns never stand on rank 1)
+    idx *= layout.group_idx[0];
+    int group_start = layout.group_len[0];
+    bool remaining_pawns = shape.has_pawns && shape.pawn_count[1] > 0;
+    for (int next = 1; layout.group_len[next] != 0; ++next) {
+        const auto begin = squares.begin() + group_start;
+        const auto end = begin + layout.group_len[next];
+        std::sort(begin, end);
+        std::uint64_t combination = 0;
+        for (int i = 0; i < layout.group_len[next]; ++i) {
+            const int square = begin[i];
+            const auto below = std::count_if(squares.begin(), begin,
+                                             [&](int earlier) { return square > earlier; });
+            combination += kEncoding.binomial[i + 1][square - static_cast<int>(below) -
+                                                     (remaining_pawns ? 8 : 0)];
+        }
+        remaining_pawns = false;
+        idx += combination * layout.group_idx[next];
+        group_start += layout.group_len[next];
+    }
+    return idx;
+}
+
+} // namespace engine::syzygy
@@ -0,0 +1,84 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include "core/Board.hpp"
+#include "core/Types.hpp"
+
+/// @file SyzygyIndex.hpp
+/// @brief Syzygy table layout: material keys and the position index of a
+/// sub-table, independent of any table file.
+
+namespace engine::syzygy {
+
+inline constexpr int kMaxPieces = 7;
+
+/// Sub-table pieces are encoded 1..6 (pawn..king), plus 8 for Black, in a nibble.
+inline constexpr int kBlackBit = 8;
+
+/// Piece counts by [color][piece type].
+using PieceCounts = std::array<std::array<int, chess::kPieceTypeCount>, chess::kColorCount>;
+
+/// Exact key of a material distribution: four bits per piece kind.
+[[nodiscard]] std::uint64_t materialKey(const PieceCounts& counts) noexcept;
+[[nodiscard]] std::uint64_t materialKey(const chess::Board& board) noexcept;
+
+/// Material of a file name like "KRPvKR" (White's pieces first).
+/// @return nullopt unless each side has one king and there are at most kMaxPieces
+[[nodiscard]] std::optional<PieceCounts> parseMaterial(std::string_view code);
+
+/// What a table's material implies for its encoding.
+struct TableShape {
+    std::uint64_t key{0};   ///< Material with the stronger side (as named) White
+    std::uint64_t key2{0};  ///< The same material with colors swapped
+    int piece_count{0};
+    bool has_pawns{false};
+    bool has_unique_pieces{false};  ///< Some side has exactly one of a non-king piece
+    /// Pawns of the leading color (the side with fewer, if both have some), then the other
+    std::array<int, 2> pawn_count{};
+};
+
+[[nodiscard]] TableShape shapeOf(const PieceCounts& counts) noexcept;
+
+/// How one sub-table orders and groups its pieces.
+struct IndexLayout {
+    /// Piece codes in encoding order, and the pieces grouped for indexing
+    std::array<int, kMaxPieces> pieces{};
+    std::array<int, kMaxPieces + 1> group_len{};  ///< Zero-terminated
+    std::array<std::uint64_t, kMaxPieces + 1> group_idx{};
+
+    /// Number of indices: the entry after the last group.
+    [[nodiscard]] std::uint64_t size() const noexcept;
+};
+
+/// Group `layout.pieces` and size each group's index range.
+/// @param order Encoding position of the leading group and, when both sides
+///              have pawns, of the other side's pawns (from the file header)
+/// @param file File of the leading pawn (0..3); 0 without pawns
+void setGroups(const TableShape& shape, IndexLayout& layout, std::array<int, 2> order, int file);
+
+/// A position's pieces as a table sees them: colors and ranks flipped so the
+/// stronger side (as named) is White, squares numbered from a1 (0) to h8 (63).
+struct Placement {
+    std::array<int, kMaxPieces> squares{};
+    std::array<int, kMaxPieces> pieces{};  ///< Codes as in IndexLayout; unset for leading pawns
+    int size{0};
+    int lead_count{0};  ///< Leading pawns, first in `squares`
+    int lead_file{0};   ///< Sub-table of the leading pawn (0..3)
+    int stored_side{0}; ///< 0 for White to move after flipping, 1 for Black
+};
+
+/// Pieces of `board` for the table of shape `shape`.
+/// @param lead_code First piece code of the table's layouts (the leading pawns)
+/// @pre materialKey(board) is shape.key or shape.key2
+[[nodiscard]] Placement placementOf(const chess::Board& board, chess::Color side,
+                                    const TableShape& shape, int lead_code) noexcept;
+
+/// Index of the placement in a sub-table with `layout`, mirroring it into
+/// the part of the board the format stores.
+/// @return A value below layout.size()
+[[nodiscard]] std::uint64_t encode(const TableShape& shape, const IndexLayout& layout,
+                                   Placement placement) noexcept;
+
+} // namespace engine::syzygy
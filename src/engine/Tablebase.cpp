@@ -0,0 +1,722 @@
+#include "Tablebase.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include "core/Bitboard.hpp"
+#include "core/MappedFile.hpp"
+#include "core/MoveList.hpp"
+#include "core/Rules.hpp"
+#include "SyzygyIndex.hpp"
+
+namespace engine {
+
+using chess::Bitboard;
+using chess::Board;
+using chess::Color;
+using chess::Move;
+using chess::PieceType;
+
+namespace {
+
+// ============================================================================
+// Format Constants
+// ============================================================================
+
+using syzygy::kBlackBit;
+using syzygy::TableShape;
+
+static_assert(Tablebase::kMaxPieces == syzygy::kMaxPieces);
+
+constexpr std::array<std::uint8_t, 4> kWdlMagic = {0xD7, 0x66, 0x0C, 0xA5};
+constexpr std::array<std::uint8_t, 4> kDtzMagic = {0x71, 0xE8, 0x23, 0x5D};
+
+#ifdef _WIN32
+constexpr char kPathSeparator = ';';
+#else
+constexpr char kPathSeparator = ':';
+#endif
+
+// File header flags
+constexpr std::uint8_t kSplitFlag = 1;     // Both sides to move are stored
+constexpr std::uint8_t kHasPawnsFlag = 2;
+
+// Flags of one compressed sub-table
+constexpr std::uint8_t kStmFlag = 1;            // DTZ: stored for Black to move
+constexpr std::uint8_t kMappedFlag = 2;         // DTZ: values go through a map
+constexpr std::uint8_t kWinPliesFlag = 4;       // DTZ: wins counted in plies, not moves
+constexpr std::uint8_t kLossPliesFlag = 8;
+constexpr std::uint8_t kWideFlag = 16;          // DTZ: 16-bit map entries
+constexpr std::uint8_t kSingleValueFlag = 128;  // Every position has the same value
+
+/// Packed binary symbol tree node size: two 12-bit children.
+constexpr std::size_t kTreeNodeSize = 3;
+constexpr int kNoChild = 0xFFF;
+
+constexpr std::size_t kSparseEntrySize = 6;  // u32 block, u16 offset
+constexpr std::size_t kBlockAlignment = 64;
+
+constexpr int kDtzZeroingWin = 1;
+constexpr int kDtzCursed = 101;
+constexpr int kFiftyMovePlies = 100;
+
+// ============================================================================
+// Binary Reading
+// ============================================================================
+
+template <std::unsigned_integral T>
+[[nodiscard]] T loadLe(const std::uint8_t* bytes) noexcept {
+    T value = 0;
+    for (std::size_t i = sizeof(T); i-- > 0;) {
+        value = static_cast<T>((value << 8) | bytes[i]);
+    }
+    return value;
+}
+
+template <std::unsigned_integral T>
+[[nodiscard]] T loadBe(const std::uint8_t* bytes) noexcept {
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        value = static_cast<T>((value << 8) | bytes[i]);
+    }
+    return value;
+}
+
+/// Bounds-checked forward cursor over a mapped file; a failed read leaves it
+/// failed, so a truncated file is caught once, after parsing.
+class Reader {
+public:
+    explicit Reader(std::span<const std::byte> bytes) noexcept
+        : base_(reinterpret_cast<const std::uint8_t*>(bytes.data())), size_(bytes.size()) {}
+
+    [[nodiscard]] bool ok() const noexcept { return ok_; }
+    [[nodiscard]] std::size_t offset() const noexcept { return offset_; }
+    [[nodiscard]] const std::uint8_t* at(std::size_t offset) const noexcept {
+        return base_ + offset;
+    }
+
+    /// The next `count` bytes, or nullptr past the end.
+    [[nodiscard]] const std::uint8_t* take(std::size_t count) noexcept {
+        if (!ok_ || count > size_ - offset_) {
+            ok_ = false;
+            return nullptr;
+        }
+        const std::uint8_t* bytes = base_ + offset_;
+        offset_ += count;
+        return bytes;
+    }
+
+    [[nodiscard]] std::uint8_t byte() noexcept {
+        const std::uint8_t* bytes = take(1);
+        return bytes != nullptr ? *bytes : 0;
+    }
+
+    template <std::unsigned_integral T>
+    [[nodiscard]] T little() noexcept {
+        const std::uint8_t* bytes = take(sizeof(T));
+        return bytes != nullptr ? loadLe<T>(bytes) : 0;
+    }
+
+    /// Skip to the next multiple of `alignment` (a power of two). Mappings
+    /// are page-aligned, so file offsets align like addresses.
+    void align(std::size_t alignment) noexcept {
+        static_cast<void>(take(((offset_ + alignment - 1) & ~(alignment - 1)) - offset_));
+    }
+
+private:
+    const std::uint8_t* base_;
+    std::size_t size_;
+    std::size_t offset_{0};
+    bool ok_{true};
+};
+
+// ============================================================================
+// Compressed Sub-Tables
+// ============================================================================
+
+/// One compressed value array: a table has one per side to move stored and,
+/// with pawns, per file of the leading pawn.
+struct PairsData {
+    std::uint8_t flags{0};
+    int min_sym_len{0};  ///< Or the value of a kSingleValueFlag table
+    int max_sym_len{0};
+    std::uint64_t block_size{0};
+    std::uint64_t span{0};  ///< Values per sparse index entry
+    std::uint32_t num_blocks{0};
+    std::size_t block_length_count{0};
+    std::size_t sparse_index_count{0};
+    const std::uint8_t* lowest_sym{nullptr};
+    const std::uint8_t* tree{nullptr};
+    const std::uint8_t* sparse_index{nullptr};
+    const std::uint8_t* block_lengths{nullptr};
+    const std::uint8_t* blocks{nullptr};
+    std::vector<std::uint64_t> base64;  ///< Canonical Huffman code bounds per length
+    std::vector<std::uint8_t> symlen;   ///< Values expanded by each symbol, minus one
+
+    syzygy::IndexLayout layout;
+    std::array<std::uint16_t, 4> map_idx{};  ///< DTZ: map offset per WDL value
+};
+
+[[nodiscard]] int leftChild(const PairsData& d, int symbol) noexcept {
+    const std::uint8_t* node = d.tree + kTreeNodeSize * static_cast<std::size_t>(symbol);
+    return ((node[1] & 0xF) << 8) | node[0];
+}
+
+[[nodiscard]] int rightChild(const PairsData& d, int symbol) noexcept {
+    const std::uint8_t* node = d.tree + kTreeNodeSize * static_cast<std::size_t>(symbol);
+    return (node[2] << 4) | (node[1] >> 4);
+}
+
+/// Fill symlen[] for `symbol` and the symbols it expands to.
+[[nodiscard]] bool setSymbolLength(PairsData& d, int symbol, std::vector<bool>& visited) {
+    visited[symbol] = true;  // The tree is acyclic
+    const int right = rightChild(d, symbol);
+    if (right == kNoChild) {
+        d.symlen[symbol] = 0;
+        return true;
+    }
+    const int left = leftChild(d, symbol);
+    const auto count = static_cast<int>(d.symlen.size());
+    if (left >= count || right >= count) return false;
+    if (!visited[left] && !setSymbolLength(d, left, visited)) return false;
+    if (!visited[right] && !setSymbolLength(d, right, visited)) return false;
+    d.symlen[symbol] = static_cast<std::uint8_t>(d.symlen[left] + d.symlen[right] + 1);
+    return true;
+}
+
+/// Read the Huffman header of one sub-table.
+void readSizes(PairsData& d, Reader& reader) {
+    d.flags = reader.byte();
+    if ((d.flags & kSingleValueFlag) != 0) {
+        d.min_sym_len = reader.byte();
+        return;
+    }
+
+    const std::uint64_t size = d.layout.size();
+
+    d.block_size = std::uint64_t{1} << (reader.byte() & 63);
+    d.span = std::uint64_t{1} << (reader.byte() & 63);
+    d.sparse_index_count = static_cast<std::size_t>((size + d.span - 1) / d.span);
+    const int padding = reader.byte();
+    d.num_blocks = reader.little<std::uint32_t>();
+    d.block_length_count = d.num_blocks + static_cast<std::size_t>(padding);
+    d.max_sym_len = reader.byte();
+    d.min_sym_len = reader.byte();
+    if (d.max_sym_len < d.min_sym_len || d.min_sym_len == 0) {
+        static_cast<void>(reader.take(std::string::npos));  // Corrupt
+        return;
+    }
+
+    const auto lengths = static_cast<std::size_t>(d.max_sym_len - d.min_sym_len + 1);
+    d.lowest_sym = reader.take(lengths * sizeof(std::uint16_t));
+    if (d.lowest_sym == nullptr) return;
+    const auto lowest = [&](std::size_t i) {
+        return std::uint64_t{loadLe<std::uint16_t>(d.lowest_sym + 2 * i)};
+    };
+    d.base64.assign(lengths, 0);
+    for (std::size_t i = lengths - 1; i-- > 0;) {
+        d.base64[i] = (d.base64[i + 1] + lowest(i) - lowest(i + 1)) / 2;
+    }
+    for (std::size_t i = 0; i < lengths; ++i) {
+        d.base64[i] <<= 64 - i - static_cast<std::size_t>(d.min_sym_len);
+    }
+
+    const std::size_t symbols = reader.little<std::uint16_t>();
+    d.tree = reader.take(symbols * kTreeNodeSize + (symbols & 1));
+    if (d.tree == nullptr) return;
+    d.symlen.assign(symbols, 0);
+    std::vector<bool> visited(symbols);
+    for (std::size_t symbol = 0; symbol < symbols; ++symbol) {
+        if (!visited[symbol] && !setSymbolLength(d, static_cast<int>(symbol), visited)) {
+            static_cast<void>(reader.take(std::string::npos));
+            return;
+        }
+    }
+}
+
+/// Value number `idx` of a sub-table.
+[[nodiscard]] int decompress(const PairsData& d, std::uint64_t idx) noexcept {
+    if ((d.flags & kSingleValueFlag) != 0) return d.min_sym_len;
+
+    // The sparse index points near the value; walk blocks to reach it
+    const std::uint8_t* entry = d.sparse_index + kSparseEntrySize * (idx / d.span);
+    std::uint32_t block = loadLe<std::uint32_t>(entry);
+    auto offset = static_cast<std::int64_t>(loadLe<std::uint16_t>(entry + 4)) +
+                  static_cast<std::int64_t>(idx % d.span) -
+                  static_cast<std::int64_t>(d.span / 2);
+    const auto blockLength = [&](std::uint32_t b) {
+        return static_cast<std::int64_t>(loadLe<std::uint16_t>(d.block_lengths + 2 * b));
+    };
+    while (offset < 0) offset += blockLength(--block) + 1;
+    while (offset > blockLength(block)) offset -= blockLength(block++) + 1;
+
+    // Decode symbols until the one covering `offset`
+    const std::uint8_t* bits = d.blocks + static_cast<std::uint64_t>(block) * d.block_size;
+    std::uint64_t buffer = loadBe<std::uint64_t>(bits);
+    bits += sizeof(std::uint64_t);
+    int buffered = 64;
+    int symbol = 0;
+    while (true) {
+        std::size_t length = 0;
+        while (buffer < d.base64[length]) ++length;
+        const int shift = 64 - static_cast<int>(length) - d.min_sym_len;
+        symbol = static_cast<int>((buffer - d.base64[length]) >> shift) +
+                 loadLe<std::uint16_t>(d.lowest_sym + 2 * length);
+        if (offset < d.symlen[symbol] + 1) break;
+        offset -= d.symlen[symbol] + 1;
+
+        const int consumed = static_cast<int>(length) + d.min_sym_len;
+        buffer <<= consumed;
+        buffered -= consumed;
+        if (buffered <= 32) {
+            buffered += 32;
+            buffer |= std::uint64_t{loadBe<std::uint32_t>(bits)} << (64 - buffered);
+            bits += sizeof(std::uint32_t);
+        }
+    }
+
+    // Expand the symbol's pair tree down to the single value
+    while (d.symlen[symbol] != 0) {
+        const int left = leftChild(d, symbol);
+        if (offset < d.symlen[left] + 1) {
+            symbol = left;
+        } else {
+            offset -= d.symlen[left] + 1;
+            symbol = rightChild(d, symbol);
+        }
+    }
+    return leftChild(d, symbol);
+}
+
+// ============================================================================
+// Table Files
+// ============================================================================
+
+/// One .rtbw or .rtbz file, mapped and parsed on first use.
+struct TableFile {
+    std::filesystem::path path;  ///< Empty if the file was not found
+    std::once_flag loaded;
+    bool ready{false};  ///< Mapped and parsed; written once under `loaded`
+    std::optional<chess::MappedFile> file;
+    std::array<std::array<PairsData, 4>, 2> items;  ///< [side stored][leading file]
+    const std::uint8_t* dtz_map{nullptr};
+};
+
+/// Read the DTZ value maps that follow the Huffman headers.
+void readDtzMaps(TableFile& table, int files, Reader& reader) {
+    const std::size_t map_start = reader.offset();
+    table.dtz_map = reader.at(map_start);
+    for (int file = 0; file < files; ++file) {
+        PairsData& d = table.items[0][file];
+        if ((d.flags & kMappedFlag) == 0) continue;
+        if ((d.flags & kWideFlag) != 0) {
+            reader.align(2);
+            for (auto& idx : d.map_idx) {
+                idx = static_cast<std::uint16_t>((reader.offset() - map_start) / 2 + 1);
+                const std::size_t entries = reader.little<std::uint16_t>();
+                static_cast<void>(reader.take(2 * entries));
+            }
+        } else {
+            for (auto& idx : d.map_idx) {
+                idx = static_cast<std::uint16_t>(reader.offset() - map_start + 1);
+                const std::size_t entries = reader.byte();
+                static_cast<void>(reader.take(entries));
+            }
+        }
+    }
+    reader.align(2);
+}
+
+/// Map a table file and locate its sub-tables.
+/// @return false if the file is missing, truncated or not a table for `shape`
+[[nodiscard]] bool loadTable(const TableShape& shape, TableFile& table, bool dtz) {
+    table.file = chess::MappedFile::open(table.path);
+    if (!table.file) return false;
+    Reader reader(table.file->bytes());
+
+    const std::uint8_t* magic = reader.take(4);
+    const auto& expected = dtz ? kDtzMagic : kWdlMagic;
+    if (magic == nullptr || !std::equal(expected.begin(), expected.end(), magic)) return false;
+
+    const std::uint8_t header = reader.byte();
+    const bool split = shape.key != shape.key2;
+    if (((header & kHasPawnsFlag) != 0) != shape.has_pawns ||
+        ((header & kSplitFlag) != 0) != split) {
+        return false;
+    }
+
+    // DTZ files store one side to move only
+    const int sides = !dtz && split ? 2 : 1;
+    const int files = shape.has_pawns ? 4 : 1;
+    const bool both_pawns = shape.has_pawns && shape.pawn_count[1] > 0;
+    for (int file = 0; file < files; ++file) {
+        const std::uint8_t first = reader.byte();
+        const std::uint8_t second = both_pawns ? reader.byte() : std::uint8_t{0xFF};
+        const std::array<std::array<int, 2>, 2> order = {{
+            {first & 0xF, second & 0xF},
+            {first >> 4, second >> 4},
+        }};
+        for (int k = 0; k < shape.piece_count; ++k) {
+            const std::uint8_t pieces = reader.byte();
+            for (int side = 0; side < sides; ++side) {
+                table.items[side][file].layout.pieces[k] = side == 0 ? pieces & 0xF : pieces >> 4;
+            }
+        }
+        for (int side = 0; side < sides; ++side) {
+            syzygy::setGroups(shape, table.items[side][file].layout, order[side], file);
+        }
+    }
+    reader.align(2);
+
+    for (int file = 0; file < files; ++file) {
+        for (int side = 0; side < sides; ++side) readSizes(table.items[side][file], reader);
+    }
+    if (dtz) readDtzMaps(table, files, reader);
+    for (int file = 0; file < files; ++file) {
+        for (int side = 0; side < sides; ++side) {
+            PairsData& d = table.items[side][file];
+            d.sparse_index = reader.take(d.sparse_index_count * kSparseEntrySize);
+        }
+    }
+    for (int file = 0; file < files; ++file) {
+        for (int side = 0; side < sides; ++side) {
+            PairsData& d = table.items[side][file];
+            d.block_lengths = reader.take(d.block_length_count * sizeof(std::uint16_t));
+        }
+    }
+    for (int file = 0; file < files; ++file) {
+        for (int side = 0; side < sides; ++side) {
+            PairsData& d = table.items[side][file];
+            reader.align(kBlockAlignment);
+            d.blocks = reader.take(static_cast<std::size_t>(d.num_blocks * d.block_size));
+        }
+    }
+    return reader.ok();
+}
+
+[[nodiscard]] bool ensureLoaded(const TableShape& shape, TableFile& table, bool dtz) {
+    std::call_once(table.loaded, [&] {
+        table.ready = !table.path.empty() && loadTable(shape, table, dtz);
+        if (!table.ready) table.file.reset();
+    });
+    return table.ready;
+}
+
+/// Stored DTZ value to plies, given the position's WDL value.
+[[nodiscard]] int mapDtz(const TableFile& table, const PairsData& d, int value, Wdl wdl) {
+    // map_idx[] is ordered Win, Loss, CursedWin, BlessedLoss; draws are not stored
+    constexpr std::array<std::size_t, 5> kMapOf = {1, 3, 0, 2, 0};
+    if ((d.flags & kMappedFlag) != 0) {
+        const std::size_t entry = d.map_idx[kMapOf[static_cast<std::size_t>(wdl) + 2]] +
+                                  static_cast<std::size_t>(value);
+        value = (d.flags & kWideFlag) != 0 ? loadLe<std::uint16_t>(table.dtz_map + 2 * entry)
+                                            : table.dtz_map[entry];
+    }
+    // Stored in moves unless flagged as plies; cursed results always in moves
+    if ((wdl == Wdl::Win && (d.flags & kWinPliesFlag) == 0) ||
+        (wdl == Wdl::Loss && (d.flags & kLossPliesFlag) == 0) || wdl == Wdl::CursedWin ||
+        wdl == Wdl::BlessedLoss) {
+        value *= 2;
+    }
+    return value + 1;
+}
+
+// ============================================================================
+// Probing Helpers
+// ============================================================================
+
+[[nodiscard]] constexpr int signOf(int value) noexcept {
+    return (value > 0) - (value < 0);
+}
+
+/// DTZ of a position whose best move is a capture or pawn move.
+[[nodiscard]] constexpr int dtzBeforeZeroing(Wdl wdl) noexcept {
+    switch (wdl) {
+        case Wdl::Win:         return kDtzZeroingWin;
+        case Wdl::CursedWin:   return kDtzCursed;
+        case Wdl::BlessedLoss: return -kDtzCursed;
+        case Wdl::Loss:        return -kDtzZeroingWin;
+        case Wdl::Draw:        return 0;
+    }
+    return 0;
+}
+
+[[nodiscard]] constexpr Wdl wdlOfDtz(int dtz) noexcept {
+    if (dtz > kFiftyMovePlies) return Wdl::CursedWin;
+    if (dtz > 0) return Wdl::Win;
+    if (dtz < -kFiftyMovePlies) return Wdl::BlessedLoss;
+    if (dtz < 0) return Wdl::Loss;
+    return Wdl::Draw;
+}
+
+/// Captures and pawn moves reset the fifty-move counter.
+[[nodiscard]] bool isZeroing(const Board& board, const Move& move) noexcept {
+    return move.en_passant || board.hasPieceAt(move.to) ||
+           board.at(move.from)->type == PieceType::Pawn;
+}
+
+} // namespace
+
+// ============================================================================
+// Tables
+// ============================================================================
+
+struct Tablebase::Table {
+    TableShape shape;
+    TableFile wdl;
+    TableFile dtz;
+};
+
+enum class Tablebase::ProbeState : std::uint8_t {
+    Ok,
+    Fail,             ///< A table is missing or corrupt
+    ZeroingBestMove,  ///< Best move is a capture or pawn move; DTZ holds no value
+    ChangeSide        ///< DTZ is stored for the other side to move only
+};
+
+Tablebase::Tablebase(std::string_view paths) {
+    // Only names are read here; files are mapped by the first probe needing them
+    std::vector<std::pair<std::string, std::filesystem::path>> wdl_files;
+    std::unordered_map<std::string, std::filesystem::path> dtz_files;
+    while (!paths.empty()) {
+        const auto end = std::min(paths.find(kPathSeparator), paths.size());
+        const std::filesystem::path directory{paths.substr(0, end)};
+        paths.remove_prefix(std::min(end + 1, paths.size()));
+
+        std::error_code error;
+        for (std::filesystem::directory_iterator it(directory, error), last; !error && it != last;
+             it.increment(error)) {
+            const std::filesystem::path& path = it->path();
+            if (path.extension() == ".rtbw") {
+                wdl_files.emplace_back(path.stem().string(), path);
+            } else if (path.extension() == ".rtbz") {
+                dtz_files.emplace(path.stem().string(), path);
+            }
+        }
+    }
+
+    for (const auto& [code, path] : wdl_files) {
+        const auto counts = syzygy::parseMaterial(code);
+        if (!counts) continue;
+        auto table = std::make_unique<Table>();
+        table->shape = syzygy::shapeOf(*counts);
+        if (table->shape.piece_count == 2) continue;  // Bare kings need no table
+        if (by_material_.contains(table->shape.key)) continue;  // Earlier directory wins
+
+        table->wdl.path = path;
+        if (const auto dtz = dtz_files.find(code); dtz != dtz_files.end()) {
+            table->dtz.path = dtz->second;
+        }
+        by_material_.emplace(table->shape.key, table.get());
+        by_material_.emplace(table->shape.key2, table.get());
+        max_pieces_ = std::max(max_pieces_, table->shape.piece_count);
+        tables_.push_back(std::move(table));
+    }
+}
+
+Tablebase::~Tablebase() = default;
+
+// ============================================================================
+// Probing
+// ============================================================================
+
+bool Tablebase::covers(const Board& board) const noexcept {
+    return chess::popCount(board.occupied()) <= max_pieces_ &&
+           std::ranges::none_of(board.castlingRights(), [](bool right) { return right; });
+}
+
+std::optional<Wdl> Tablebase::probeWdl(const Board& board, Color side) const {
+    if (!covers(board)) return std::nullopt;
+    Board scratch = board;
+    ProbeState state = ProbeState::Ok;
+    const Wdl value = search(scratch, side, false, state);
+    return state != ProbeState::Fail ? std::optional{value} : std::nullopt;
+}
+
+std::optional<int> Tablebase::probeDtz(const Board& board, Color side) const {
+    if (!covers(board)) return std::nullopt;
+    Board scratch = board;
+    ProbeState state = ProbeState::Ok;
+    const int value = dtz(scratch, side, state);
+    return state != ProbeState::Fail ? std::optional{value} : std::nullopt;
+}
+
+std::optional<TablebaseMove> Tablebase::probeRoot(const Board& board, Color side) const {
+    if (!covers(board)) return std::nullopt;
+    Board scratch = board;
+    const chess::Rules rules;
+    chess::MoveList moves;
+    rules.legalMoves(scratch, side, moves);
+
+    std::optional<TablebaseMove> best;
+    for (const Move& move : moves) {
+        const bool zeroing = isZeroing(scratch, move);
+        const chess::UndoInfo undo = scratch.makeMove(move);
+        const Color opponent = chess::opponent(side);
+
+        // DTZ counted from the root: one more ply than after the move
+        ProbeState state = ProbeState::Ok;
+        int value = 0;
+        if (zeroing) {
+            value = dtzBeforeZeroing(-search(scratch, opponent, false, state));
+        } else {
+            value = -dtz(scratch, opponent, state);
+            value += signOf(value);
+        }
+        if (value == 2 && rules.isCheckmate(scratch, opponent)) value = 1;
+        scratch.unmakeMove(move, undo);
+        if (state == ProbeState::Fail) return std::nullopt;
+
+        // Better result first; then the fastest win or the slowest loss,
+        // both of which are the smallest DTZ
+        const TablebaseMove candidate{.move = move, .wdl = wdlOfDtz(value), .dtz = value};
+        if (!best || candidate.wdl > best->wdl ||
+            (candidate.wdl == best->wdl && candidate.dtz < best->dtz)) {
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+std::optional<Wdl> Tablebase::adjudicate(const Board& board, Color side,
+                                         int halfmove_clock) const {
+    const auto wdl = probeWdl(board, side);
+    if (!wdl) return std::nullopt;
+    if (*wdl != Wdl::Win && *wdl != Wdl::Loss) return Wdl::Draw;
+    if (halfmove_clock <= 0) return wdl;
+
+    // Moves already played without progress may let the counter run out
+    const auto distance = probeDtz(board, side);
+    if (!distance) return std::nullopt;
+    return fiftyMoveResult(*wdl, *distance, halfmove_clock);
+}
+
+Wdl Tablebase::fiftyMoveResult(Wdl wdl, int dtz, int halfmove_clock) noexcept {
+    if (wdl != Wdl::Win && wdl != Wdl::Loss) return Wdl::Draw;
+    return std::abs(dtz) + std::max(halfmove_clock, 0) <= kFiftyMovePlies ? wdl : Wdl::Draw;
+}
+
+Wdl Tablebase::search(Board& board, Color side, bool zeroing_moves, ProbeState& state) const {
+    // Resolve captures (and for DTZ pawn moves) by search: the tables do not
+    // store positions whose best move is one. En-passant is a capture here.
+    const chess::Rules rules;
+    chess::MoveList moves;
+    rules.legalMoves(board, side, moves);
+
+    Wdl best = Wdl::Loss;
+    std::size_t searched = 0;
+    for (const Move& move : moves) {
+        const bool capture = move.en_passant || board.hasPieceAt(move.to);
+        if (!capture && (!zeroing_moves || board.at(move.from)->type != PieceType::Pawn)) {
+            continue;
+        }
+        ++searched;
+        const chess::UndoInfo undo = board.makeMove(move);
+        const Wdl value = -search(board, chess::opponent(side), false, state);
+        board.unmakeMove(move, undo);
+        if (state == ProbeState::Fail) return Wdl::Draw;
+
+        if (value > best) {
+            best = value;
+            if (value >= Wdl::Win) {
+                state = ProbeState::ZeroingBestMove;
+                return value;
+            }
+        }
+    }
+
+    // With every move searched the stored value is not needed (and may be
+    // wrong, e.g. with en-passant rights)
+    const bool searched_all = searched != 0 && searched == moves.size();
+    Wdl value = best;
+    if (!searched_all) {
+        value = static_cast<Wdl>(probeTable(board, side, false, Wdl::Draw, state));
+        if (state == ProbeState::Fail) return Wdl::Draw;
+    }
+    if (best >= value) {
+        state = best > Wdl::Draw || searched_all ? ProbeState::ZeroingBestMove : ProbeState::Ok;
+        return best;
+    }
+    state = ProbeState::Ok;
+    return value;
+}
+
+int Tablebase::dtz(Board& board, Color side, ProbeState& state) const {
+    state = ProbeState::Ok;
+    const Wdl wdl = search(board, side, true, state);
+    if (state == ProbeState::Fail || wdl == Wdl::Draw) return 0;  // Draws are not stored
+    if (state == ProbeState::ZeroingBestMove) return dtzBeforeZeroing(wdl);
+
+    const int stored = probeTable(board, side, true, wdl, state);
+    if (state == ProbeState::Fail) return 0;
+    const int sign = signOf(static_cast<int>(wdl));
+    if (state != ProbeState::ChangeSide) {
+        const bool cursed = wdl == Wdl::CursedWin || wdl == Wdl::BlessedLoss;
+        return (stored + (cursed ? kFiftyMovePlies : 0)) * sign;
+    }
+
+    // Stored for the other side: take the best DTZ one ply down
+    const chess::Rules rules;
+    chess::MoveList moves;
+    rules.legalMoves(board, side, moves);
+    constexpr int kNone = 0xFFFF;
+    int best = kNone;
+    for (const Move& move : moves) {
+        const bool zeroing = isZeroing(board, move);
+        const chess::UndoInfo undo = board.makeMove(move);
+        const Color opponent = chess::opponent(side);
+
+        // A zeroing move's DTZ is that of the move itself; search the
+        // position after it only for the sign
+        int value = zeroing ? -dtzBeforeZeroing(search(board, opponent, false, state))
+                            : -dtz(board, opponent, state);
+        if (value == 1 && rules.isCheckmate(board, opponent)) best = 1;
+        if (!zeroing) value += signOf(value);
+        if (value < best && signOf(value) == sign) best = value;
+
+        board.unmakeMove(move, undo);
+        if (state == ProbeState::Fail) return 0;
+    }
+    return best == kNone ? -1 : best;  // No legal move: mated
+}
+
+int Tablebase::probeTable(const Board& board, Color side, bool dtz, Wdl wdl,
+                          ProbeState& state) const {
+    const Bitboard occupied = board.occupied();
+    if (chess::popCount(occupied) == 2) return static_cast<int>(Wdl::Draw);  // Bare kings
+
+    const std::uint64_t material = syzygy::materialKey(board);
+    const auto found = by_material_.find(material);
+    if (found == by_material_.end()) {
+        state = ProbeState::Fail;
+        return 0;
+    }
+    Table& table = *found->second;
+    const TableShape& shape = table.shape;
+    TableFile& file = dtz ? table.dtz : table.wdl;
+    if (!ensureLoaded(shape, file, dtz)) {
+        state = ProbeState::Fail;
+        return 0;
+    }
+
+    const syzygy::Placement placement =
+        syzygy::placementOf(board, side, shape, file.items[0][0].layout.pieces[0]);
+    const int stm = placement.stored_side;
+    if (dtz && (file.items[0][placement.lead_file].flags & kStmFlag) != stm &&
+        (shape.key != shape.key2 || shape.has_pawns)) {
+        state = ProbeState::ChangeSide;
+        return 0;
+    }
+
+    const PairsData& d = file.items[dtz ? 0 : stm][placement.lead_file];
+    const std::uint64_t idx = syzygy::encode(shape, d.layout, placement);
+    const int value = decompress(d, idx);
+    return dtz ? mapDtz(file, d, value, wdl) : value - 2;
+}
+
+} // namespace engine
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "core/Board.hpp"
+#include "core/Move.hpp"
+
+/// @file Tablebase.hpp
+/// @brief Syzygy endgame tablebase probing (WDL and DTZ), mapped on demand.
+
+namespace engine {
+
+/// Game-theoretic value of a position for the side to move.
+enum class Wdl : std::int8_t {
+    Loss = -2,
+    BlessedLoss = -1,  ///< Lost, but saved by the fifty-move rule
+    Draw = 0,
+    CursedWin = 1,     ///< Won, but drawn by the fifty-move rule
+    Win = 2
+};
+
+[[nodiscard]] constexpr Wdl operator-(Wdl value) noexcept {
+    return static_cast<Wdl>(-static_cast<int>(value));
+}
+
+/// Best move of a tablebase position.
+struct TablebaseMove {
+    chess::Move move;
+    Wdl wdl{Wdl::Draw};  ///< Value of the position before the move
+    /// Plies to the next capture or pawn move with optimal play; negative when
+    /// losing, beyond +-100 for cursed wins and blessed losses, 0 for draws.
+    int dtz{0};
+};
+
+/// Syzygy tablebases (the `.rtbw` WDL and `.rtbz` DTZ files) of a set of
+/// directories.
+///
+/// Construction only lists the directories. A table file is memory-mapped
+/// the first time a position needs it, so startup costs nothing however
+/// large the set is, and processes probing the same files share their pages
+/// through the OS page cache. Positions with castling rights are never in
+/// the tables; captures and en-passant are resolved by a small search, as
+/// the format requires.
+///
+/// @note All member functions are thread-safe.
+class Tablebase {
+public:
+    static constexpr int kMaxPieces = 7;
+
+    /// @param paths Directories separated by ':' (';' on Windows)
+    explicit Tablebase(std::string_view paths);
+    ~Tablebase();
+
+    Tablebase(const Tablebase&) = delete;
+    Tablebase& operator=(const Tablebase&) = delete;
+    Tablebase(Tablebase&&) = delete;
+    Tablebase& operator=(Tablebase&&) = delete;
+
+    /// WDL tables found.
+    [[nodiscard]] std::size_t tableCount() const noexcept { return tables_.size(); }
+
+    /// Most pieces (kings included) of any table found; 0 if there is none.
+    [[nodiscard]] int maxPieces() const noexcept { return max_pieces_; }
+
+    /// Whether the position is small enough and has no castling rights.
+    /// Cheap; a probe can still fail if a table is missing or corrupt.
+    [[nodiscard]] bool covers(const chess::Board& board) const noexcept;
+
+    /// Value of the position, assuming the fifty-move counter was just reset.
+    /// @return nullopt if a table needed is missing or the position is not covered
+    [[nodiscard]] std::optional<Wdl> probeWdl(const chess::Board& board, chess::Color side) const;
+
+    /// Distance to zeroing (see TablebaseMove::dtz) of the position.
+    /// @return nullopt if a table needed is missing or the position is not covered
+    [[nodiscard]] std::optional<int> probeDtz(const chess::Board& board, chess::Color side) const;
+
+    /// The move keeping the best result: the fastest win, any draw, or the
+    /// slowest loss, measured by DTZ.
+    /// @return nullopt if not covered, a table is missing, or there is no legal move
+    [[nodiscard]] std::optional<TablebaseMove> probeRoot(const chess::Board& board,
+                                                         chess::Color side) const;
+
+    /// Result under the fifty-move rule given the plies already played since
+    /// the last capture or pawn move: Win, Draw or Loss.
+    /// @return nullopt if a table needed is missing or the position is not covered
+    [[nodiscard]] std::optional<Wdl> adjudicate(const chess::Board& board, chess::Color side,
+                                                int halfmove_clock) const;
+
+    /// adjudicate() for a position of value `wdl` at distance `dtz` (see
+    /// TablebaseMove::dtz): a win or loss stands only if the zeroing move
+    /// comes within 100 plies of the last one; anything else is a draw.
+    [[nodiscard]] static Wdl fiftyMoveResult(Wdl wdl, int dtz, int halfmove_clock) noexcept;
+
+private:
+    struct Table;
+    enum class ProbeState : std::uint8_t;
+
+    /// WDL value with captures (and pawn moves if `zeroing_moves`) searched;
+    /// sets ZeroingBestMove when one of them is best. Draw on failure.
+    [[nodiscard]] Wdl search(chess::Board& board, chess::Color side, bool zeroing_moves,
+                             ProbeState& state) const;
+    [[nodiscard]] int dtz(chess::Board& board, chess::Color side, ProbeState& state) const;
+    [[nodiscard]] int probeTable(const chess::Board& board, chess::Color side, bool dtz,
+                                 Wdl wdl, ProbeState& state) const;
+
+    std::vector<std::unique_ptr<Table>> tables_;
+    std::unordered_map<std::uint64_t, Table*> by_material_;  // Both colorings of each table
+    int max_pieces_{0};
+};
+
+} // namespace engine
@@ -0,0 +1,127 @@
+#include "TranspositionTable.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace engine {
+
+namespace {
+
+constexpr std::size_t kBytesPerMb = std::size_t{1} << 20;
+
+/// Entries this much shallower than the stored one may still overwrite it,
+/// so the table keeps refreshing with recent results.
+constexpr int kReplaceDepthMargin = 2;
+
+constexpr int kHashfullSample = 1000;
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+TranspositionTable::TranspositionTable(std::size_t size_mb) {
+    resize(size_mb);
+}
+
+void TranspositionTable::resize(std::size_t size_mb) {
+    const std::size_t budget = std::max<std::size_t>(size_mb, 1) * kBytesPerMb;
+    const std::size_t count = std::bit_floor(budget / sizeof(Slot));
+
+    slots_ = std::make_unique<Slot[]>(count);
+    slot_count_ = count;
+    generation_ = 0;
+}
+
+void TranspositionTable::clear() noexcept {
+    for (std::size_t i = 0; i < slot_count_; ++i) {
+        slots_[i].key_xor_data.store(0, std::memory_order_relaxed);
+        slots_[i].data.store(0, std::memory_order_relaxed);
+    }
+    generation_ = 0;
+}
+
+// ============================================================================
+// Probe / Store
+// ============================================================================
+
+std::uint64_t TranspositionTable::load(const Slot& slot, chess::zobrist::Key key) const noexcept {
+    const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+    const std::uint64_t key_xor_data = slot.key_xor_data.load(std::memory_order_relaxed);
+    return (key_xor_data ^ data) == key ? data : 0;
+}
+
+std::optional<TTEntry> TranspositionTable::probe(chess::zobrist::Key key) const noexcept {
+    const std::uint64_t data = load(slots_[indexOf(key)], key);
+    if (data == 0) {
+        return std::nullopt;
+    }
+    return unpack(data);
+}
+
+void TranspositionTable::store(chess::zobrist::Key key, chess::PackedMove move, int score,
+                               int depth, Bound bound) noexcept {
+    Slot& slot = slots_[indexOf(key)];
+
+    if (const std::uint64_t old_data = load(slot, key); old_data != 0) {
+        const TTEntry old = unpack(old_data);
+        const bool same_search = generationOf(old_data) == generation_;
+        if (same_search && bound != Bound::Exact && depth + kReplaceDepthMargin < old.depth) {
+            return;
+        }
+        // A fail-low result has no best move; keep the one we already know
+        if (move.isNull()) {
+            move = old.move;
+        }
+    } else if (const std::uint64_t other = slot.data.load(std::memory_order_relaxed);
+               other != 0 && generationOf(other) == generation_ &&
+               depth < unpack(other).depth) {
+        // Another position searched deeper in this search keeps the slot. A torn
+        // word only skews this decision; probes still reject it.
+        return;
+    }
+
+    const std::uint64_t data = pack(move, score, depth, bound, generation_);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.key_xor_data.store(key ^ data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const noexcept {
+    const int sample = static_cast<int>(std::min<std::size_t>(kHashfullSample, slot_count_));
+    int used = 0;
+    for (int i = 0; i < sample; ++i) {
+        const std::uint64_t data =
+            slots_[static_cast<std::size_t>(i)].data.load(std::memory_order_relaxed);
+        if (data != 0 && generationOf(data) == generation_) {
+            ++used;
+        }
+    }
+    return used * kHashfullSample / sample;
+}
+
+// ============================================================================
+// Entry Encoding
+// ============================================================================
+
+std::uint64_t TranspositionTable::pack(chess::PackedMove move, int score, int depth, Bound bound,
+                                       std::uint8_t generation) noexcept {
+    const auto score_bits = static_cast<std::uint16_t>(static_cast<std::int16_t>(score));
+    const auto depth_bits = static_cast<std::uint8_t>(std::clamp(depth, 0, 255));
+
+    return std::uint64_t{move.raw()} |
+           (std::uint64_t{score_bits} << 16) |
+           (std::uint64_t{depth_bits} << 32) |
+           (std::uint64_t{static_cast<std::uint8_t>(bound)} << 40) |
+           (std::uint64_t{generation} << 48);
+}
+
+TTEntry TranspositionTable::unpack(std::uint64_t data) noexcept {
+    return TTEntry{
+        .move = chess::PackedMove::fromRaw(static_cast<std::uint16_t>(data)),
+        .score = static_cast<std::int16_t>(static_cast<std::uint16_t>(data >> 16)),
+        .depth = static_cast<std::uint8_t>(data >> 32),
+        .bound = static_cast<Bound>(static_cast<std::uint8_t>(data >> 40)),
+    };
+}
+
+} // namespace engine
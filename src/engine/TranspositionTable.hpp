@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include "core/PackedMove.hpp"
+#include "core/Zobrist.hpp"
+
+/// @file TranspositionTable.hpp
+/// @brief Fixed-size hash table of search results keyed by Zobrist key.
+
+namespace engine {
+
+/// How a stored score relates to the true value of the position.
+enum class Bound : std::uint8_t {
+    None,
+    Upper,  ///< Fail-low: true score <= stored score
+    Lower,  ///< Fail-high: true score >= stored score
+    Exact
+};
+
+/// Decoded table entry returned by TranspositionTable::probe().
+struct TTEntry {
+    chess::PackedMove move{};
+    int score{0};
+    int depth{0};
+    Bound bound{Bound::None};
+};
+
+/// Single-entry-per-slot transposition table with depth/age replacement.
+///
+/// Each slot is two 64-bit words: the packed entry data and the key XORed
+/// with that data, so a probe is one index computation and one cache line.
+/// Search threads share the table without locks: both words are relaxed
+/// atomics, and a slot torn by concurrent writers fails the XOR check and
+/// reads as a miss instead of returning another position's entry.
+/// The slot count is the largest power of two that fits the memory budget.
+///
+/// probe()/store() may run concurrently from any number of threads;
+/// resize(), clear() and newSearch() must not overlap with them.
+class TranspositionTable {
+public:
+    static constexpr std::size_t kDefaultSizeMb = 16;
+
+    explicit TranspositionTable(std::size_t size_mb = kDefaultSizeMb);
+
+    /// Reallocate to a new memory budget, discarding all entries.
+    /// @note A budget of 0 is treated as the minimum table size.
+    void resize(std::size_t size_mb);
+
+    /// Discard all entries.
+    void clear() noexcept;
+
+    /// Start a new search: entries from older searches become preferred
+    /// replacement victims.
+    void newSearch() noexcept { generation_ = static_cast<std::uint8_t>(generation_ + 1); }
+
+    /// Look up a position.
+    /// @return The stored entry, or nullopt if the slot holds another position
+    [[nodiscard]] std::optional<TTEntry> probe(chess::zobrist::Key key) const noexcept;
+
+    /// Store a search result. Keeps the existing entry when it belongs to the
+    /// same search and was searched deeper: meaningfully deeper for the same
+    /// position, deeper at all for another position sharing the slot.
+    /// @pre score fits in 16 bits (mate scores already ply-adjusted)
+    void store(chess::zobrist::Key key, chess::PackedMove move, int score, int depth,
+               Bound bound) noexcept;
+
+    /// Permille of sampled slots written during the current search (UCI hashfull).
+    [[nodiscard]] int hashfull() const noexcept;
+
+    [[nodiscard]] std::size_t slotCount() const noexcept { return slot_count_; }
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> key_xor_data{0};
+        std::atomic<std::uint64_t> data{0};
+    };
+
+    // data layout: move 0-15, score 16-31, depth 32-39, bound 40-47, generation 48-55
+    [[nodiscard]] static std::uint64_t pack(chess::PackedMove move, int score, int depth,
+                                            Bound bound, std::uint8_t generation) noexcept;
+    [[nodiscard]] static TTEntry unpack(std::uint64_t data) noexcept;
+    [[nodiscard]] static std::uint8_t generationOf(std::uint64_t data) noexcept {
+        return static_cast<std::uint8_t>(data >> 48);
+    }
+
+    [[nodiscard]] std::size_t indexOf(chess::zobrist::Key key) const noexcept {
+        return static_cast<std::size_t>(key) & (slot_count_ - 1);
+    }
+
+    /// Data word of the slot if it holds `key`, otherwise 0 (empty).
+    [[nodiscard]] std::uint64_t load(const Slot& slot, chess::zobrist::Key key) const noexcept;
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t slot_count_{0};
+    std::uint8_t generation_{0};
+};
+
+} // namespace engine
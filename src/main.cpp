@@ -1,6 +1,7 @@
 ﻿#include <SFML/Graphics.hpp>
 #include "Config.hpp"
 #include "core/ChessGame.hpp"
+#include "engine/AsyncEngine.hpp"
 #include "ui/SfmlRenderer.hpp"
 #include "ui/SfmlInputHandler.hpp"
 #include "app/Application.hpp"
@@ -16,10 +17,17 @@ int main() {
     auto renderer = std::make_unique<ui::SfmlRenderer>(window);
     auto input_handler = std::make_unique<ui::SfmlInputHandler>(window);
 
+    std::unique_ptr<engine::AsyncEngine> background_engine;
+    if (config::kEngineMode != config::EngineMode::Off) {
+        background_engine = std::make_unique<engine::AsyncEngine>(config::kEngineHashMb,
+                                                                  config::kEngineThreads);
+    }
+
     app::Application application(
         std::move(game),
         std::move(renderer),
-        std::move(input_handler)
+        std::move(input_handler),
+        std::move(background_engine)
     );
     application.run();
 
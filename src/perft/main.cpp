@@ -0,0 +1,218 @@
+#include "batch/PositionBatch.hpp"
+#include "core/Fen.hpp"
+#include "core/Notation.hpp"
+#include "core/Perft.hpp"
+#include "core/Rules.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+#include <utility>
+#include <vector>
+#include <string_view>
+
+/// @file main.cpp
+/// @brief Perft driver: validates Rules::legalMoves against published node
+/// counts and reports throughput.
+///
+/// Usage:
+///   perft                  Full suite, exits non-zero on any mismatch
+///   perft --quick          Reduced depths (used by CTest)
+///   perft --batch          batch::analyzePositions against Rules on every
+///                          node of the suite trees (used by CTest)
+///   perft <fen> <depth>    Divide: per-move node counts for one position
+
+namespace {
+
+struct PerftCase {
+    std::string_view name;
+    std::string_view fen;
+    std::array<std::uint64_t, 6> nodes;  ///< Expected counts for depth 1..6 (0 = not run)
+    int quick_depth;
+};
+
+// Reference counts from the Chess Programming Wiki "Perft Results" page.
+constexpr std::array<PerftCase, 6> kSuite = {{
+    {"startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+     {20, 400, 8902, 197281, 4865609, 119060324}, 4},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+     {48, 2039, 97862, 4085603, 193690690, 0}, 3},
+    {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+     {14, 191, 2812, 43238, 674624, 11030083}, 4},
+    {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+     {6, 264, 9467, 422333, 15833292, 0}, 4},
+    {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+     {44, 1486, 62379, 2103487, 89941194, 0}, 3},
+    {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+     {46, 2079, 89890, 3894594, 164075551, 0}, 3},
+}};
+
+/// Trees the suite lacks, for the batch check: stalemates, and en-passant
+/// captures that are illegal because they expose the king along a rank or
+/// a diagonal.
+constexpr std::array<std::pair<std::string_view, int>, 4> kBatchExtras = {{
+    {"7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", 2},
+    {"k7/8/1Q6/8/8/8/8/7K w - - 0 1", 4},
+    {"8/8/8/KPp4r/8/8/8/7k w - c6 0 1", 4},
+    {"8/8/3k4/8/2pP4/8/8/B3K3 b - d3 0 1", 4},
+}};
+
+using Clock = std::chrono::steady_clock;
+
+[[nodiscard]] double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// @return true if every count matched
+[[nodiscard]] bool runSuite(bool quick) {
+    bool all_passed = true;
+    std::uint64_t total_nodes = 0;
+    double total_seconds = 0.0;
+
+    for (const auto& test : kSuite) {
+        auto position = chess::parseFen(test.fen);
+        if (!position) {
+            std::cerr << test.name << ": invalid FEN\n";
+            return false;
+        }
+
+        for (int depth = 1; depth <= static_cast<int>(test.nodes.size()); ++depth) {
+            const std::uint64_t expected = test.nodes[depth - 1];
+            if (expected == 0 || (quick && depth > test.quick_depth)) break;
+
+            const auto start = Clock::now();
+            const std::uint64_t nodes = chess::perft(position->board, position->side_to_move, depth);
+            const double seconds = secondsSince(start);
+
+            total_nodes += nodes;
+            total_seconds += seconds;
+
+            const bool passed = (nodes == expected);
+            all_passed = all_passed && passed;
+            std::cout << (passed ? "ok   " : "FAIL ") << test.name << " depth " << depth
+                      << ": " << nodes;
+            if (!passed) std::cout << " (expected " << expected << ")";
+            std::cout << "\n";
+        }
+    }
+
+    const double nps = total_seconds > 0.0 ? static_cast<double>(total_nodes) / total_seconds : 0.0;
+    std::cout << "\nTotal: " << total_nodes << " nodes in " << total_seconds << " s ("
+              << static_cast<std::uint64_t>(nps) << " nps)\n";
+    return all_passed;
+}
+
+/// Every position in the tree below `board` to `depth` plies, root included.
+void collectTree(chess::Board& board, chess::Color side, int depth,
+                 std::vector<std::pair<chess::Board, chess::Color>>& out) {
+    out.emplace_back(board, side);
+    if (depth == 0) return;
+
+    chess::MoveList moves;
+    chess::Rules{}.legalMoves(board, side, moves);
+    for (const chess::Move& move : moves) {
+        const chess::UndoInfo undo = board.makeMove(move);
+        collectTree(board, chess::opponent(side), depth - 1, out);
+        board.unmakeMove(move, undo);
+    }
+}
+
+[[nodiscard]] batch::PositionStatus rulesStatus(const chess::Board& board, chess::Color side,
+                                                std::size_t legal_moves) {
+    const bool check = chess::Rules{}.isCheck(board, side);
+    if (legal_moves == 0) {
+        return check ? batch::PositionStatus::Checkmate : batch::PositionStatus::Stalemate;
+    }
+    return check ? batch::PositionStatus::Check : batch::PositionStatus::Normal;
+}
+
+/// batch::analyzePositions duplicates Rules' pin, check and castling logic;
+/// this keeps the two in step.
+/// @return true if every position agreed
+[[nodiscard]] bool runBatchCheck() {
+    std::vector<std::pair<chess::Board, chess::Color>> nodes;
+    const auto collect = [&](std::string_view fen, int depth) {
+        auto position = chess::parseFen(fen);
+        if (!position) {
+            std::cerr << fen << ": invalid FEN\n";
+            return false;
+        }
+        collectTree(position->board, position->side_to_move, depth, nodes);
+        return true;
+    };
+    // One ply short of the quick suite keeps the batch to a few MB
+    for (const auto& test : kSuite) {
+        if (!collect(test.fen, test.quick_depth - 1)) return false;
+    }
+    for (const auto& [fen, depth] : kBatchExtras) {
+        if (!collect(fen, depth)) return false;
+    }
+
+    batch::PositionBatch positions;
+    positions.reserve(nodes.size());
+    for (const auto& [board, side] : nodes) positions.push_back(board, side);
+
+    // Small blocks so the parallel path splits the work
+    const auto start = Clock::now();
+    const batch::BatchAnalysis analysis =
+        batch::analyzePositions(positions, {.parallel = true, .block_size = 256});
+    const double seconds = secondsSince(start);
+
+    std::size_t mismatches = 0;
+    chess::MoveList moves;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        const auto& [board, side] = nodes[i];
+        chess::Rules{}.legalMoves(board, side, moves);
+        const batch::PositionStatus status = rulesStatus(board, side, moves.size());
+        if (analysis.legal_moves[i] == moves.size() && analysis.status[i] == status) continue;
+
+        if (++mismatches <= 10) {
+            std::cout << "FAIL " << chess::toFen(board, side).view() << ": "
+                      << static_cast<int>(analysis.legal_moves[i]) << " moves, status "
+                      << static_cast<int>(analysis.status[i]) << " (expected " << moves.size()
+                      << ", " << static_cast<int>(status) << ")\n";
+        }
+    }
+
+    std::cout << (mismatches == 0 ? "ok   " : "FAIL ") << "batch analysis: " << nodes.size()
+              << " positions in " << seconds << " s, " << mismatches << " mismatches\n";
+    return mismatches == 0;
+}
+
+[[nodiscard]] int runDivide(std::string_view fen, int depth) {
+    auto position = chess::parseFen(fen);
+    if (!position || depth < 1) {
+        std::cerr << "perft: invalid FEN or depth\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto start = Clock::now();
+    std::uint64_t total = 0;
+    for (const auto& entry : chess::perftDivide(position->board, position->side_to_move, depth)) {
+        std::cout << chess::toUci(entry.move) << ": " << entry.nodes << "\n";
+        total += entry.nodes;
+    }
+    const double seconds = secondsSince(start);
+
+    std::cout << "\nNodes: " << total << " in " << seconds << " s\n";
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::span<char*> args(argv, static_cast<std::size_t>(argc));
+
+    if (args.size() == 3) {
+        return runDivide(args[1], std::atoi(args[2]));
+    }
+
+    if (args.size() == 2 && std::string_view(args[1]) == "--batch") {
+        return runBatchCheck() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    const bool quick = args.size() == 2 && std::string_view(args[1]) == "--quick";
+    return runSuite(quick) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
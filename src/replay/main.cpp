@@ -0,0 +1,227 @@
+#include "batch/GameArchive.hpp"
+#include "batch/GameReplay.hpp"
+#include "core/Instrumentation.hpp"
+#include "core/MappedFile.hpp"
+#include "engine/OpeningBook.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <thread>
+
+/// @file main.cpp
+/// @brief Game replay driver: checks every move of a PGN collection or binary
+/// game archive against Rules::legalMoves and reports throughput.
+///
+/// Usage:
+///   pgn_replay <games.pgn|games.mcga> [--threads N] [--verbose]
+///              [--write-archive <out.mcga> [--encoding packed|index]]
+///              [--write-book <out.bin> [--book-plies N]] [--counters]
+///
+/// Games with a move that is not legal SAN are listed on stderr; --verbose
+/// also prints one line per game (in input order) on stdout. --write-archive
+/// converts PGN input into a binary archive (see GameArchive.hpp), skipping
+/// games that failed to replay. --write-book collects the first N plies of
+/// every game into an opening book (see OpeningBook.hpp). --counters prints
+/// the hot-path counters as JSON at the end (builds with CHESS_INSTRUMENT).
+
+namespace {
+
+constexpr std::string_view kUsage =
+    "usage: pgn_replay <games.pgn|games.mcga> [--threads N] [--verbose]\n"
+    "                  [--write-archive <out.mcga> [--encoding packed|index]]\n"
+    "                  [--write-book <out.bin> [--book-plies N]] [--counters]\n";
+
+struct Arguments {
+    std::string_view path;
+    int threads{1};
+    bool verbose{false};
+    std::string_view archive_path;
+    batch::MoveEncoding encoding{batch::MoveEncoding::Packed};
+    std::string_view book_path;
+    int book_plies{engine::OpeningBookBuilder::kDefaultMaxPlies};
+    bool counters{false};
+};
+
+[[nodiscard]] std::optional<Arguments> parseArguments(std::span<char*> args) {
+    Arguments parsed;
+    parsed.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        const std::string_view arg = args[i];
+        const bool has_value = i + 1 < args.size();
+        if (arg == "--threads" && has_value) {
+            parsed.threads = std::atoi(args[++i]);
+            if (parsed.threads < 1) return std::nullopt;
+        } else if (arg == "--verbose") {
+            parsed.verbose = true;
+        } else if (arg == "--counters") {
+            parsed.counters = true;
+        } else if (arg == "--write-archive" && has_value) {
+            parsed.archive_path = args[++i];
+        } else if (arg == "--write-book" && has_value) {
+            parsed.book_path = args[++i];
+        } else if (arg == "--book-plies" && has_value) {
+            parsed.book_plies = std::atoi(args[++i]);
+            if (parsed.book_plies < 1) return std::nullopt;
+        } else if (arg == "--encoding" && has_value) {
+            const std::string_view value = args[++i];
+            if (value == "packed") {
+                parsed.encoding = batch::MoveEncoding::Packed;
+            } else if (value == "index") {
+                parsed.encoding = batch::MoveEncoding::LegalIndex;
+            } else {
+                return std::nullopt;
+            }
+        } else if (parsed.path.empty() && !arg.starts_with("--")) {
+            parsed.path = arg;
+        } else {
+            return std::nullopt;
+        }
+    }
+    if (parsed.path.empty()) return std::nullopt;
+    return parsed;
+}
+
+[[nodiscard]] std::string_view toString(chess::GameResult result) noexcept {
+    switch (result) {
+        case chess::GameResult::WhiteWins: return "1-0";
+        case chess::GameResult::BlackWins: return "0-1";
+        case chess::GameResult::Draw:      return "1/2-1/2";
+        case chess::GameResult::Unknown:   return "*";
+    }
+    return "*";
+}
+
+[[nodiscard]] std::string_view toString(batch::FinalState state) noexcept {
+    switch (state) {
+        case batch::FinalState::Ongoing:   return "ongoing";
+        case batch::FinalState::Checkmate: return "checkmate";
+        case batch::FinalState::Stalemate: return "stalemate";
+    }
+    return "ongoing";
+}
+
+void printReport(const batch::GameReport& report, bool verbose) {
+    if (!report.ok()) {
+        std::cerr << "game " << report.index + 1 << ": invalid move '" << report.error
+                  << "' after " << report.plies << " plies\n";
+    }
+    if (verbose) {
+        std::cout << report.index + 1 << ' ' << toString(report.result) << ' ' << report.plies
+                  << ' ' << toString(report.final_state) << ' ' << std::hex << report.final_key
+                  << std::dec << '\n';
+    }
+}
+
+void printStats(const batch::ReplayStats& stats, int threads) {
+    const double seconds = stats.elapsed.count();
+    const double plies_per_second =
+        seconds > 0.0 ? static_cast<double>(stats.plies) / seconds : 0.0;
+    std::cout << "Games: " << stats.games << " (" << stats.failed << " failed), "
+              << stats.plies << " plies in " << seconds << " s with " << threads
+              << " threads\n"
+              << "Throughput: " << static_cast<std::uint64_t>(stats.gamesPerSecond())
+              << " games/s, " << static_cast<std::uint64_t>(plies_per_second) << " plies/s\n";
+}
+
+void printCounters(const Arguments& args) {
+    if (!args.counters) return;
+    if (!chess::instrument::kEnabled) {
+        std::cerr << "pgn_replay: --counters needs a build with -DCHESS_INSTRUMENT=ON\n";
+    }
+    chess::instrument::writeJson(std::cout, chess::instrument::snapshot());
+}
+
+[[nodiscard]] int replayArchiveFile(const batch::GameArchiveReader& archive,
+                                    const Arguments& args) {
+    if (!args.archive_path.empty() || !args.book_path.empty()) {
+        std::cerr << "pgn_replay: --write-archive and --write-book need PGN input\n";
+        return EXIT_FAILURE;
+    }
+    const auto stats = batch::replayArchive(
+        archive, {.threads = args.threads},
+        [&](const batch::GameReport& report) { printReport(report, args.verbose); });
+    printStats(stats, args.threads);
+    return stats.failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+[[nodiscard]] int replayPgnFile(const chess::MappedFile& file, const Arguments& args) {
+    std::optional<batch::GameArchiveWriter> writer;
+    if (!args.archive_path.empty()) {
+        writer = batch::GameArchiveWriter::create(args.archive_path, args.encoding);
+        if (!writer) {
+            std::cerr << "pgn_replay: cannot create " << args.archive_path << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::optional<engine::OpeningBookBuilder> book;
+    if (!args.book_path.empty()) book.emplace(args.book_plies);
+
+    bool archive_ok = true;
+    const auto stats = batch::replayGames(
+        file.text(), {.threads = args.threads, .keep_moves = writer || book},
+        [&](const batch::GameReport& report) {
+            printReport(report, args.verbose);
+            if (!report.ok()) return;
+            if (writer) {
+                archive_ok &= writer->addGame(report.moves, report.result, report.start_fen);
+            }
+            if (book) {
+                static_cast<void>(book->addGame(report.moves, report.result, report.start_fen));
+            }
+        });
+    printStats(stats, args.threads);
+
+    if (writer) {
+        archive_ok &= writer->finish();
+        if (!archive_ok) {
+            std::cerr << "pgn_replay: failed to write " << args.archive_path << "\n";
+            return EXIT_FAILURE;
+        }
+        std::error_code error;
+        const auto archive_size = std::filesystem::file_size(args.archive_path, error);
+        std::cout << "Archive: " << writer->gameCount() << " games, " << archive_size
+                  << " bytes (PGN " << file.size() << " bytes)\n";
+    }
+
+    if (book) {
+        if (!book->write(args.book_path)) {
+            std::cerr << "pgn_replay: failed to write " << args.book_path << "\n";
+            return EXIT_FAILURE;
+        }
+        const auto entries = engine::OpeningBook::open(args.book_path);
+        std::cout << "Book: " << (entries ? entries->size() : 0) << " entries from "
+                  << book->sampleCount() << " moves\n";
+    }
+    return stats.failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const auto args = parseArguments(std::span<char*>(argv, static_cast<std::size_t>(argc)));
+    if (!args) {
+        std::cerr << kUsage;
+        return EXIT_FAILURE;
+    }
+
+    if (const auto archive = batch::GameArchiveReader::open(args->path)) {
+        const int status = replayArchiveFile(*archive, *args);
+        printCounters(*args);
+        return status;
+    }
+
+    const auto file = chess::MappedFile::open(args->path);
+    if (!file) {
+        std::cerr << "pgn_replay: cannot open " << args->path << "\n";
+        return EXIT_FAILURE;
+    }
+    const int status = replayPgnFile(*file, *args);
+    printCounters(*args);
+    return status;
+}
@@ -0,0 +1,84 @@
+#include "CompactPosition.hpp"
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+namespace server {
+
+namespace {
+
+constexpr std::uint8_t kEmptyCode = 0;
+constexpr std::uint8_t kBlackCodeOffset = 8;
+constexpr int kNibbleBits = 4;
+constexpr std::uint8_t kNibbleMask = 0x0f;
+constexpr std::uint8_t kCastlingMask = 0x0f;
+
+[[nodiscard]] std::uint8_t encodePiece(const std::optional<chess::Piece>& piece) noexcept {
+    if (!piece) return kEmptyCode;
+    const auto code = static_cast<std::uint8_t>(1 + static_cast<int>(piece->type));
+    return piece->color == chess::Color::Black ? code + kBlackCodeOffset : code;
+}
+
+[[nodiscard]] std::optional<chess::Piece> decodePiece(std::uint8_t code) noexcept {
+    if (code == kEmptyCode) return std::nullopt;
+    const bool black = code >= kBlackCodeOffset;
+    return chess::Piece{
+        .type = static_cast<chess::PieceType>((black ? code - kBlackCodeOffset : code) - 1),
+        .color = black ? chess::Color::Black : chess::Color::White,
+    };
+}
+
+template <typename Field>
+[[nodiscard]] Field saturate(int value) noexcept {
+    return static_cast<Field>(std::clamp<int>(value, 0, std::numeric_limits<Field>::max()));
+}
+
+} // namespace
+
+CompactPosition pack(const chess::Board& board, chess::Color side, int halfmove_clock,
+                     int fullmove_number) noexcept {
+    CompactPosition position{
+        .key = chess::positionKey(board, side),
+        .fullmove_number = saturate<std::uint16_t>(fullmove_number),
+        .halfmove_clock = saturate<std::uint8_t>(halfmove_clock),
+    };
+
+    for (int index = 0; index < chess::kSquareCount; index += 2) {
+        const std::uint8_t low = encodePiece(board.at(index));
+        const std::uint8_t high = encodePiece(board.at(index + 1));
+        position.squares[index / 2] = static_cast<std::uint8_t>(low | (high << kNibbleBits));
+    }
+
+    const chess::CastlingRights& rights = board.castlingRights();
+    for (std::size_t i = 0; i < rights.size(); ++i) {
+        if (rights[i]) position.flags |= static_cast<std::uint8_t>(1u << i);
+    }
+    if (side == chess::Color::Black) position.flags |= CompactPosition::kBlackToMoveFlag;
+    if (const auto ep = board.enPassantSquare()) {
+        position.en_passant = static_cast<std::int8_t>(chess::toIndex(*ep));
+    }
+    return position;
+}
+
+void unpack(const CompactPosition& position, chess::Board& board) {
+    board.clear();
+    for (int index = 0; index < chess::kSquareCount; ++index) {
+        const std::uint8_t pair = position.squares[index / 2];
+        const auto code = static_cast<std::uint8_t>((index % 2 == 0 ? pair : pair >> kNibbleBits) &
+                                                    kNibbleMask);
+        if (const auto piece = decodePiece(code)) {
+            board.setPiece(chess::toSquare(index), piece);
+        }
+    }
+
+    chess::CastlingRights rights{};
+    for (std::size_t i = 0; i < rights.size(); ++i) {
+        rights[i] = (position.flags & kCastlingMask & (1u << i)) != 0;
+    }
+    board.setCastlingRights(rights);
+    board.setEnPassantSquare(position.en_passant == CompactPosition::kNoEnPassant
+                                 ? std::nullopt
+                                 : std::optional{chess::toSquare(position.en_passant)});
+}
+
+} // namespace server
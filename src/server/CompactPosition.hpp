@@ -0,0 +1,54 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include "core/Bitboard.hpp"
+#include "core/Board.hpp"
+#include "core/Types.hpp"
+#include "core/Zobrist.hpp"
+
+/// @file CompactPosition.hpp
+/// @brief Fixed-size, trivially copyable position record for server game state.
+
+namespace server {
+
+/// A complete position in 48 bytes: placement, side to move, castling rights,
+/// en-passant square and both move clocks.
+///
+/// chess::Board is laid out for move generation (bitboards, a mailbox and
+/// incremental evaluation sums, several hundred bytes); a server holding many
+/// idle games keeps this instead and unpacks a Board only while a game has
+/// moves to process.
+struct CompactPosition {
+    static constexpr std::int8_t kNoEnPassant = -1;
+    static constexpr std::uint8_t kBlackToMoveFlag = 1u << 4;
+
+    /// Two squares per byte, the even square index in the low nibble:
+    /// 0 = empty, otherwise 1 + piece type, plus 8 for Black.
+    std::array<std::uint8_t, chess::kSquareCount / 2> squares{};
+    chess::zobrist::Key key{0};  ///< chess::positionKey() of the position
+    std::uint16_t fullmove_number{1};
+    std::uint8_t halfmove_clock{0};
+    /// Castling rights in bits 0-3 (chess::CastlingRights order), kBlackToMoveFlag.
+    std::uint8_t flags{0};
+    std::int8_t en_passant{kNoEnPassant};  ///< Square index, or kNoEnPassant
+
+    [[nodiscard]] chess::Color sideToMove() const noexcept {
+        return (flags & kBlackToMoveFlag) != 0 ? chess::Color::Black : chess::Color::White;
+    }
+
+    [[nodiscard]] bool operator==(const CompactPosition&) const noexcept = default;
+};
+
+static_assert(std::is_trivially_copyable_v<CompactPosition>);
+static_assert(sizeof(CompactPosition) == 48);
+
+/// Pack a position; clocks beyond the field ranges saturate.
+[[nodiscard]] CompactPosition pack(const chess::Board& board, chess::Color side,
+                                   int halfmove_clock, int fullmove_number) noexcept;
+
+/// Replace `board` with the placement, castling rights and en-passant square
+/// of `position` (the side to move and clocks stay in the record).
+void unpack(const CompactPosition& position, chess::Board& board);
+
+} // namespace server
@@ -0,0 +1,255 @@
+#include "GameServer.hpp"
+#include <algorithm>
+#include <utility>
+#include "core/Board.hpp"
+#include "core/Fen.hpp"
+#include "core/MoveList.hpp"
+#include "core/Rules.hpp"
+
+namespace server {
+
+namespace {
+
+/// Plies without a capture or pawn move after which the game is drawn.
+constexpr int kFiftyMovePlies = 100;
+
+/// @param tablebase Adjudicates positions it covers; may be null
+[[nodiscard]] GameStatus statusOf(const chess::Board& board, chess::Color side,
+                                  const chess::MoveList& moves, int halfmove_clock,
+                                  const engine::Tablebase* tablebase) {
+    if (moves.empty()) {
+        return chess::Rules{}.isCheck(board, side) ? GameStatus::Checkmate : GameStatus::Stalemate;
+    }
+    if (halfmove_clock >= kFiftyMovePlies) return GameStatus::FiftyMoveDraw;
+    if (tablebase == nullptr || !tablebase->covers(board)) return GameStatus::Ongoing;
+
+    const auto result = tablebase->adjudicate(board, side, halfmove_clock);
+    if (!result) return GameStatus::Ongoing;  // Table missing: play on
+    if (*result == engine::Wdl::Win) return GameStatus::TablebaseWin;
+    if (*result == engine::Wdl::Loss) return GameStatus::TablebaseLoss;
+    return GameStatus::TablebaseDraw;
+}
+
+/// The generated move (with its special-move flags) a request stands for.
+[[nodiscard]] const chess::Move* findLegal(const chess::MoveList& moves,
+                                           chess::PackedMove request) noexcept {
+    const chess::Move wanted = request.toMove();
+    const auto it = std::ranges::find_if(moves, [&](const chess::Move& move) {
+        return move == wanted &&
+               (!move.promotion ||
+                *move.promotion == wanted.promotion.value_or(chess::PieceType::Queen));
+    });
+    return it != moves.end() ? &*it : nullptr;
+}
+
+/// A position being played on by a worker.
+struct LivePosition {
+    chess::Board board;
+    chess::Color side{chess::Color::White};
+    int halfmove_clock{0};
+    int fullmove_number{1};
+    chess::MoveList moves;  ///< Legal moves of the side to move
+
+    void load(const CompactPosition& position) {
+        unpack(position, board);
+        side = position.sideToMove();
+        halfmove_clock = position.halfmove_clock;
+        fullmove_number = position.fullmove_number;
+        chess::Rules{}.legalMoves(board, side, moves);
+    }
+
+    /// @pre move is one of `moves` (taken by value: they are regenerated)
+    void play(chess::Move move) {
+        const bool pawn_move = board.at(move.from)->type == chess::PieceType::Pawn;
+        const bool capture = move.en_passant || board.hasPieceAt(move.to);
+        halfmove_clock = (pawn_move || capture) ? 0 : halfmove_clock + 1;
+        if (side == chess::Color::Black) ++fullmove_number;
+
+        static_cast<void>(board.makeMove(move));
+        side = chess::opponent(side);
+        chess::Rules{}.legalMoves(board, side, moves);
+    }
+
+    [[nodiscard]] CompactPosition pack() const noexcept {
+        return server::pack(board, side, halfmove_clock, fullmove_number);
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+GameServer::GameServer(const ServerOptions& options, ReplySink on_reply)
+    : on_reply_(std::move(on_reply)),
+      tablebase_(options.tablebase),
+      executor_(options.threads, [this](const std::uint32_t& index) { processGame(index); }) {}
+
+// The executor is destroyed first and finishes every queued game on the way
+GameServer::~GameServer() = default;
+
+// ============================================================================
+// Games
+// ============================================================================
+
+std::optional<GameId> GameServer::createGame(std::string_view fen) {
+    const auto start = chess::parseFen(fen.empty() ? chess::kStartFen : fen);
+    if (!start) return std::nullopt;
+
+    chess::MoveList moves;
+    chess::Rules{}.legalMoves(start->board, start->side_to_move, moves);
+    const GameState state{
+        .position = pack(start->board, start->side_to_move, start->halfmove_clock,
+                         start->fullmove_number),
+        .status = statusOf(start->board, start->side_to_move, moves, start->halfmove_clock,
+                           tablebase_.get()),
+    };
+
+    const auto index = slots_.acquire();
+    if (!index) return std::nullopt;
+    Slot& slot = *slots_.find(*index);
+    std::scoped_lock lock(slot.mutex);
+    slot.open = true;
+    slot.state = state;
+    return GameId{.index = *index, .generation = slot.generation};
+}
+
+bool GameServer::closeGame(GameId id) {
+    std::unique_lock<std::mutex> lock;
+    Slot* slot = lockOpen(id, lock);
+    if (slot == nullptr) return false;
+
+    slot->open = false;
+    if (slot->scheduled) return true;  // The worker releases it when done
+
+    ++slot->generation;
+    lock.unlock();
+    slots_.release(id.index);
+    return true;
+}
+
+bool GameServer::submitMove(GameId id, chess::PackedMove move, std::uint64_t tag) {
+    std::unique_lock<std::mutex> lock;
+    Slot* slot = lockOpen(id, lock);
+    if (slot == nullptr) return false;
+
+    in_flight_.fetch_add(1);
+    slot->pending.push_back({.move = move, .tag = tag});
+    const bool schedule = !std::exchange(slot->scheduled, true);
+    lock.unlock();
+
+    if (schedule) executor_.submit(id.index);
+    return true;
+}
+
+std::optional<GameState> GameServer::state(GameId id) const {
+    std::unique_lock<std::mutex> lock;
+    const Slot* slot = lockOpen(id, lock);
+    return slot != nullptr ? std::optional{slot->state} : std::nullopt;
+}
+
+void GameServer::waitIdle() const {
+    for (auto count = in_flight_.load(); count != 0; count = in_flight_.load()) {
+        in_flight_.wait(count);
+    }
+}
+
+GameServer::Slot* GameServer::lockOpen(GameId id, std::unique_lock<std::mutex>& lock) const {
+    Slot* slot = slots_.find(id.index);
+    if (slot == nullptr) return nullptr;
+
+    lock = std::unique_lock(slot->mutex);
+    if (!slot->open || slot->generation != id.generation) {
+        lock.unlock();
+        return nullptr;
+    }
+    return slot;
+}
+
+// ============================================================================
+// Worker Side
+// ============================================================================
+
+void GameServer::processGame(std::uint32_t index) {
+    // Per worker, so batches reuse their capacity
+    thread_local std::vector<MoveRequest> batch;
+    thread_local std::vector<MoveReply> replies;
+    thread_local LivePosition live;
+
+    Slot& slot = *slots_.find(index);
+    GameState state;
+    GameId id{.index = index};
+    bool open = false;
+    {
+        std::scoped_lock lock(slot.mutex);
+        batch.clear();
+        batch.swap(slot.pending);
+        state = slot.state;
+        id.generation = slot.generation;
+        open = slot.open;
+    }
+
+    replies.clear();
+    if (open) {
+        live.load(state.position);
+        for (const MoveRequest& request : batch) {
+            MoveReply reply{.game = id, .tag = request.tag};
+            if (state.status != GameStatus::Ongoing) {
+                reply.status = MoveStatus::GameOver;
+            } else if (const chess::Move* move = findLegal(live.moves, request.move)) {
+                live.play(*move);
+                ++state.ply;
+                state.status = statusOf(live.board, live.side, live.moves, live.halfmove_clock,
+                                        tablebase_.get());
+            } else {
+                reply.status = MoveStatus::Illegal;
+            }
+            reply.game_status = state.status;
+            reply.ply = state.ply;
+            reply.key = chess::positionKey(live.board, live.side);
+            replies.push_back(reply);
+        }
+        state.position = live.pack();
+    } else {
+        for (const MoveRequest& request : batch) {
+            replies.push_back({.game = id, .tag = request.tag, .status = MoveStatus::UnknownGame});
+        }
+    }
+
+    // Still scheduled, so nobody else plays this game before its replies are out
+    {
+        std::scoped_lock lock(slot.mutex);
+        slot.state = state;
+    }
+    if (on_reply_) {
+        for (const MoveReply& reply : replies) on_reply_(reply);
+    }
+
+    bool reschedule = false;
+    bool release = false;
+    {
+        std::scoped_lock lock(slot.mutex);
+        reschedule = !slot.pending.empty();
+        if (!reschedule) {
+            slot.scheduled = false;
+            if (!slot.open) {
+                ++slot.generation;
+                release = true;
+            }
+        }
+    }
+    if (release) slots_.release(index);
+    if (reschedule) executor_.submit(index);
+
+    // Last, so that once waitIdle() returns no game is still scheduled
+    finishRequests(batch.size());
+}
+
+void GameServer::finishRequests(std::size_t count) {
+    if (count != 0 && in_flight_.fetch_sub(count) == count) {
+        in_flight_.notify_all();
+    }
+}
+
+} // namespace server
@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "core/PackedMove.hpp"
+#include "engine/Tablebase.hpp"
+#include "CompactPosition.hpp"
+#include "SlotArena.hpp"
+#include "WorkStealingExecutor.hpp"
+
+/// @file GameServer.hpp
+/// @brief Hosts many concurrent games and validates their moves in parallel.
+
+namespace server {
+
+/// Handle of a hosted game. Stale once the game is closed: its slot may be
+/// reused, but with a new generation.
+struct GameId {
+    std::uint32_t index{0};
+    std::uint32_t generation{0};
+
+    [[nodiscard]] bool operator==(const GameId&) const noexcept = default;
+};
+
+enum class GameStatus : std::uint8_t {
+    Ongoing,
+    Checkmate,     ///< The side to move is mated
+    Stalemate,
+    FiftyMoveDraw,  ///< 100 plies without a capture or pawn move
+    TablebaseWin,   ///< Adjudicated: the side to move wins with best play
+    TablebaseDraw,
+    TablebaseLoss
+};
+
+enum class MoveStatus : std::uint8_t {
+    Accepted,
+    Illegal,     ///< Not a legal move in the game's position when it was processed
+    GameOver,    ///< The game had already ended
+    UnknownGame  ///< The game was closed before the move was processed
+};
+
+/// Answer to one submitted move.
+struct MoveReply {
+    GameId game{};
+    std::uint64_t tag{0};  ///< As passed to submitMove()
+    MoveStatus status{MoveStatus::Accepted};
+    GameStatus game_status{GameStatus::Ongoing};  ///< After the move, or unchanged if rejected
+    std::uint32_t ply{0};                         ///< Moves played in the game so far
+    chess::zobrist::Key key{0};                   ///< Position key after the move
+};
+
+/// State of a game as of its last processed move.
+struct GameState {
+    CompactPosition position{};
+    GameStatus status{GameStatus::Ongoing};
+    std::uint32_t ply{0};
+};
+
+/// Receives replies on worker threads: concurrently for different games, in
+/// submission order for any one game.
+using ReplySink = std::function<void(const MoveReply&)>;
+
+struct ServerOptions {
+    int threads{1};  ///< Worker threads validating moves
+    /// Ends games reaching a position it covers; null plays them out
+    std::shared_ptr<const engine::Tablebase> tablebase{};
+};
+
+/// Many games in one process, each a CompactPosition in a pooled slot.
+///
+/// submitMove() only queues the move on its game; a game with queued moves
+/// is scheduled once on a WorkStealingExecutor, whose worker unpacks the
+/// position, plays every queued move in order and packs it again. A game is
+/// thus owned by at most one worker at a time, which keeps its moves ordered
+/// without a lock held during move generation, while different games run in
+/// parallel.
+///
+/// @note Threefold repetition is not detected: it needs the position history,
+///       which the compact slots do not keep.
+/// @note All member functions are thread-safe.
+class GameServer {
+public:
+    /// @param on_reply Called once per accepted submitMove(); must be thread-safe
+    GameServer(const ServerOptions& options, ReplySink on_reply);
+
+    /// Processes the moves already submitted, then stops the workers.
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+    GameServer(GameServer&&) = delete;
+    GameServer& operator=(GameServer&&) = delete;
+
+    /// Open a game from a FEN position.
+    /// @param fen Starting position; empty for the standard one
+    /// @return nullopt if the FEN is invalid or the pool is full
+    [[nodiscard]] std::optional<GameId> createGame(std::string_view fen = {});
+
+    /// Close a game; moves still queued for it are answered UnknownGame.
+    /// @return false if the game does not exist
+    bool closeGame(GameId id);
+
+    /// Queue a move for a game; its reply reaches the sink later.
+    /// @param move From, to and promotion piece (an unset promotion means a
+    ///        queen); castling and en-passant flags are not needed
+    /// @param tag Echoed in the reply
+    /// @return false (and no reply follows) if the game does not exist
+    [[nodiscard]] bool submitMove(GameId id, chess::PackedMove move, std::uint64_t tag = 0);
+
+    /// The game as of its last processed move, or nullopt if it does not exist.
+    [[nodiscard]] std::optional<GameState> state(GameId id) const;
+
+    /// Block until every submitted move has been answered.
+    void waitIdle() const;
+
+    /// Games currently open.
+    [[nodiscard]] std::size_t gameCount() const { return slots_.size(); }
+
+private:
+    struct MoveRequest {
+        chess::PackedMove move;
+        std::uint64_t tag{0};
+    };
+
+    /// One hosted game. Only the worker the game is scheduled on touches
+    /// `state` outside the mutex, so a game never blocks its submitters for
+    /// longer than a queue push.
+    struct Slot {
+        mutable std::mutex mutex;
+        std::uint32_t generation{0};
+        bool open{false};
+        bool scheduled{false};  ///< Queued on or running on a worker
+        GameState state{};
+        std::vector<MoveRequest> pending;  ///< Submitted since the worker last looked
+    };
+
+    /// The slot of an open game, locked, or nullptr (unlocked) if `id` is stale.
+    [[nodiscard]] Slot* lockOpen(GameId id, std::unique_lock<std::mutex>& lock) const;
+
+    /// Executor task: play the queued moves of the game in slot `index`.
+    void processGame(std::uint32_t index);
+
+    void finishRequests(std::size_t count);
+
+    ReplySink on_reply_;
+    std::shared_ptr<const engine::Tablebase> tablebase_;
+    SlotArena<Slot> slots_;
+
+    /// Submitted moves not yet answered, for waitIdle().
+    std::atomic<std::uint64_t> in_flight_{0};
+
+    WorkStealingExecutor<std::uint32_t> executor_;  // Last: stopped before the slots go away
+};
+
+} // namespace server
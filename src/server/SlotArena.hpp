@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+/// @file SlotArena.hpp
+/// @brief Chunked object pool with stable addresses and 32-bit slot indices.
+
+namespace server {
+
+/// Pool of default-constructed T handed out by index.
+///
+/// Slots are allocated ChunkSize at a time and live until the arena is
+/// destroyed: nothing is moved or freed when the pool grows, so a slot
+/// reference stays valid while other threads acquire slots, and find() needs
+/// no lock. Released indices are reused most recently released first, whose
+/// memory is the likeliest to still be cached. A released T is not destroyed;
+/// its owner resets it, keeping any capacity it has grown.
+template <typename T, std::size_t ChunkSize = 4096, std::size_t MaxChunks = 1024>
+class SlotArena {
+public:
+    static constexpr std::size_t kCapacity = ChunkSize * MaxChunks;
+    static_assert(kCapacity <= std::numeric_limits<std::uint32_t>::max(),
+                  "slot indices are 32-bit");
+
+    /// Reserve a slot, growing the pool by a chunk if none is free.
+    /// @note Thread-safe.
+    /// @return nullopt if all kCapacity slots are in use
+    [[nodiscard]] std::optional<std::uint32_t> acquire() {
+        std::scoped_lock lock(mutex_);
+        std::uint32_t index = 0;
+        if (!free_.empty()) {
+            index = free_.back();
+            free_.pop_back();
+        } else if (allocated_ < kCapacity) {
+            index = allocated_++;
+            if (index % ChunkSize == 0) {
+                storage_.push_back(std::make_unique<T[]>(ChunkSize));
+                chunks_[index / ChunkSize].store(storage_.back().get(), std::memory_order_release);
+            }
+        } else {
+            return std::nullopt;
+        }
+        ++live_;
+        return index;
+    }
+
+    /// Return a slot to the pool.
+    /// @note Thread-safe.
+    /// @pre index came from acquire() and has not been released since
+    void release(std::uint32_t index) {
+        std::scoped_lock lock(mutex_);
+        free_.push_back(index);
+        --live_;
+    }
+
+    /// The slot at `index`, or nullptr if the pool never grew that far.
+    /// @note Thread-safe and lock-free; the slot itself may be free.
+    [[nodiscard]] T* find(std::uint32_t index) const noexcept {
+        if (index >= kCapacity) return nullptr;
+        T* chunk = chunks_[index / ChunkSize].load(std::memory_order_acquire);
+        return chunk != nullptr ? &chunk[index % ChunkSize] : nullptr;
+    }
+
+    /// Slots currently acquired.
+    [[nodiscard]] std::size_t size() const {
+        std::scoped_lock lock(mutex_);
+        return live_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<T[]>> storage_;
+    std::array<std::atomic<T*>, MaxChunks> chunks_{};  // Lock-free views of storage_
+    std::vector<std::uint32_t> free_;
+    std::uint32_t allocated_{0};
+    std::size_t live_{0};
+};
+
+} // namespace server
@@ -0,0 +1,150 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// @file WorkStealingExecutor.hpp
+/// @brief Thread pool with a task deque per worker and stealing between them.
+
+namespace server {
+
+/// Runs small tasks on a fixed set of worker threads.
+///
+/// Each worker has its own deque. A task submitted by a worker goes to the
+/// back of that worker's deque and is taken from the back again (newest
+/// first, while its data is still in cache); tasks from other threads go to a
+/// shared injection queue. A worker out of work takes from the injection
+/// queue, then steals the oldest task of another worker, and sleeps only when
+/// every queue is empty. Deques are guarded by short mutex sections rather
+/// than a lock-free Chase-Lev deque: tasks here are coarse (a batch of moves
+/// for one game), so the locks are rarely contended.
+///
+/// @tparam Task Small, trivially copyable work description passed to the handler
+template <typename Task>
+class WorkStealingExecutor {
+public:
+    /// Called on a worker thread for every submitted task.
+    using Handler = std::function<void(const Task&)>;
+
+    /// Start `threads` workers (at least one).
+    WorkStealingExecutor(int threads, Handler handler) : handler_(std::move(handler)) {
+        const auto count = static_cast<std::size_t>(std::max(threads, 1));
+        queues_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            queues_.push_back(std::make_unique<TaskQueue>());
+        }
+        workers_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            workers_.emplace_back([this, i](std::stop_token stop) { workerLoop(i, stop); });
+        }
+    }
+
+    /// Runs every task already queued (and any they submit), then joins.
+    ~WorkStealingExecutor() {
+        for (auto& worker : workers_) worker.request_stop();
+        workers_.clear();
+    }
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor(WorkStealingExecutor&&) = delete;
+    WorkStealingExecutor& operator=(WorkStealingExecutor&&) = delete;
+
+    /// Queue a task.
+    /// @note Thread-safe; never blocks on a running task.
+    void submit(const Task& task) {
+        TaskQueue& queue = current_executor_ == this ? *queues_[current_worker_] : injection_;
+        {
+            std::scoped_lock lock(queue.mutex);
+            queue.tasks.push_back(task);
+        }
+        // Sequentially consistent with the sleeper's sleeping_/queued_ pair:
+        // either it sees the task or we see it asleep and wake it
+        queued_.fetch_add(1);
+        if (sleeping_.load() > 0) {
+            std::scoped_lock lock(sleep_mutex_);
+            wake_.notify_one();
+        }
+    }
+
+    [[nodiscard]] int threadCount() const noexcept { return static_cast<int>(queues_.size()); }
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(std::size_t self, std::stop_token stop) {
+        current_executor_ = this;
+        current_worker_ = self;
+        while (true) {
+            if (const auto task = findTask(self)) {
+                handler_(*task);
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            sleeping_.fetch_add(1);
+            const bool has_work = wake_.wait(lock, stop, [this] { return queued_.load() > 0; });
+            sleeping_.fetch_sub(1);
+            if (!has_work) return;  // Stopping, and nothing is left
+        }
+    }
+
+    [[nodiscard]] std::optional<Task> findTask(std::size_t self) {
+        if (auto task = takeBack(*queues_[self])) return task;
+        if (auto task = takeFront(injection_)) return task;
+        for (std::size_t i = 1; i < queues_.size(); ++i) {
+            if (auto task = takeFront(*queues_[(self + i) % queues_.size()])) return task;
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<Task> takeBack(TaskQueue& queue) {
+        std::scoped_lock lock(queue.mutex);
+        if (queue.tasks.empty()) return std::nullopt;
+        const Task task = queue.tasks.back();
+        queue.tasks.pop_back();
+        queued_.fetch_sub(1);
+        return task;
+    }
+
+    [[nodiscard]] std::optional<Task> takeFront(TaskQueue& queue) {
+        std::scoped_lock lock(queue.mutex);
+        if (queue.tasks.empty()) return std::nullopt;
+        const Task task = queue.tasks.front();
+        queue.tasks.pop_front();
+        queued_.fetch_sub(1);
+        return task;
+    }
+
+    /// The executor and worker index of the calling thread, if it is a worker.
+    static inline thread_local const WorkStealingExecutor* current_executor_{nullptr};
+    static inline thread_local std::size_t current_worker_{0};
+
+    Handler handler_;
+    std::vector<std::unique_ptr<TaskQueue>> queues_;  // One per worker
+    TaskQueue injection_;                             // Submitted by other threads
+
+    /// Tasks in all queues; briefly negative when a task is taken before
+    /// its submitter has counted it.
+    std::atomic<std::int64_t> queued_{0};
+    std::atomic<int> sleeping_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable_any wake_;
+
+    std::vector<std::jthread> workers_;  // Last: joined before the queues go away
+};
+
+} // namespace server
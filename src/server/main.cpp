@@ -0,0 +1,207 @@
+#include "core/ChessGame.hpp"
+#include "core/PackedMove.hpp"
+#include "server/GameServer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// @file main.cpp
+/// @brief GameServer load test: plays many random games concurrently and
+/// checks every reply and final position against a single-threaded replay.
+///
+/// Usage:
+///   game_server_load [--games N] [--plies P] [--threads T] [--clients C]
+///                    [--scripts S] [--seed X]
+///
+/// S move scripts of up to P plies are generated up front by playing random
+/// legal moves on a ChessGame; game i replays script i % S. C client threads
+/// submit the games' moves round-robin by ply, so every game has moves in
+/// flight at once. Exits non-zero if any move is rejected, arrives out of
+/// order, or leaves a game in a different position than the script.
+
+namespace {
+
+constexpr std::string_view kUsage =
+    "usage: game_server_load [--games N] [--plies P] [--threads T] [--clients C]\n"
+    "                        [--scripts S] [--seed X]\n";
+
+struct Arguments {
+    int games{10000};
+    int plies{60};
+    int threads{1};
+    int clients{2};
+    int scripts{256};
+    unsigned seed{1};
+};
+
+[[nodiscard]] std::optional<Arguments> parseArguments(std::span<char*> args) {
+    Arguments parsed;
+    parsed.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        const std::string_view arg = args[i];
+        if (i + 1 >= args.size()) return std::nullopt;
+        const int value = std::atoi(args[++i]);
+        if (arg == "--seed") {
+            parsed.seed = static_cast<unsigned>(value);
+            continue;
+        }
+        if (value < 1) return std::nullopt;
+        if (arg == "--games") {
+            parsed.games = value;
+        } else if (arg == "--plies") {
+            parsed.plies = value;
+        } else if (arg == "--threads") {
+            parsed.threads = value;
+        } else if (arg == "--clients") {
+            parsed.clients = value;
+        } else if (arg == "--scripts") {
+            parsed.scripts = value;
+        } else {
+            return std::nullopt;
+        }
+    }
+    return parsed;
+}
+
+/// A random game and how it must end on the server.
+struct Script {
+    std::vector<chess::PackedMove> moves;
+    chess::zobrist::Key final_key{0};
+    server::GameStatus final_status{server::GameStatus::Ongoing};
+};
+
+[[nodiscard]] server::GameStatus statusOf(const chess::ChessGame& game) {
+    if (game.isCheckmate()) return server::GameStatus::Checkmate;
+    if (game.isStalemate()) return server::GameStatus::Stalemate;
+    if (game.isFiftyMoveDraw()) return server::GameStatus::FiftyMoveDraw;
+    return server::GameStatus::Ongoing;
+}
+
+/// Up to `plies` random legal moves from the start position. Stops early only
+/// where the server ends a game too (threefold repetition is played through).
+[[nodiscard]] Script makeScript(int plies, std::mt19937& random) {
+    chess::ChessGame game;
+    Script script;
+    while (static_cast<int>(script.moves.size()) < plies &&
+           statusOf(game) == server::GameStatus::Ongoing) {
+        const chess::MoveList& moves = game.legalMoveList();
+        std::uniform_int_distribution<std::size_t> pick(0, moves.size() - 1);
+        const chess::Move move = moves[pick(random)];
+        script.moves.emplace_back(move);
+        static_cast<void>(game.makeMove(move));
+    }
+    script.final_key = game.positionKey();
+    script.final_status = statusOf(game);
+    return script;
+}
+
+/// Reply checks, updated concurrently by the workers.
+struct ReplyCounters {
+    std::atomic<std::uint64_t> accepted{0};
+    std::atomic<std::uint64_t> failed{0};
+};
+
+/// @return the number of games whose final state differs from their script
+[[nodiscard]] int verifyGames(const server::GameServer& games, std::span<const server::GameId> ids,
+                              std::span<const Script> scripts) {
+    int mismatches = 0;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        const Script& script = scripts[i % scripts.size()];
+        const auto state = games.state(ids[i]);
+        if (!state || state->position.key != script.final_key ||
+            state->ply != script.moves.size() || state->status != script.final_status) {
+            std::cerr << "game_server_load: game " << i << " does not match its script\n";
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const auto args = parseArguments(std::span<char*>(argv, static_cast<std::size_t>(argc)));
+    if (!args) {
+        std::cerr << kUsage;
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 random(args->seed);
+    std::vector<Script> scripts;
+    scripts.reserve(static_cast<std::size_t>(args->scripts));
+    for (int i = 0; i < args->scripts; ++i) scripts.push_back(makeScript(args->plies, random));
+
+    // The tag of a move is the game's ply count once it is played
+    ReplyCounters counters;
+    server::GameServer games({.threads = args->threads}, [&](const server::MoveReply& reply) {
+        if (reply.status == server::MoveStatus::Accepted && reply.ply == reply.tag) {
+            counters.accepted.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            counters.failed.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    std::vector<server::GameId> ids;
+    ids.reserve(static_cast<std::size_t>(args->games));
+    for (int i = 0; i < args->games; ++i) {
+        const auto id = games.createGame();
+        if (!id) {
+            std::cerr << "game_server_load: cannot create game " << i << "\n";
+            return EXIT_FAILURE;
+        }
+        ids.push_back(*id);
+    }
+
+    std::atomic<std::uint64_t> unsubmitted{0};
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> clients;
+        for (int c = 0; c < args->clients; ++c) {
+            clients.emplace_back([&, c] {
+                for (int ply = 0; ply < args->plies; ++ply) {
+                    for (auto i = static_cast<std::size_t>(c); i < ids.size();
+                         i += static_cast<std::size_t>(args->clients)) {
+                        const Script& script = scripts[i % scripts.size()];
+                        if (static_cast<std::size_t>(ply) >= script.moves.size()) continue;
+                        const auto tag = static_cast<std::uint64_t>(ply + 1);
+                        if (!games.submitMove(ids[i], script.moves[ply], tag)) {
+                            unsubmitted.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                }
+            });
+        }
+    }
+    games.waitIdle();
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const int mismatches = verifyGames(games, ids, scripts);
+    for (const server::GameId id : ids) static_cast<void>(games.closeGame(id));
+
+    const std::uint64_t moves = counters.accepted.load() + counters.failed.load();
+    std::cout << "Games: " << ids.size() << ", " << moves << " moves in " << seconds
+              << " s with " << args->threads << " threads, " << args->clients << " clients\n"
+              << "Throughput: "
+              << static_cast<std::uint64_t>(seconds > 0.0 ? static_cast<double>(moves) / seconds
+                                                          : 0.0)
+              << " moves/s\n";
+
+    if (unsubmitted.load() != 0 || counters.failed.load() != 0 || mismatches != 0 ||
+        games.gameCount() != 0) {
+        std::cerr << "game_server_load: " << unsubmitted.load() << " moves not submitted, "
+                  << counters.failed.load() << " rejected or out of order, " << mismatches
+                  << " games mismatched, " << games.gameCount() << " games left open\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,394 @@
+#include "UciSession.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "core/Fen.hpp"
+#include "core/MoveList.hpp"
+#include "core/Notation.hpp"
+#include "core/Rules.hpp"
+
+namespace uci {
+
+namespace {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+constexpr std::string_view kEngineName = "ModernChess";
+constexpr std::string_view kEngineAuthor = "ModernChess contributors";
+
+/// String option value meaning "none" (the UCI convention for empty strings),
+/// e.g. no BookFile, SyzygyPath or EvalFile.
+constexpr std::string_view kEmptyOption = "<empty>";
+
+constexpr int kMinHashMb = 1;
+constexpr int kMaxHashMb = 65536;
+
+/// Moves assumed to remain when the GUI does not send movestogo.
+constexpr int kDefaultMovesToGo = 30;
+
+/// Safety margin for GUI/OS latency, taken off every time budget.
+constexpr std::chrono::milliseconds kMoveOverhead{20};
+
+// ============================================================================
+// Parsing Helpers
+// ============================================================================
+
+/// Split a command line on whitespace.
+[[nodiscard]] std::vector<std::string_view> tokenize(std::string_view line) {
+    std::vector<std::string_view> tokens;
+    std::size_t pos = 0;
+    while (pos < line.size()) {
+        while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos]))) ++pos;
+        const std::size_t start = pos;
+        while (pos < line.size() && !std::isspace(static_cast<unsigned char>(line[pos]))) ++pos;
+        if (pos > start) tokens.push_back(line.substr(start, pos - start));
+    }
+    return tokens;
+}
+
+[[nodiscard]] std::optional<std::int64_t> parseInteger(std::string_view text) {
+    std::int64_t value = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{} || end != text.data() + text.size()) return std::nullopt;
+    return value;
+}
+
+[[nodiscard]] bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return std::ranges::equal(a, b, [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) ==
+               std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+/// Join tokens back into space-separated text (for FEN fields).
+[[nodiscard]] std::string join(std::span<const std::string_view> tokens) {
+    std::string text;
+    for (const std::string_view token : tokens) {
+        if (!text.empty()) text.push_back(' ');
+        text.append(token);
+    }
+    return text;
+}
+
+/// Find the legal move written as `text` in long algebraic notation.
+[[nodiscard]] std::optional<chess::Move> findMove(const chess::Board& board, chess::Color side,
+                                                  std::string_view text) {
+    chess::MoveList moves;
+    chess::Rules{}.legalMoves(board, side, moves);
+    const auto it = std::ranges::find_if(moves, [&](const chess::Move& move) {
+        return chess::toUci(move) == text;
+    });
+    return it != moves.end() ? std::optional{*it} : std::nullopt;
+}
+
+/// UCI score field: centipawns, or moves to mate (negative when being mated).
+[[nodiscard]] std::string formatScore(int score) {
+    if (!engine::isMateScore(score)) {
+        return "cp " + std::to_string(score);
+    }
+    const int plies = engine::kMateScore - std::abs(score);
+    const int moves = (plies + 1) / 2;
+    return "mate " + std::to_string(score > 0 ? moves : -moves);
+}
+
+/// Parsed arguments of "go".
+struct GoOptions {
+    engine::SearchLimits limits{};
+    bool infinite{false};
+};
+
+[[nodiscard]] GoOptions parseGo(std::span<const std::string_view> args, chess::Color side) {
+    GoOptions options;
+    std::optional<std::int64_t> time_left;
+    std::int64_t increment = 0;
+    std::int64_t moves_to_go = kDefaultMovesToGo;
+    const bool white = side == chess::Color::White;
+
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        const std::string_view name = args[i];
+        if (name == "infinite") {
+            options.infinite = true;
+            continue;
+        }
+        if (i + 1 >= args.size()) break;
+        const auto value = parseInteger(args[i + 1]);
+        if (!value) continue;
+        ++i;
+
+        if (name == "depth") {
+            options.limits.depth = static_cast<int>(std::max<std::int64_t>(*value, 1));
+        } else if (name == "nodes") {
+            options.limits.nodes = static_cast<std::uint64_t>(std::max<std::int64_t>(*value, 1));
+        } else if (name == "movetime") {
+            options.limits.move_time = std::chrono::milliseconds{*value};
+        } else if (name == (white ? "wtime" : "btime")) {
+            time_left = *value;
+        } else if (name == (white ? "winc" : "binc")) {
+            increment = *value;
+        } else if (name == "movestogo" && *value > 0) {
+            moves_to_go = *value;
+        }
+    }
+
+    // An even share of the remaining time plus most of the increment,
+    // never more than what is actually left
+    if (!options.limits.move_time && time_left && !options.infinite) {
+        const std::chrono::milliseconds remaining{*time_left};
+        const std::chrono::milliseconds budget{*time_left / moves_to_go + increment * 3 / 4};
+        options.limits.move_time = std::min(budget, remaining);
+    }
+    if (options.limits.move_time) {
+        options.limits.move_time = std::max(*options.limits.move_time - kMoveOverhead,
+                                            std::chrono::milliseconds{1});
+    }
+    return options;
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+UciSession::UciSession(std::ostream& out) : out_(out) {}
+
+UciSession::~UciSession() {
+    stopSearch();
+}
+
+// ============================================================================
+// Command Loop
+// ============================================================================
+
+void UciSession::run(std::istream& in) {
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!handleCommand(line)) return;
+    }
+    stopSearch();
+}
+
+bool UciSession::handleCommand(std::string_view line) {
+    const std::vector<std::string_view> tokens = tokenize(line);
+    if (tokens.empty()) return true;
+
+    const std::string_view command = tokens.front();
+    const Tokens args = Tokens{tokens}.subspan(1);
+
+    if (command == "uci") {
+        handleUci();
+    } else if (command == "isready") {
+        send("readyok");
+    } else if (command == "ucinewgame") {
+        stopSearch();
+        engine_.clearHash();
+        board_.reset();
+        side_to_move_ = chess::Color::White;
+        game_history_.clear();
+        halfmove_clock_ = 0;
+    } else if (command == "setoption") {
+        handleSetOption(args);
+    } else if (command == "position") {
+        handlePosition(args);
+    } else if (command == "go") {
+        handleGo(args);
+    } else if (command == "stop") {
+        stopSearch();
+    } else if (command == "quit") {
+        stopSearch();
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Commands
+// ============================================================================
+
+void UciSession::handleUci() {
+    send("id name " + std::string{kEngineName});
+    send("id author " + std::string{kEngineAuthor});
+    send("option name Hash type spin default " +
+         std::to_string(engine::TranspositionTable::kDefaultSizeMb) + " min " +
+         std::to_string(kMinHashMb) + " max " + std::to_string(kMaxHashMb));
+    send("option name Threads type spin default 1 min 1 max " +
+         std::to_string(engine::Engine::kMaxThreads));
+    send("option name OwnBook type check default true");
+    send("option name BookFile type string default " + std::string{kEmptyOption});
+    send("option name SyzygyPath type string default " + std::string{kEmptyOption});
+    send("option name EvalFile type string default " + std::string{kEmptyOption});
+    send("uciok");
+}
+
+void UciSession::handleSetOption(Tokens args) {
+    // setoption name <name...> value <value...>
+    const auto value_it = std::ranges::find(args, std::string_view{"value"});
+    if (args.empty() || args.front() != "name" || value_it == args.end() ||
+        value_it + 1 == args.end()) {
+        return;
+    }
+    const std::string name = join({args.begin() + 1, value_it});
+    const std::string value = join({value_it + 1, args.end()});
+
+    stopSearch();
+    if (equalsIgnoreCase(name, "Hash")) {
+        if (const auto size = parseInteger(value)) {
+            engine_.setHashSize(static_cast<std::size_t>(
+                std::clamp<std::int64_t>(*size, kMinHashMb, kMaxHashMb)));
+        }
+    } else if (equalsIgnoreCase(name, "Threads")) {
+        if (const auto count = parseInteger(value)) {
+            engine_.setThreads(static_cast<int>(
+                std::clamp<std::int64_t>(*count, 1, engine::Engine::kMaxThreads)));
+        }
+    } else if (equalsIgnoreCase(name, "OwnBook")) {
+        own_book_ = equalsIgnoreCase(value, "true");
+    } else if (equalsIgnoreCase(name, "BookFile")) {
+        book_.reset();
+        if (value != kEmptyOption) {
+            book_ = engine::OpeningBook::open(value);
+            if (!book_) send("info string cannot open book " + value);
+        }
+    } else if (equalsIgnoreCase(name, "SyzygyPath")) {
+        engine_.setTablebase(nullptr);
+        if (value != kEmptyOption) {
+            auto tablebase = std::make_shared<const engine::Tablebase>(value);
+            send("info string found " + std::to_string(tablebase->tableCount()) +
+                 " tablebases");
+            if (tablebase->tableCount() != 0) engine_.setTablebase(std::move(tablebase));
+        }
+    } else if (equalsIgnoreCase(name, "EvalFile")) {
+        engine_.setNetwork(nullptr);
+        if (value != kEmptyOption) {
+            auto network = engine::nnue::Network::load(value);
+            if (!network) {
+                send("info string cannot load network " + value);
+                return;
+            }
+            send("info string NNUE evaluation using " + value + " (" +
+                 std::string{network->kernelName()} + " kernels)");
+            engine_.setNetwork(std::make_shared<const engine::nnue::Network>(std::move(*network)));
+        }
+    }
+}
+
+void UciSession::handlePosition(Tokens args) {
+    if (args.empty()) return;
+    stopSearch();
+
+    const auto moves_it = std::ranges::find(args, std::string_view{"moves"});
+    std::optional<chess::FenPosition> position;
+    if (args.front() == "startpos") {
+        position = chess::parseFen(chess::kStartFen);
+    } else if (args.front() == "fen") {
+        position = chess::parseFen(join({args.begin() + 1, moves_it}));
+    }
+    if (!position) return;
+
+    board_ = position->board;
+    side_to_move_ = position->side_to_move;
+    game_history_.clear();
+    halfmove_clock_ = position->halfmove_clock;
+
+    if (moves_it == args.end()) return;
+    for (auto it = moves_it + 1; it != args.end(); ++it) {
+        const auto move = findMove(board_, side_to_move_, *it);
+        if (!move) return;  // Keep the position reached so far
+
+        // Positions before a capture or pawn move can never recur
+        const bool irreversible = move->en_passant || board_.hasPieceAt(move->to) ||
+                                  board_.at(move->from)->type == chess::PieceType::Pawn;
+        if (irreversible) {
+            game_history_.clear();
+            halfmove_clock_ = 0;
+        } else {
+            game_history_.push_back(chess::positionKey(board_, side_to_move_));
+            ++halfmove_clock_;
+        }
+
+        static_cast<void>(board_.makeMove(*move));
+        side_to_move_ = chess::opponent(side_to_move_);
+    }
+}
+
+void UciSession::handleGo(Tokens args) {
+    stopSearch();
+    const GoOptions options = parseGo(args, side_to_move_);
+
+    // Known openings are answered at once; analysis always searches
+    if (own_book_ && book_ && !options.infinite) {
+        if (const auto move = book_->pick(board_, side_to_move_, random_())) {
+            send("info string book move");
+            send("bestmove " + chess::toUci(*move));
+            return;
+        }
+    }
+
+    search_thread_ = std::jthread(
+        [this, options, board = board_, side = side_to_move_,
+         history = game_history_, halfmove_clock = halfmove_clock_](std::stop_token stop) {
+            const auto on_iteration = [this](const engine::SearchInfo& info) { sendInfo(info); };
+            const engine::SearchResult result =
+                engine_.search(board, side, options.limits, on_iteration, stop, history,
+                               halfmove_clock);
+
+            // "go infinite" must not answer before "stop", even if the search
+            // ended on its own (e.g. it found a mate)
+            if (options.infinite) {
+                std::mutex mutex;
+                std::condition_variable_any wake;
+                std::unique_lock lock(mutex);
+                wake.wait(lock, stop, [] { return false; });
+            }
+
+            send("bestmove " + (result.best_move ? chess::toUci(*result.best_move) : "0000"));
+        });
+}
+
+void UciSession::stopSearch() {
+    if (search_thread_.joinable()) {
+        search_thread_.request_stop();
+        search_thread_.join();
+    }
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+void UciSession::send(std::string_view line) {
+    std::scoped_lock lock(out_mutex_);
+    out_ << line << '\n' << std::flush;
+}
+
+void UciSession::sendInfo(const engine::SearchInfo& info) {
+    std::string line = "info depth " + std::to_string(info.depth) +
+                       " score " + formatScore(info.score) +
+                       " nodes " + std::to_string(info.nodes) +
+                       " nps " + std::to_string(info.nps) +
+                       " time " + std::to_string(info.elapsed.count()) +
+                       " hashfull " + std::to_string(info.hashfull);
+    if (!info.pv.empty()) {
+        line += " pv";
+        for (const chess::Move& move : info.pv) {
+            line += ' ';
+            line += chess::toUci(move);
+        }
+    }
+    send(line);
+}
+
+} // namespace uci
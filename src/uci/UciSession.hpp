@@ -0,0 +1,78 @@
+#pragma once
+#include <iosfwd>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "core/Board.hpp"
+#include "engine/Engine.hpp"
+#include "engine/OpeningBook.hpp"
+
+/// @file UciSession.hpp
+/// @brief Universal Chess Interface (UCI) protocol driver for the engine.
+
+namespace uci {
+
+/// One UCI conversation with a GUI or tournament manager.
+///
+/// Commands are read on the calling thread; a search runs on its own thread
+/// and streams "info" lines as iterations complete, so commands such as
+/// "isready" and "stop" are answered while searching.
+class UciSession {
+public:
+    /// @param out Stream for engine output; every line is flushed immediately
+    explicit UciSession(std::ostream& out);
+
+    /// Stops and joins any running search.
+    ~UciSession();
+
+    UciSession(const UciSession&) = delete;
+    UciSession& operator=(const UciSession&) = delete;
+    UciSession(UciSession&&) = delete;
+    UciSession& operator=(UciSession&&) = delete;
+
+    /// Process commands from `in` until "quit" or end of input.
+    void run(std::istream& in);
+
+    /// Process one command line. Unknown commands are ignored, as UCI requires.
+    /// @return false if the command was "quit"
+    bool handleCommand(std::string_view line);
+
+private:
+    using Tokens = std::span<const std::string_view>;
+
+    void handleUci();
+    void handleSetOption(Tokens args);
+    void handlePosition(Tokens args);
+    void handleGo(Tokens args);
+
+    /// Stop the running search, if any, and wait for its "bestmove".
+    void stopSearch();
+
+    /// Write one line atomically with respect to the search thread.
+    void send(std::string_view line);
+
+    void sendInfo(const engine::SearchInfo& info);
+
+    std::ostream& out_;
+    std::mutex out_mutex_;
+
+    engine::Engine engine_;
+    chess::Board board_;
+    chess::Color side_to_move_{chess::Color::White};
+    /// Keys of the positions since the last irreversible move, for the search.
+    std::vector<chess::zobrist::Key> game_history_;
+    int halfmove_clock_{0};  ///< Of the current position, for tablebase results
+
+    /// Consulted before searching while own_book_ is set ("OwnBook" option).
+    std::optional<engine::OpeningBook> book_;
+    bool own_book_{true};
+    std::mt19937_64 random_{std::random_device{}()};
+
+    std::jthread search_thread_;
+};
+
+} // namespace uci
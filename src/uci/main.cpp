@@ -0,0 +1,12 @@
+#include "uci/UciSession.hpp"
+#include <iostream>
+
+/// @file main.cpp
+/// @brief Headless UCI engine: speaks the protocol on stdin/stdout so the
+/// engine can run under tournament managers and analysis GUIs.
+
+int main() {
+    uci::UciSession session(std::cout);
+    session.run(std::cin);
+    return 0;
+}
@@ -1,6 +1,9 @@
 #pragma once
+#include <chrono>
+#include <cstdint>
 #include <optional>
 #include <span>
+#include "core/Bitboard.hpp"
 #include "core/Types.hpp"
 #include "core/Move.hpp"
 
@@ -23,6 +26,13 @@ struct AnimationInfo {
     }
 };
 
+/// Game commands the user can issue besides moves.
+enum class InputCommand : std::uint8_t {
+    Undo,          ///< Take back the last move
+    Redo,          ///< Replay the last move taken back
+    ToggleOverlay  ///< Show or hide the performance overlay
+};
+
 /// Abstract interface for user input handling.
 ///
 /// Implementations process platform-specific input events and produce chess moves.
@@ -39,6 +49,28 @@ public:
     /// @return A move if one is ready, nullopt otherwise
     [[nodiscard]] virtual std::optional<chess::Move> processInput() = 0;
 
+    /// Take the command the user issued during the last processInput(), if any.
+    [[nodiscard]] virtual std::optional<InputCommand> takeCommand() {
+        return std::nullopt;
+    }
+
+    /// Block until input arrives, for loops that have nothing else to do.
+    /// The input is kept for the next processInput().
+    /// @param timeout Longest wait; nullopt waits indefinitely
+    virtual void waitForInput([[maybe_unused]] std::optional<std::chrono::milliseconds> timeout) {}
+
+    /// Whether input handled since the last call may have changed what is on screen.
+    /// @note The default always answers true, i.e. redraw every frame.
+    [[nodiscard]] virtual bool takeRedrawRequest() noexcept { return true; }
+
+    /// Check if the user is dragging a piece.
+    [[nodiscard]] virtual bool isDragging() const noexcept { return false; }
+
+    /// Destinations to highlight for the piece the user picked up, if any.
+    [[nodiscard]] virtual chess::Bitboard legalMoveHighlights() const noexcept {
+        return chess::kEmptyBitboard;
+    }
+
     /// Set the currently selected square for visual feedback.
     virtual void setSelected(std::optional<chess::Square> square) = 0;
 
@@ -1,11 +1,19 @@
 ﻿#pragma once
-#include <span>
-#include <vector>
+#include "core/Bitboard.hpp"
 #include "core/IGame.hpp"
+#include "engine/Search.hpp"
 #include "IInputHandler.hpp"
 
 namespace ui {
 
+/// Background engine state, for diagnostics displays.
+struct EngineStatus {
+    bool attached{false};   ///< The application runs an engine
+    bool searching{false};  ///< A search is in progress
+    /// Latest progress report, or nullptr; only valid until the next frame.
+    const engine::SearchInfo* info{nullptr};
+};
+
 /// Abstract interface for chess board rendering.
 /// 
 /// Implementations handle drawing:
@@ -49,13 +57,30 @@ public:
     // ========================================================================
 
     /// Set the legal move destinations to highlight.
-    /// @param squares View of squares that are valid move destinations
-    virtual void setLegalMoveHighlights(std::span<const chess::Square> squares) noexcept { 
+    /// @param squares Set of squares that are valid move destinations
+    virtual void setLegalMoveHighlights(chess::Bitboard squares) noexcept { 
         (void)squares; 
     }
 
     /// Clear legal move highlights.
     virtual void clearLegalMoveHighlights() noexcept {}
+
+    // ========================================================================
+    // Diagnostics
+    // ========================================================================
+
+    /// Show or hide the performance overlay, if the renderer has one.
+    virtual void toggleOverlay() {}
+
+    /// True while the overlay is shown; its statistics need a frame per tick.
+    [[nodiscard]] virtual bool isOverlayVisible() const noexcept { return false; }
+
+    /// Set the engine state the overlay reports.
+    virtual void setEngineStatus([[maybe_unused]] const EngineStatus& status) noexcept {}
+
+    /// Draw the overlay, if visible, on top of everything rendered so far.
+    /// @note Call last, just before present().
+    virtual void renderOverlay() {}
 };
 
 } // namespace ui
@@ -0,0 +1,179 @@
+#include "PerformanceOverlay.hpp"
+#include "Config.hpp"
+#include "core/Instrumentation.hpp"
+#include "core/Notation.hpp"
+#include <imgui.h>
+#include <imgui-SFML.h>
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <span>
+#include <string>
+
+namespace ui {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+namespace {
+
+constexpr float kMargin = 8.f;
+constexpr float kBackgroundAlpha = 0.7f;
+constexpr ImVec2 kHistogramSize{240.f, 60.f};
+
+/// Frame interval the window is limited to; the histogram shows twice this.
+constexpr float kTargetFrameMs = 1000.f / static_cast<float>(config::kFrameRateLimit);
+
+constexpr ImGuiWindowFlags kWindowFlags =
+    ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+    ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+    ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs;
+
+template <typename Rep, typename Period>
+[[nodiscard]] float toMilliseconds(std::chrono::duration<Rep, Period> duration) noexcept {
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+void drawName(std::string_view name) {
+    ImGui::TextUnformatted(name.data(), name.data() + name.size());
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+PerformanceOverlay::PerformanceOverlay(sf::RenderWindow& window) : window_(window) {
+    initialized_ = ImGui::SFML::Init(window_);
+    if (!initialized_) {
+        std::cerr << "PerformanceOverlay: failed to initialize ImGui-SFML\n";
+        return;
+    }
+    // Deployed builds should not leave an imgui.ini next to the executable
+    ImGui::GetIO().IniFilename = nullptr;
+}
+
+PerformanceOverlay::~PerformanceOverlay() {
+    if (initialized_) {
+        ImGui::SFML::Shutdown(window_);
+    }
+}
+
+// ============================================================================
+// Frame Timing
+// ============================================================================
+
+void PerformanceOverlay::restart() noexcept {
+    next_sample_ = 0;
+    sample_count_ = 0;
+    frame_start_.reset();
+    imgui_clock_.restart();
+}
+
+void PerformanceOverlay::beginFrame() noexcept {
+    const Clock::time_point now = Clock::now();
+    if (frame_start_) {
+        frame_ms_[next_sample_] = toMilliseconds(now - *frame_start_);
+        next_sample_ = (next_sample_ + 1) % kHistorySize;
+        sample_count_ = std::min(sample_count_ + 1, kHistorySize);
+    }
+    frame_start_ = now;
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void PerformanceOverlay::draw(const FrameReport& report) {
+    if (!initialized_) return;
+    const float build_ms = frame_start_ ? toMilliseconds(Clock::now() - *frame_start_) : 0.f;
+
+    // Input is never passed in: the window ignores it anyway
+    ImGui::SFML::Update(window_, imgui_clock_.restart());
+    ImGui::SetNextWindowPos({kMargin, kMargin}, ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(kBackgroundAlpha);
+    if (ImGui::Begin("Performance", nullptr, kWindowFlags)) {
+        drawFrameSection(build_ms, report.draw_calls);
+        drawAnimationSection(report.animation);
+        drawEngineSection(report.engine);
+        if constexpr (chess::instrument::kEnabled) {
+            drawCounterSection();
+        }
+    }
+    ImGui::End();
+    ImGui::SFML::Render(window_);
+}
+
+void PerformanceOverlay::drawFrameSection(float build_ms, int draw_calls) {
+    // Oldest first: once full, the ring buffer starts at the next write
+    const bool full = sample_count_ == kHistorySize;
+    const auto samples = std::span{frame_ms_}.first(sample_count_);
+    const std::size_t last_sample = (next_sample_ + kHistorySize - 1) % kHistorySize;
+    const float last = samples.empty() ? 0.f : frame_ms_[last_sample];
+    const float worst = samples.empty() ? 0.f : std::ranges::max(samples);
+    const float average = samples.empty() ? 0.f
+                          : std::accumulate(samples.begin(), samples.end(), 0.f) /
+                                static_cast<float>(samples.size());
+
+    ImGui::Text("Frame %.2f ms (avg %.2f, max %.2f)", last, average, worst);
+    ImGui::PlotHistogram("##frame_times", frame_ms_.data(), static_cast<int>(sample_count_),
+                         full ? static_cast<int>(next_sample_) : 0, nullptr, 0.f,
+                         std::max(worst, 2.f * kTargetFrameMs), kHistogramSize);
+    ImGui::Text("Build %.2f ms, %d draw calls", build_ms, draw_calls);
+}
+
+void PerformanceOverlay::drawAnimationSection(const AnimationInfo* animation) {
+    ImGui::Separator();
+    if (animation == nullptr || animation->isComplete()) {
+        ImGui::TextUnformatted("Animation: idle");
+        return;
+    }
+    ImGui::Text("Animation: %s-%s %.0f%%", chess::toAlgebraic(animation->from).c_str(),
+                chess::toAlgebraic(animation->to).c_str(), animation->progress * 100.f);
+}
+
+void PerformanceOverlay::drawEngineSection(const EngineStatus& engine) {
+    ImGui::Separator();
+    if (!engine.attached) {
+        ImGui::TextUnformatted("Engine: off");
+        return;
+    }
+    ImGui::Text("Engine: %s", engine.searching ? "searching" : "idle");
+    if (engine.info == nullptr) return;
+
+    const engine::SearchInfo& info = *engine.info;
+    ImGui::Text("Depth %d, %llu nodes, %llu nps", info.depth,
+                static_cast<unsigned long long>(info.nodes),
+                static_cast<unsigned long long>(info.nps));
+    ImGui::Text("Hash %.1f%% full", static_cast<float>(info.hashfull) / 10.f);
+
+    std::string pv;
+    for (const chess::Move& move : info.pv) {
+        if (!pv.empty()) pv.push_back(' ');
+        pv += chess::toUci(move);
+    }
+    ImGui::PushTextWrapPos(kHistogramSize.x);
+    ImGui::Text("PV %s", pv.c_str());
+    ImGui::PopTextWrapPos();
+}
+
+void PerformanceOverlay::drawCounterSection() {
+    ImGui::Separator();
+    const chess::instrument::Snapshot snapshot = chess::instrument::snapshot();
+    for (std::size_t i = 0; i < chess::instrument::kCounterCount; ++i) {
+        drawName(chess::instrument::name(static_cast<chess::instrument::Counter>(i)));
+        ImGui::SameLine();
+        ImGui::Text("%llu", static_cast<unsigned long long>(snapshot.counters[i]));
+    }
+    for (std::size_t i = 0; i < chess::instrument::kTimerCount; ++i) {
+        const chess::instrument::TimerTotals& timer = snapshot.timers[i];
+        drawName(chess::instrument::name(static_cast<chess::instrument::Timer>(i)));
+        ImGui::SameLine();
+        ImGui::Text("%llu calls, %.1f ms", static_cast<unsigned long long>(timer.calls),
+                    toMilliseconds(timer.total));
+    }
+}
+
+} // namespace ui
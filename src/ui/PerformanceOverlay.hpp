@@ -0,0 +1,74 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include "IRenderer.hpp"
+
+/// @file PerformanceOverlay.hpp
+/// @brief ImGui window with frame timing, renderer, animation and engine statistics.
+
+namespace ui {
+
+/// What the renderer reports about the frame the overlay is drawn over.
+struct FrameReport {
+    int draw_calls{0};  ///< Board and piece draw calls, not counting the overlay's own
+    const AnimationInfo* animation{nullptr};
+    EngineStatus engine{};
+};
+
+/// Diagnostics overlay drawn with ImGui-SFML in the top-left corner.
+///
+/// Shows a histogram of recent frame times (the interval between frames),
+/// the CPU time spent building the current frame, the draw-call count, the
+/// animation in flight and, while an engine is attached, its latest depth,
+/// speed, hash usage and principal variation. Instrumented builds
+/// (CHESS_INSTRUMENT) also list the hot-path counters.
+///
+/// The window takes no input, so clicks and keys still reach the board.
+class PerformanceOverlay {
+public:
+    /// Frames kept for the histogram (two seconds at 60 FPS).
+    static constexpr std::size_t kHistorySize = 120;
+
+    /// Initialize ImGui-SFML for `window`.
+    explicit PerformanceOverlay(sf::RenderWindow& window);
+
+    /// Shut ImGui-SFML down for the window.
+    ~PerformanceOverlay();
+
+    PerformanceOverlay(const PerformanceOverlay&) = delete;
+    PerformanceOverlay& operator=(const PerformanceOverlay&) = delete;
+    PerformanceOverlay(PerformanceOverlay&&) = delete;
+    PerformanceOverlay& operator=(PerformanceOverlay&&) = delete;
+
+    /// Forget the frame history, e.g. when shown again after idling.
+    void restart() noexcept;
+
+    /// Mark the start of a frame (before anything is drawn).
+    void beginFrame() noexcept;
+
+    /// Draw the overlay on top of the current frame.
+    void draw(const FrameReport& report);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void drawFrameSection(float build_ms, int draw_calls);
+    void drawAnimationSection(const AnimationInfo* animation);
+    void drawEngineSection(const EngineStatus& engine);
+    void drawCounterSection();
+
+    sf::RenderWindow& window_;
+    bool initialized_{false};
+    sf::Clock imgui_clock_;  // ImGui's time step
+
+    // Frame times in milliseconds, a ring buffer written at next_sample_
+    std::array<float, kHistorySize> frame_ms_{};
+    std::size_t next_sample_{0};
+    std::size_t sample_count_{0};
+    std::optional<Clock::time_point> frame_start_;
+};
+
+} // namespace ui
@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <chrono>
 #include <ranges>
+#include <thread>
+#include <utility>
 
 namespace ui {
 
@@ -22,46 +24,44 @@ bool SfmlInputHandler::isRunning() const noexcept {
 }
 
 std::optional<chess::Move> SfmlInputHandler::processInput() {
+    if (pending_event_) {
+        handleEvent(*pending_event_);
+        pending_event_.reset();
+    }
+
     sf::Event event;
+    while (window_.pollEvent(event)) {
+        handleEvent(event);
+    }
 
-    // During animation, only handle close events
-    if (animation_ && animation_->active) {
-        while (window_.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                handleCloseEvent();
-            }
+    return std::nullopt;
+}
+
+void SfmlInputHandler::waitForInput(std::optional<std::chrono::milliseconds> timeout) {
+    if (pending_event_) return;
+
+    sf::Event event;
+    if (!timeout) {
+        if (window_.waitEvent(event)) {
+            pending_event_ = event;
         }
-        return std::nullopt;
+        return;
     }
 
-    while (window_.pollEvent(event)) {
-        switch (event.type) {
-            case sf::Event::Closed:
-                handleCloseEvent();
-                break;
-
-            case sf::Event::MouseButtonPressed:
-                if (event.mouseButton.button == sf::Mouse::Left) {
-                    handleMousePress(event.mouseButton.x, event.mouseButton.y);
-                }
-                break;
-
-            case sf::Event::MouseMoved:
-                handleMouseMove(event.mouseMove.x, event.mouseMove.y);
-                break;
-
-            case sf::Event::MouseButtonReleased:
-                if (event.mouseButton.button == sf::Mouse::Left) {
-                    handleMouseRelease(event.mouseButton.x, event.mouseButton.y);
-                }
-                break;
-
-            default:
-                break;
-        }
+    // SFML 2 cannot wait with a timeout: check once, then sleep it off
+    if (window_.pollEvent(event)) {
+        pending_event_ = event;
+    } else {
+        std::this_thread::sleep_for(*timeout);
     }
+}
 
-    return std::nullopt;
+bool SfmlInputHandler::takeRedrawRequest() noexcept {
+    return std::exchange(redraw_requested_, false);
+}
+
+std::optional<InputCommand> SfmlInputHandler::takeCommand() {
+    return std::exchange(pending_command_, std::nullopt);
 }
 
 void SfmlInputHandler::setSelected(std::optional<chess::Square> square) {
@@ -129,6 +129,51 @@ void SfmlInputHandler::stopAnimation() {
 // Event Handlers
 // ============================================================================
 
+void SfmlInputHandler::handleEvent(const sf::Event& event) {
+    // Pointer motion only shows while a piece is held; everything else may
+    // change the picture (or, like Resized and GainedFocus, need a repaint)
+    if (event.type != sf::Event::MouseMoved || drag_source_) {
+        redraw_requested_ = true;
+    }
+
+    // During animation, only handle close events
+    if (animation_ && animation_->active) {
+        if (event.type == sf::Event::Closed) {
+            handleCloseEvent();
+        }
+        return;
+    }
+
+    switch (event.type) {
+        case sf::Event::Closed:
+            handleCloseEvent();
+            break;
+
+        case sf::Event::MouseButtonPressed:
+            if (event.mouseButton.button == sf::Mouse::Left) {
+                handleMousePress(event.mouseButton.x, event.mouseButton.y);
+            }
+            break;
+
+        case sf::Event::MouseMoved:
+            handleMouseMove(event.mouseMove.x, event.mouseMove.y);
+            break;
+
+        case sf::Event::MouseButtonReleased:
+            if (event.mouseButton.button == sf::Mouse::Left) {
+                handleMouseRelease(event.mouseButton.x, event.mouseButton.y);
+            }
+            break;
+
+        case sf::Event::KeyPressed:
+            handleKeyPress(event.key);
+            break;
+
+        default:
+            break;
+    }
+}
+
 void SfmlInputHandler::handleCloseEvent() {
     window_.close();
     running_ = false;
@@ -179,6 +224,28 @@ void SfmlInputHandler::handleMouseRelease(int x, int y) {
     clearLegalMoves();
 }
 
+void SfmlInputHandler::handleKeyPress(const sf::Event::KeyEvent& key) {
+    if (key.code == sf::Keyboard::F3) {
+        pending_command_ = InputCommand::ToggleOverlay;
+        return;
+    }
+
+    // Not while a piece is held: the drag would refer to the old position
+    if (drag_source_) return;
+
+    // Ctrl+Z / Left arrow: undo; Ctrl+Y, Ctrl+Shift+Z / Right arrow: redo
+    const bool undo = key.code == sf::Keyboard::Left ||
+                      (key.control && !key.shift && key.code == sf::Keyboard::Z);
+    const bool redo = key.code == sf::Keyboard::Right ||
+                      (key.control && key.code == sf::Keyboard::Y) ||
+                      (key.control && key.shift && key.code == sf::Keyboard::Z);
+    if (!undo && !redo) return;
+
+    pending_command_ = undo ? InputCommand::Undo : InputCommand::Redo;
+    selected_.reset();
+    clearLegalMoves();
+}
+
 // ============================================================================
 // Coordinate Conversion
 // ============================================================================
@@ -198,23 +265,16 @@ std::optional<chess::Square> SfmlInputHandler::pixelToSquare(int pixel_x, int pi
 // ============================================================================
 
 void SfmlInputHandler::updateLegalMoves(chess::Square from) {
-    legal_move_squares_.clear();
-    if (!game_ref_) return;
-
-    const auto moves = game_ref_->legalMoves();
-    for (const auto& move : moves) {
-        if (move.from == from) {
-            legal_move_squares_.push_back(move.to);
-        }
-    }
+    legal_targets_ = game_ref_ ? game_ref_->legalDestinations()[chess::toIndex(from)]
+                               : chess::kEmptyBitboard;
 }
 
 void SfmlInputHandler::clearLegalMoves() {
-    legal_move_squares_.clear();
+    legal_targets_ = chess::kEmptyBitboard;
 }
 
 bool SfmlInputHandler::isLegalDestination(chess::Square sq) const noexcept {
-    return std::ranges::find(legal_move_squares_, sq) != legal_move_squares_.end();
+    return chess::contains(legal_targets_, chess::toIndex(sq));
 }
 
 } // namespace ui
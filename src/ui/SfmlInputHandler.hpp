@@ -5,8 +5,6 @@
 #include <SFML/Graphics.hpp>
 #include <chrono>
 #include <optional>
-#include <span>
-#include <vector>
 
 namespace ui {
 
@@ -20,6 +18,13 @@ public:
 
     // IInputHandler interface
     [[nodiscard]] std::optional<chess::Move> processInput() override;
+    [[nodiscard]] std::optional<InputCommand> takeCommand() override;
+    void waitForInput(std::optional<std::chrono::milliseconds> timeout) override;
+    [[nodiscard]] bool takeRedrawRequest() noexcept override;
+    [[nodiscard]] bool isDragging() const noexcept override { return drag_source_.has_value(); }
+    [[nodiscard]] chess::Bitboard legalMoveHighlights() const noexcept override {
+        return legal_targets_;
+    }
     void setSelected(std::optional<chess::Square> square) override;
     [[nodiscard]] bool isRunning() const noexcept override;
     [[nodiscard]] std::optional<chess::Move> updateAnimation() override;
@@ -35,9 +40,6 @@ public:
     [[nodiscard]] std::optional<chess::Square> getSelected() const noexcept { return selected_; }
     [[nodiscard]] std::optional<chess::Square> getDragSource() const noexcept { return drag_source_; }
     [[nodiscard]] std::optional<sf::Vector2f> getDragPosition() const noexcept { return drag_position_; }
-    [[nodiscard]] std::span<const chess::Square> getLegalMoveSquares() const noexcept {
-        return legal_move_squares_;
-    }
 
     /// Set the game reference for piece and legal move lookup.
     void setGameRef(const chess::IGame* game) noexcept { game_ref_ = game; }
@@ -56,10 +58,12 @@ private:
     };
 
     // Event handlers
+    void handleEvent(const sf::Event& event);
     void handleCloseEvent();
     void handleMousePress(int x, int y);
     void handleMouseMove(int x, int y);
     void handleMouseRelease(int x, int y);
+    void handleKeyPress(const sf::Event::KeyEvent& key);
 
     // Coordinate conversion
     [[nodiscard]] std::optional<chess::Square> pixelToSquare(int pixel_x, int pixel_y) const noexcept;
@@ -78,7 +82,10 @@ private:
     std::optional<chess::Square> drag_source_;
     std::optional<sf::Vector2f> drag_position_;
     std::optional<AnimationState> animation_;
-    std::vector<chess::Square> legal_move_squares_;
+    chess::Bitboard legal_targets_{chess::kEmptyBitboard};  // Of the selected piece
+    std::optional<InputCommand> pending_command_;
+    std::optional<sf::Event> pending_event_;  // Received by waitForInput()
+    bool redraw_requested_{true};
 };
 
 } // namespace ui
@@ -1,8 +1,10 @@
 ﻿#include "SfmlRenderer.hpp"
 #include "Config.hpp"
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <numbers>
 #include <ranges>
 #include <string>
 
@@ -29,7 +31,15 @@ const sf::Color kLegalMoveColor{100, 100, 100, 180};
 constexpr int kPieceTypesPerRow = 6;
 constexpr int kColorRows = 2;
 
+// Outline thickness of the selection frame and fallback pieces, in pixels
+constexpr float kOutlineThickness = 2.f;
+
+// Segments per circle (dots, rings, fallback pieces); SFML's default
+constexpr int kCircleSegments = 30;
+
 // Fallback rendering constants
+const sf::Color kFallbackBlackPieceColor{40, 40, 40};
+const sf::Color kFallbackCrownColor{200, 200, 50};
 constexpr float kCrownWidth = 0.45f;
 constexpr float kCrownHeight = 0.08f;
 constexpr float kCrownOffsetY = 0.28f;
@@ -136,6 +146,65 @@ namespace {
 
 } // namespace
 
+// ============================================================================
+// Vertex Geometry
+// ============================================================================
+
+namespace {
+
+/// Append a rectangle as two triangles, optionally mapped to a texture region.
+void appendQuad(sf::VertexArray& vertices, sf::Vector2f pos, sf::Vector2f size, sf::Color color,
+                sf::FloatRect tex = {}) {
+    const std::array<sf::Vector2f, 4> corners = {
+        pos, sf::Vector2f{pos.x + size.x, pos.y}, pos + size, sf::Vector2f{pos.x, pos.y + size.y}};
+    const std::array<sf::Vector2f, 4> tex_corners = {
+        sf::Vector2f{tex.left, tex.top}, sf::Vector2f{tex.left + tex.width, tex.top},
+        sf::Vector2f{tex.left + tex.width, tex.top + tex.height},
+        sf::Vector2f{tex.left, tex.top + tex.height}};
+    for (const std::size_t i : {0u, 1u, 2u, 0u, 2u, 3u}) {
+        vertices.append(sf::Vertex(corners[i], color, tex_corners[i]));
+    }
+}
+
+/// Append a frame of the given thickness drawn just outside a rectangle.
+void appendFrame(sf::VertexArray& vertices, sf::Vector2f pos, sf::Vector2f size, float thickness,
+                 sf::Color color) {
+    const float outer_width = size.x + 2.f * thickness;
+    appendQuad(vertices, {pos.x - thickness, pos.y - thickness}, {outer_width, thickness}, color);
+    appendQuad(vertices, {pos.x - thickness, pos.y + size.y}, {outer_width, thickness}, color);
+    appendQuad(vertices, {pos.x - thickness, pos.y}, {thickness, size.y}, color);
+    appendQuad(vertices, {pos.x + size.x, pos.y}, {thickness, size.y}, color);
+}
+
+[[nodiscard]] sf::Vector2f circlePoint(sf::Vector2f center, float radius, int segment) noexcept {
+    constexpr float kStep = 2.f * std::numbers::pi_v<float> / kCircleSegments;
+    const float angle = kStep * static_cast<float>(segment);
+    return {center.x + radius * std::cos(angle), center.y + radius * std::sin(angle)};
+}
+
+void appendDisc(sf::VertexArray& vertices, sf::Vector2f center, float radius, sf::Color color) {
+    for (int i = 0; i < kCircleSegments; ++i) {
+        vertices.append(sf::Vertex(center, color));
+        vertices.append(sf::Vertex(circlePoint(center, radius, i), color));
+        vertices.append(sf::Vertex(circlePoint(center, radius, i + 1), color));
+    }
+}
+
+void appendRing(sf::VertexArray& vertices, sf::Vector2f center, float inner_radius,
+                float outer_radius, sf::Color color) {
+    for (int i = 0; i < kCircleSegments; ++i) {
+        const sf::Vector2f inner0 = circlePoint(center, inner_radius, i);
+        const sf::Vector2f inner1 = circlePoint(center, inner_radius, i + 1);
+        const sf::Vector2f outer0 = circlePoint(center, outer_radius, i);
+        const sf::Vector2f outer1 = circlePoint(center, outer_radius, i + 1);
+        for (const sf::Vector2f& point : {inner0, outer0, outer1, inner0, outer1, inner1}) {
+            vertices.append(sf::Vertex(point, color));
+        }
+    }
+}
+
+} // namespace
+
 // ============================================================================
 // SfmlRenderer - Construction
 // ============================================================================
@@ -176,8 +245,8 @@ void SfmlRenderer::initializeSpriteRects() {
     for (int row = 0; row < kColorRows; ++row) {
         for (int col = 0; col < kPieceTypesPerRow; ++col) {
             const int idx = row * kPieceTypesPerRow + col;
-            piece_sprites_[idx].setTexture(pieces_texture_);
-            piece_sprites_[idx].setTextureRect({col * cell_w, row * cell_h, cell_w, cell_h});
+            const sf::IntRect cell{col * cell_w, row * cell_h, cell_w, cell_h};
+            piece_rects_[idx] = sf::FloatRect(cell);
         }
     }
 }
@@ -208,16 +277,18 @@ void SfmlRenderer::setAnimationState(const AnimationInfo* animation) noexcept {
     current_animation_ = animation;
 }
 
-void SfmlRenderer::setLegalMoveHighlights(std::span<const chess::Square> squares) noexcept {
-    legal_move_squares_.assign(squares.begin(), squares.end());
+void SfmlRenderer::setLegalMoveHighlights(chess::Bitboard squares) noexcept {
+    if (squares == legal_move_targets_) return;
+    legal_move_targets_ = squares;
+    batch_state_.reset();
 }
 
 void SfmlRenderer::clearLegalMoveHighlights() noexcept {
-    legal_move_squares_.clear();
+    setLegalMoveHighlights(chess::kEmptyBitboard);
 }
 
 void SfmlRenderer::setSelected(std::optional<chess::Square> sel) noexcept {
-    selected_ = sel;
+    selected_ = sel;  // Picked up by the next render()
 }
 
 void SfmlRenderer::setDragState(std::optional<chess::Square> source,
@@ -241,16 +312,8 @@ std::string SfmlRenderer::unicodeGlyph(chess::PieceType type, chess::Color color
     return unicodeToUtf8(pieceToUnicode(type, color));
 }
 
-void SfmlRenderer::ensureSpriteScale(float tile_size) {
-    if (!textures_loaded_) return;
-    
-    const auto rect = piece_sprites_[0].getTextureRect();
-    if (rect.width == 0 || rect.height == 0) return;
-    
-    const float scale = tile_size / static_cast<float>(rect.width);
-    for (auto& sprite : piece_sprites_) {
-        sprite.setScale(scale, scale);
-    }
+sf::RenderStates SfmlRenderer::pieceStates() const noexcept {
+    return textures_loaded_ ? sf::RenderStates(&pieces_texture_) : sf::RenderStates::Default;
 }
 
 float SfmlRenderer::calculateTileSize() const noexcept {
@@ -259,62 +322,101 @@ float SfmlRenderer::calculateTileSize() const noexcept {
 }
 
 // ============================================================================
-// SfmlRenderer - Board Drawing
+// SfmlRenderer - Batch Building
 // ============================================================================
 
-void SfmlRenderer::drawBoard(float tile) noexcept {
+void SfmlRenderer::updateBatches(const chess::IGame& game, float tile) {
+    const bool animating = current_animation_ != nullptr && current_animation_->active;
+    const BatchState state{
+        .tile = tile,
+        .position = game.positionKey(),
+        .selected = selected_,
+        .hidden_drag = drag_source_,
+        .hidden_animation = animating ? std::optional{current_animation_->from} : std::nullopt,
+    };
+    if (batch_state_ == state) return;
+
+    buildBoardVertices(game, tile);
+    buildPieceVertices(game, tile);
+    batch_state_ = state;
+}
+
+void SfmlRenderer::buildBoardVertices(const chess::IGame& game, float tile) {
+    board_vertices_.clear();
+
     for (int rank = 0; rank < chess::kBoardSize; ++rank) {
         for (int file = 0; file < chess::kBoardSize; ++file) {
             const bool is_dark = ((rank + file) % 2) == 1;
-            
-            sf::RectangleShape square({tile, tile});
-            square.setPosition(static_cast<float>(file) * tile, static_cast<float>(rank) * tile);
-            square.setFillColor(is_dark ? kDarkSquareColor : kLightSquareColor);
-            window_.draw(square);
+            appendQuad(board_vertices_, squareToPixel({rank, file}, tile), {tile, tile},
+                       is_dark ? kDarkSquareColor : kLightSquareColor);
         }
     }
-}
 
-void SfmlRenderer::drawSelectionHighlight(float tile) noexcept {
-    if (!selected_) return;
-
-    sf::RectangleShape highlight({tile, tile});
-    highlight.setPosition(squareToPixel(*selected_, tile));
-    highlight.setFillColor(kSelectionFillColor);
-    highlight.setOutlineColor(kSelectionOutlineColor);
-    highlight.setOutlineThickness(2.f);
-    window_.draw(highlight);
-}
+    if (selected_) {
+        const auto pos = squareToPixel(*selected_, tile);
+        appendQuad(board_vertices_, pos, {tile, tile}, kSelectionFillColor);
+        appendFrame(board_vertices_, pos, {tile, tile}, kOutlineThickness, kSelectionOutlineColor);
+    }
 
-void SfmlRenderer::drawLegalMoveHighlights(const chess::IGame& game, float tile) noexcept {
-    for (const auto& sq : legal_move_squares_) {
+    for (chess::Bitboard squares = legal_move_targets_; squares != chess::kEmptyBitboard;) {
+        const chess::Square sq = chess::toSquare(chess::popLsb(squares));
         const auto center = squareCenter(sq, tile);
         const bool is_capture = game.board().hasPieceAt(sq);
-        
+
         if (is_capture) {
-            drawCaptureRing(center, tile);
+            // Outline drawn outside the radius, like sf::CircleShape's
+            const float radius = tile * config::kLegalMoveRingRadius;
+            appendRing(board_vertices_, center, radius,
+                       radius + tile * config::kLegalMoveRingThickness, kLegalMoveColor);
         } else {
-            drawMoveDot(center, tile);
+            appendDisc(board_vertices_, center, tile * config::kLegalMoveDotRadius,
+                       kLegalMoveColor);
         }
     }
 }
 
-void SfmlRenderer::drawMoveDot(sf::Vector2f center, float tile) noexcept {
-    sf::CircleShape dot(tile * config::kLegalMoveDotRadius);
-    dot.setOrigin(dot.getRadius(), dot.getRadius());
-    dot.setPosition(center);
-    dot.setFillColor(kLegalMoveColor);
-    window_.draw(dot);
+void SfmlRenderer::buildPieceVertices(const chess::IGame& game, float tile) {
+    piece_vertices_.clear();
+    if (!batchesPieces()) return;
+
+    for (int rank = 0; rank < chess::kBoardSize; ++rank) {
+        for (int file = 0; file < chess::kBoardSize; ++file) {
+            const chess::Square sq{rank, file};
+            
+            if (shouldSkipPiece(sq)) continue;
+            
+            const auto& piece_opt = game.board().at(sq);
+            if (!piece_opt) continue;
+
+            appendPiece(piece_vertices_, *piece_opt, squareToPixel(sq, tile), tile);
+        }
+    }
 }
 
-void SfmlRenderer::drawCaptureRing(sf::Vector2f center, float tile) noexcept {
-    sf::CircleShape ring(tile * config::kLegalMoveRingRadius);
-    ring.setOrigin(ring.getRadius(), ring.getRadius());
-    ring.setPosition(center);
-    ring.setFillColor(sf::Color::Transparent);
-    ring.setOutlineColor(kLegalMoveColor);
-    ring.setOutlineThickness(tile * config::kLegalMoveRingThickness);
-    window_.draw(ring);
+void SfmlRenderer::appendPiece(sf::VertexArray& vertices, const chess::Piece& piece,
+                               sf::Vector2f pos, float tile) const {
+    if (textures_loaded_) {
+        // Scaled to the tile width, keeping the sheet cell's aspect ratio
+        const sf::FloatRect& rect = piece_rects_[spriteIndex(piece.type, piece.color)];
+        if (rect.width <= 0.f) return;
+        const float height = tile * rect.height / rect.width;
+        appendQuad(vertices, pos, {tile, height}, sf::Color::White, rect);
+        return;
+    }
+
+    const auto center = sf::Vector2f(pos.x + tile / 2.f, pos.y + tile / 2.f);
+    const auto fill = (piece.color == chess::Color::White) 
+                      ? sf::Color::White : kFallbackBlackPieceColor;
+    const float radius = tile * config::kFallbackPieceRadius;
+
+    appendDisc(vertices, center, radius, fill);
+    appendRing(vertices, center, radius, radius + kOutlineThickness, sf::Color::Black);
+
+    if (piece.type != chess::PieceType::Pawn) {
+        const sf::Vector2f crown{tile * kCrownWidth, tile * kCrownHeight};
+        const sf::Vector2f crown_center{center.x, pos.y + tile * kCrownOffsetY};
+        appendQuad(vertices, crown_center - crown / 2.f, crown, kFallbackCrownColor);
+    }
 }
 
 // ============================================================================
@@ -329,7 +431,7 @@ bool SfmlRenderer::shouldSkipPiece(chess::Square sq) const noexcept {
     return dragging || animating;
 }
 
-void SfmlRenderer::drawPieces(const chess::IGame& game, float tile) {
+void SfmlRenderer::drawPieceGlyphs(const chess::IGame& game, float tile) {
     for (int rank = 0; rank < chess::kBoardSize; ++rank) {
         for (int file = 0; file < chess::kBoardSize; ++file) {
             const chess::Square sq{rank, file};
@@ -339,25 +441,19 @@ void SfmlRenderer::drawPieces(const chess::IGame& game, float tile) {
             const auto& piece_opt = game.board().at(sq);
             if (!piece_opt) continue;
 
-            drawPiece(*piece_opt, squareToPixel(sq, tile), tile);
+            drawPieceGlyph(*piece_opt, squareToPixel(sq, tile), tile);
         }
     }
 }
 
 void SfmlRenderer::drawPiece(const chess::Piece& piece, sf::Vector2f pos, float tile) {
-    if (textures_loaded_) {
-        drawPieceSprite(piece, pos);
-    } else if (font_loaded_) {
+    if (!batchesPieces()) {
         drawPieceGlyph(piece, pos, tile);
-    } else {
-        drawFallbackPiece(piece, pos, tile);
+        return;
     }
-}
-
-void SfmlRenderer::drawPieceSprite(const chess::Piece& piece, sf::Vector2f pos) {
-    sf::Sprite sprite = piece_sprites_[spriteIndex(piece.type, piece.color)];
-    sprite.setPosition(pos);
-    window_.draw(sprite);
+    floating_vertices_.clear();
+    appendPiece(floating_vertices_, piece, pos, tile);
+    draw(floating_vertices_, pieceStates());
 }
 
 void SfmlRenderer::drawPieceGlyph(const chess::Piece& piece, sf::Vector2f pos, float tile) {
@@ -373,29 +469,7 @@ void SfmlRenderer::drawPieceGlyph(const chess::Piece& piece, sf::Vector2f pos, f
     text.setOutlineColor({50, 50, 50});
     text.setOutlineThickness(2.f);
     
-    window_.draw(text);
-}
-
-void SfmlRenderer::drawFallbackPiece(const chess::Piece& piece, sf::Vector2f pos, float tile) {
-    const auto center = sf::Vector2f(pos.x + tile / 2.f, pos.y + tile / 2.f);
-    const auto fill = (piece.color == chess::Color::White) 
-                      ? sf::Color::White : sf::Color(40, 40, 40);
-
-    sf::CircleShape circle(tile * config::kFallbackPieceRadius);
-    circle.setOrigin(circle.getRadius(), circle.getRadius());
-    circle.setPosition(center);
-    circle.setFillColor(fill);
-    circle.setOutlineColor(sf::Color::Black);
-    circle.setOutlineThickness(2.f);
-    window_.draw(circle);
-
-    if (piece.type != chess::PieceType::Pawn) {
-        sf::RectangleShape crown({tile * kCrownWidth, tile * kCrownHeight});
-        crown.setOrigin(crown.getSize().x / 2.f, crown.getSize().y / 2.f);
-        crown.setPosition(center.x, pos.y + tile * kCrownOffsetY);
-        crown.setFillColor({200, 200, 50});
-        window_.draw(crown);
-    }
+    draw(text);
 }
 
 void SfmlRenderer::drawDraggedPiece(const chess::IGame& game, float tile) {
@@ -417,8 +491,6 @@ void SfmlRenderer::renderPieceAnimation(const chess::IGame& /*game*/,
     if (animation.isComplete()) return;
 
     const float tile = calculateTileSize();
-    ensureSpriteScale(tile);
-
     const auto from_px = squareToPixel(animation.from, tile);
     const auto to_px = squareToPixel(animation.to, tile);
     const auto current_pos = from_px + (to_px - from_px) * animation.progress;
@@ -431,15 +503,19 @@ void SfmlRenderer::renderPieceAnimation(const chess::IGame& /*game*/,
 // ============================================================================
 
 void SfmlRenderer::render(const chess::IGame& game) {
+    if (overlay_visible_) overlay_->beginFrame();
+    draw_calls_ = 0;
     window_.clear(sf::Color::Black);
     
     const float tile = calculateTileSize();
-    ensureSpriteScale(tile);
+    updateBatches(game, tile);
 
-    drawBoard(tile);
-    drawSelectionHighlight(tile);
-    drawLegalMoveHighlights(game, tile);
-    drawPieces(game, tile);
+    draw(board_vertices_);
+    if (batchesPieces()) {
+        draw(piece_vertices_, pieceStates());
+    } else {
+        drawPieceGlyphs(game, tile);
+    }
     drawDraggedPiece(game, tile);
 }
 
@@ -451,4 +527,36 @@ sf::RenderWindow& SfmlRenderer::getWindow() noexcept {
     return window_;
 }
 
+void SfmlRenderer::draw(const sf::Drawable& drawable, const sf::RenderStates& states) {
+    window_.draw(drawable, states);
+    ++draw_calls_;
+}
+
+// ============================================================================
+// SfmlRenderer - Diagnostics
+// ============================================================================
+
+void SfmlRenderer::toggleOverlay() {
+    overlay_visible_ = !overlay_visible_;
+    if (!overlay_visible_) return;
+
+    if (!overlay_) {
+        overlay_ = std::make_unique<PerformanceOverlay>(window_);
+    }
+    overlay_->restart();  // The time spent hidden is not a frame
+}
+
+void SfmlRenderer::setEngineStatus(const EngineStatus& status) noexcept {
+    engine_status_ = status;
+}
+
+void SfmlRenderer::renderOverlay() {
+    if (!overlay_visible_) return;
+    overlay_->draw({
+        .draw_calls = draw_calls_,
+        .animation = current_animation_,
+        .engine = engine_status_,
+    });
+}
+
 } // namespace ui
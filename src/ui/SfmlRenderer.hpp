@@ -1,8 +1,10 @@
 ﻿#pragma once
 #include "IRenderer.hpp"
 #include "Config.hpp"
+#include "PerformanceOverlay.hpp"
 #include <SFML/Graphics.hpp>
 #include <array>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -15,6 +17,16 @@ namespace ui {
 /// 1. Sprite textures from pieces.png
 /// 2. Unicode chess glyphs (♔♕♖♗♘♙)
 /// 3. Simple geometric shapes
+///
+/// The board, selection and legal move highlights are batched into one
+/// vertex array and the pieces into a second one (textured from the
+/// pieces.png atlas, or plain shapes), so a frame costs two draw calls plus
+/// one for a piece in flight. The batches are rebuilt only when the
+/// position, highlights, selection, hidden pieces or window size change.
+/// Glyph mode draws one sf::Text per piece.
+///
+/// The PerformanceOverlay (and with it ImGui-SFML) is created the first
+/// time it is toggled on.
 class SfmlRenderer final : public IRenderer {
 public:
     explicit SfmlRenderer(sf::RenderWindow& window);
@@ -23,9 +35,13 @@ public:
     void render(const chess::IGame& game) override;
     void renderPieceAnimation(const chess::IGame& game, const AnimationInfo& animation) override;
     void setAnimationState(const AnimationInfo* animation) noexcept override;
-    void setLegalMoveHighlights(std::span<const chess::Square> squares) noexcept override;
+    void setLegalMoveHighlights(chess::Bitboard squares) noexcept override;
     void clearLegalMoveHighlights() noexcept override;
     void present() noexcept override;
+    void toggleOverlay() override;
+    [[nodiscard]] bool isOverlayVisible() const noexcept override { return overlay_visible_; }
+    void setEngineStatus(const EngineStatus& status) noexcept override;
+    void renderOverlay() override;
 
     // Additional public interface
     [[nodiscard]] sf::RenderWindow& getWindow() noexcept;
@@ -33,6 +49,17 @@ public:
     void setDragState(std::optional<chess::Square> source, std::optional<sf::Vector2f> position) noexcept;
 
 private:
+    /// Everything the batched vertex arrays depend on besides the highlights.
+    struct BatchState {
+        float tile{0.f};
+        chess::zobrist::Key position{0};
+        std::optional<chess::Square> selected;
+        std::optional<chess::Square> hidden_drag;
+        std::optional<chess::Square> hidden_animation;
+
+        [[nodiscard]] bool operator==(const BatchState&) const noexcept = default;
+    };
+
     // Asset loading
     void loadPieceTextures();
     void loadFallbackFont();
@@ -41,23 +68,26 @@ private:
     // Sprite/glyph utilities
     [[nodiscard]] int spriteIndex(chess::PieceType type, chess::Color color) const noexcept;
     [[nodiscard]] std::string unicodeGlyph(chess::PieceType type, chess::Color color) const noexcept;
-    void ensureSpriteScale(float tile_size);
     [[nodiscard]] float calculateTileSize() const noexcept;
+    [[nodiscard]] bool batchesPieces() const noexcept { return textures_loaded_ || !font_loaded_; }
+    [[nodiscard]] sf::RenderStates pieceStates() const noexcept;
 
-    // Board drawing
-    void drawBoard(float tile) noexcept;
-    void drawSelectionHighlight(float tile) noexcept;
-    void drawLegalMoveHighlights(const chess::IGame& game, float tile) noexcept;
-    void drawMoveDot(sf::Vector2f center, float tile) noexcept;
-    void drawCaptureRing(sf::Vector2f center, float tile) noexcept;
+    /// Draw to the window, counting the call for the overlay.
+    void draw(const sf::Drawable& drawable,
+              const sf::RenderStates& states = sf::RenderStates::Default);
+
+    // Batch building
+    void updateBatches(const chess::IGame& game, float tile);
+    void buildBoardVertices(const chess::IGame& game, float tile);
+    void buildPieceVertices(const chess::IGame& game, float tile);
+    void appendPiece(sf::VertexArray& vertices, const chess::Piece& piece, sf::Vector2f pos,
+                     float tile) const;
 
     // Piece drawing
     [[nodiscard]] bool shouldSkipPiece(chess::Square sq) const noexcept;
-    void drawPieces(const chess::IGame& game, float tile);
+    void drawPieceGlyphs(const chess::IGame& game, float tile);
     void drawPiece(const chess::Piece& piece, sf::Vector2f pos, float tile);
-    void drawPieceSprite(const chess::Piece& piece, sf::Vector2f pos);
     void drawPieceGlyph(const chess::Piece& piece, sf::Vector2f pos, float tile);
-    void drawFallbackPiece(const chess::Piece& piece, sf::Vector2f pos, float tile);
     void drawDraggedPiece(const chess::IGame& game, float tile);
 
     // State
@@ -66,17 +96,29 @@ private:
     std::optional<chess::Square> drag_source_;
     std::optional<sf::Vector2f> drag_position_;
     const AnimationInfo* current_animation_{nullptr};
-    std::vector<chess::Square> legal_move_squares_;
+    chess::Bitboard legal_move_targets_{chess::kEmptyBitboard};
+
+    // Batched geometry
+    sf::VertexArray board_vertices_{sf::Triangles};
+    sf::VertexArray piece_vertices_{sf::Triangles};
+    sf::VertexArray floating_vertices_{sf::Triangles};  // Dragged or animated piece
+    std::optional<BatchState> batch_state_;             // nullopt = rebuild
 
     // Texture-based rendering
     bool textures_loaded_{false};
     sf::Texture pieces_texture_;
-    std::array<sf::Sprite, 12> piece_sprites_;
+    std::array<sf::FloatRect, 12> piece_rects_{};
 
     // Font-based fallback rendering
     bool font_loaded_{false};
     sf::Font font_;
     std::array<sf::Text, 12> piece_texts_;
+
+    // Diagnostics
+    int draw_calls_{0};  // In the current frame
+    EngineStatus engine_status_;
+    std::unique_ptr<PerformanceOverlay> overlay_;
+    bool overlay_visible_{false};
 };
 
 } // namespace ui
@@ -0,0 +1,64 @@
+# Converts a PGN file into a game archive with pgn_replay --write-archive,
+# replays the archive and checks that every game that replayed from PGN ends
+# with the same result, ply count, final state and position key.
+#
+#   cmake -DPGN_REPLAY=<exe> -DINPUT=<games.pgn> -DARCHIVE=<out.mcga>
+#         -DENCODING=packed|index -P ArchiveRoundTrip.cmake
+
+foreach(var PGN_REPLAY INPUT ARCHIVE ENCODING)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "ArchiveRoundTrip.cmake: -D${var}=... is required")
+    endif()
+endforeach()
+
+# Per-game lines of a --verbose run without the leading game number, since
+# the archive renumbers the games that remain. Failed games (listed on
+# stderr) are dropped: --write-archive skips them.
+function(verbose_games output errors out_var)
+    string(REGEX MATCHALL "game [0-9]+:" failures "${errors}")
+    string(REPLACE "\n" ";" lines "${output}")
+    set(games "")
+    foreach(line IN LISTS lines)
+        if(NOT line MATCHES "^([0-9]+) (.+)$")
+            continue()
+        endif()
+        list(FIND failures "game ${CMAKE_MATCH_1}:" failed)
+        if(failed EQUAL -1)
+            list(APPEND games "${CMAKE_MATCH_2}")
+        endif()
+    endforeach()
+    set(${out_var} "${games}" PARENT_SCOPE)
+endfunction()
+
+file(REMOVE ${ARCHIVE})
+execute_process(
+    COMMAND ${PGN_REPLAY} ${INPUT} --verbose --threads 1
+            --write-archive ${ARCHIVE} --encoding ${ENCODING}
+    OUTPUT_VARIABLE pgn_output
+    ERROR_VARIABLE pgn_errors
+)
+if(NOT EXISTS ${ARCHIVE})
+    message(FATAL_ERROR "pgn_replay wrote no archive:\n${pgn_output}${pgn_errors}")
+endif()
+verbose_games("${pgn_output}" "${pgn_errors}" pgn_games)
+
+execute_process(
+    COMMAND ${PGN_REPLAY} ${ARCHIVE} --verbose --threads 1
+    RESULT_VARIABLE status
+    OUTPUT_VARIABLE archive_output
+    ERROR_VARIABLE archive_errors
+)
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "Replaying ${ARCHIVE} failed:\n${archive_errors}")
+endif()
+verbose_games("${archive_output}" "${archive_errors}" archive_games)
+
+list(LENGTH pgn_games count)
+if(count EQUAL 0)
+    message(FATAL_ERROR "No game replayed from ${INPUT}")
+endif()
+if(NOT archive_games STREQUAL pgn_games)
+    string(REPLACE ";" "\n" pgn_games "${pgn_games}")
+    string(REPLACE ";" "\n" archive_games "${archive_games}")
+    message(FATAL_ERROR "Archive replay differs.\nPGN:\n${pgn_games}\nArchive:\n${archive_games}")
+endif()
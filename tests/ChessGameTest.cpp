@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "TestSupport.hpp"
+#include "core/ChessGame.hpp"
+#include "core/Fen.hpp"
+
+/// @file ChessGameTest.cpp
+/// @brief ChessGame history: undo/redo, repetition and the fifty-move rule.
+
+namespace {
+
+using chess::ChessGame;
+using chess::test::findMove;
+using chess::test::play;
+
+[[nodiscard]] std::string fenOf(const ChessGame& game) {
+    return std::string(game.fen().view());
+}
+
+TEST(ChessGameHistory, UndoAndRedoRestorePositions) {
+    ChessGame game;
+    const std::string start = fenOf(game);
+    EXPECT_FALSE(game.undoMove());
+    EXPECT_FALSE(game.redoMove());
+
+    ASSERT_TRUE(play(game, {"e2e4", "d7d5", "e4e5", "f7f5"}));
+    const std::string after_f5 = fenOf(game);
+    EXPECT_EQ(after_f5, "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3");
+    ASSERT_TRUE(play(game, {"e5f6"}));  // En passant
+    const std::string after_ep = fenOf(game);
+
+    ASSERT_TRUE(game.undoMove());
+    EXPECT_EQ(fenOf(game), after_f5);
+    for (int i = 0; i < 4; ++i) ASSERT_TRUE(game.undoMove());
+    EXPECT_EQ(fenOf(game), start);
+    EXPECT_FALSE(game.undoMove());
+
+    for (int i = 0; i < 4; ++i) ASSERT_TRUE(game.redoMove());
+    EXPECT_EQ(fenOf(game), after_f5);
+    ASSERT_TRUE(game.redoMove());
+    EXPECT_EQ(fenOf(game), after_ep);
+    EXPECT_FALSE(game.redoMove());
+}
+
+TEST(ChessGameHistory, UndoRestoresCastlingRights) {
+    ChessGame game;
+    ASSERT_TRUE(game.loadFen("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 3 10"));
+    const std::string before = fenOf(game);
+    ASSERT_TRUE(play(game, {"e1g1", "e8c8"}));
+    EXPECT_EQ(fenOf(game), "2kr3r/8/8/8/8/8/8/R4RK1 w - - 5 11");
+
+    ASSERT_TRUE(game.undoMove());
+    ASSERT_TRUE(game.undoMove());
+    EXPECT_EQ(fenOf(game), before);
+}
+
+TEST(ChessGameHistory, NewMoveTruncatesRedo) {
+    ChessGame game;
+    ASSERT_TRUE(play(game, {"e2e4", "e7e5", "g1f3"}));
+    ASSERT_TRUE(game.undoMove());
+    ASSERT_TRUE(game.undoMove());
+
+    ASSERT_TRUE(play(game, {"c7c5"}));
+    EXPECT_FALSE(game.redoMove());
+    EXPECT_EQ(fenOf(game), "rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2");
+}
+
+TEST(ChessGameRepetition, ThreefoldAfterTwoKnightShuffles) {
+    ChessGame game;
+    ASSERT_TRUE(play(game, {"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1"}));
+    EXPECT_FALSE(game.isThreefoldRepetition());
+    ASSERT_TRUE(play(game, {"f6g8"}));  // Start position for the third time
+    EXPECT_TRUE(game.isThreefoldRepetition());
+    EXPECT_TRUE(game.isDraw());
+    EXPECT_TRUE(game.isGameOver());
+}
+
+TEST(ChessGameRepetition, UndoAndRedoToggleThreefold) {
+    ChessGame game;
+    ASSERT_TRUE(play(game, {"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1", "f6g8"}));
+    ASSERT_TRUE(game.isThreefoldRepetition());
+
+    ASSERT_TRUE(game.undoMove());
+    EXPECT_FALSE(game.isThreefoldRepetition());
+    EXPECT_FALSE(game.isDraw());
+    ASSERT_TRUE(game.redoMove());
+    EXPECT_TRUE(game.isThreefoldRepetition());
+    EXPECT_TRUE(game.isDraw());
+
+    // Another route back to the start square does not count the undone line
+    ASSERT_TRUE(game.undoMove());
+    ASSERT_TRUE(play(game, {"f6h5"}));
+    EXPECT_FALSE(game.isThreefoldRepetition());
+}
+
+TEST(ChessGameRepetition, DifferentCastlingRightsAreDifferentPositions) {
+    ChessGame game;
+    ASSERT_TRUE(play(game, {"e2e4", "e7e5", "e1e2", "e8e7", "e2e1", "e7e8",
+                            "e1e2", "e8e7", "e2e1", "e7e8"}));
+    // Kings are home again twice, but the first occurrence still had rights
+    EXPECT_FALSE(game.isThreefoldRepetition());
+    ASSERT_TRUE(play(game, {"e1e2", "e8e7", "e2e1", "e7e8"}));
+    EXPECT_TRUE(game.isThreefoldRepetition());
+}
+
+TEST(ChessGameFiftyMoves, DrawAtHundredPlies) {
+    ChessGame game;
+    ASSERT_TRUE(game.loadFen("4k3/8/8/8/8/8/4P3/4K2R w - - 99 80"));
+    EXPECT_EQ(game.halfmoveClock(), 99);
+    EXPECT_FALSE(game.isFiftyMoveDraw());
+
+    ASSERT_TRUE(play(game, {"h1h2"}));
+    EXPECT_EQ(game.halfmoveClock(), 100);
+    EXPECT_TRUE(game.isFiftyMoveDraw());
+    EXPECT_TRUE(game.isDraw());
+    EXPECT_TRUE(game.isGameOver());
+
+    ASSERT_TRUE(game.undoMove());
+    EXPECT_EQ(game.halfmoveClock(), 99);
+    EXPECT_FALSE(game.isFiftyMoveDraw());
+    EXPECT_FALSE(game.isGameOver());
+
+    // A pawn move resets the clock instead
+    ASSERT_TRUE(play(game, {"e2e4"}));
+    EXPECT_EQ(game.halfmoveClock(), 0);
+    EXPECT_FALSE(game.isDraw());
+}
+
+TEST(ChessGameFiftyMoves, CheckmateOnHundredthPlyStillWins) {
+    ChessGame game;
+    ASSERT_TRUE(game.loadFen("7k/8/6K1/8/8/8/8/R7 w - - 99 80"));
+    ASSERT_TRUE(play(game, {"a1a8"}));
+    EXPECT_TRUE(game.isFiftyMoveDraw());
+    EXPECT_TRUE(game.isCheckmate());
+    EXPECT_FALSE(game.isDraw());
+}
+
+} // namespace
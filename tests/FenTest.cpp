@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <optional>
+#include <string_view>
+#include "core/Fen.hpp"
+
+/// @file FenTest.cpp
+/// @brief parseFen(): positions that cannot occur in a game are rejected,
+/// impossible en-passant squares are dropped.
+
+namespace {
+
+using chess::parseFen;
+
+TEST(ParseFen, AcceptsStandardStart) {
+    const auto position = parseFen(chess::kStartFen);
+    ASSERT_TRUE(position.has_value());
+    EXPECT_EQ(position->side_to_move, chess::Color::White);
+    EXPECT_EQ(chess::toFen(*position).view(), chess::kStartFen);
+}
+
+TEST(ParseFen, RejectsPawnsOnBackRanks) {
+    EXPECT_FALSE(parseFen("P3k3/8/8/8/8/8/8/4K3 w - - 0 1"));
+    EXPECT_FALSE(parseFen("4k3/8/8/8/8/8/8/p3K3 w - - 0 1"));
+}
+
+TEST(ParseFen, RejectsSideNotToMoveInCheck) {
+    // White to move could capture the king
+    EXPECT_FALSE(parseFen("4k3/4R3/8/8/8/8/8/4K3 w - - 0 1"));
+    // The same placement is a legal check with Black to move
+    EXPECT_TRUE(parseFen("4k3/4R3/8/8/8/8/8/4K3 b - - 0 1"));
+}
+
+TEST(ParseFen, RejectsMissingOrExtraKings) {
+    EXPECT_FALSE(parseFen("8/8/8/8/8/8/8/4K3 w - - 0 1"));
+    EXPECT_FALSE(parseFen("4k3/8/8/8/8/8/8/3KK3 w - - 0 1"));
+}
+
+[[nodiscard]] bool keepsEnPassant(std::string_view fen) {
+    const auto position = parseFen(fen);
+    return position && position->board.enPassantSquare().has_value();
+}
+
+TEST(ParseFen, KeepsCapturableEnPassantSquare) {
+    EXPECT_TRUE(keepsEnPassant("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1"));
+    EXPECT_TRUE(keepsEnPassant("4k3/8/8/8/3Pp3/8/8/4K3 b - d3 0 1"));
+}
+
+TEST(ParseFen, DropsImpossibleEnPassantSquare) {
+    // A knight, not a pawn, in front of the square
+    EXPECT_FALSE(keepsEnPassant("4k3/8/8/3nP3/8/8/8/4K3 w - d6 0 1"));
+    // The double-pushed pawn's start square is occupied
+    EXPECT_FALSE(keepsEnPassant("4k3/3p4/8/3pP3/8/8/8/4K3 w - d6 0 1"));
+    // The square itself is occupied
+    EXPECT_FALSE(keepsEnPassant("4k3/8/3n4/3pP3/8/8/8/4K3 w - d6 0 1"));
+    // No pawn can capture onto it
+    EXPECT_FALSE(keepsEnPassant("4k3/8/8/3p4/8/8/8/4K3 w - d6 0 1"));
+}
+
+} // namespace
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <vector>
+#include "core/Fen.hpp"
+#include "core/MoveList.hpp"
+#include "core/Rules.hpp"
+#include "engine/Nnue.hpp"
+#include "engine/NnueKernels.hpp"
+
+/// @file NnueTest.cpp
+/// @brief Every supported kernel set against the scalar one, and
+/// incrementally updated accumulators against refreshed ones.
+
+namespace {
+
+using namespace engine::nnue;
+
+constexpr std::uint32_t kSeed = 20240611;
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+[[nodiscard]] std::vector<std::int16_t> randomValues(std::mt19937& rng, std::size_t count,
+                                                     int low, int high) {
+    std::uniform_int_distribution<int> value(low, high);
+    std::vector<std::int16_t> values(count);
+    for (auto& v : values) v = static_cast<std::int16_t>(value(rng));
+    return values;
+}
+
+TEST(NnueKernels, SupportedKernelsIncludeScalar) {
+    const auto kernels = supportedKernels();
+    ASSERT_FALSE(kernels.empty());
+    EXPECT_EQ(kernels.back(), scalarKernels());
+    EXPECT_EQ(&bestKernels(), kernels.front());
+}
+
+TEST(NnueKernels, UpdateMatchesScalar) {
+    std::mt19937 rng(kSeed);
+    const Kernels& scalar = *scalarKernels();
+    for (int trial = 0; trial < 50; ++trial) {
+        // Full 16-bit range: the sums must wrap the same way everywhere
+        const auto in = randomValues(rng, kHidden, -32768, 32767);
+        std::array<std::vector<std::int16_t>, 4> rows;
+        std::array<const std::int16_t*, 4> pointers{};
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            rows[i] = randomValues(rng, kHidden, -32768, 32767);
+            pointers[i] = rows[i].data();
+        }
+        const int added = trial % 3;
+        const int removed = (trial / 3) % 3;
+
+        alignas(64) std::array<std::int16_t, kHidden> expected{};
+        scalar.update(in.data(), expected.data(), pointers.data(), added, pointers.data() + 2,
+                      removed);
+        for (const Kernels* kernels : supportedKernels()) {
+            alignas(64) std::array<std::int16_t, kHidden> out{};
+            kernels->update(in.data(), out.data(), pointers.data(), added, pointers.data() + 2,
+                            removed);
+            EXPECT_EQ(out, expected) << kernels->name << ", trial " << trial;
+
+            // In place
+            alignas(64) std::array<std::int16_t, kHidden> inout{};
+            std::memcpy(inout.data(), in.data(), sizeof(inout));
+            kernels->update(inout.data(), inout.data(), pointers.data(), added,
+                            pointers.data() + 2, removed);
+            EXPECT_EQ(inout, expected) << kernels->name << " in place, trial " << trial;
+        }
+    }
+}
+
+TEST(NnueKernels, OutputMatchesScalar) {
+    std::mt19937 rng(kSeed + 1);
+    const Kernels& scalar = *scalarKernels();
+    for (int trial = 0; trial < 50; ++trial) {
+        // Accumulators on both sides of the clipping range
+        const auto us = randomValues(rng, kHidden, -300, 600);
+        const auto them = randomValues(rng, kHidden, -300, 600);
+        const auto weights = randomValues(rng, 2 * kHidden, -128, 127);
+
+        const std::int32_t expected = scalar.output(us.data(), them.data(), weights.data());
+        for (const Kernels* kernels : supportedKernels()) {
+            EXPECT_EQ(kernels->output(us.data(), them.data(), weights.data()), expected)
+                << kernels->name << ", trial " << trial;
+        }
+    }
+}
+
+// ============================================================================
+// Accumulators
+// ============================================================================
+
+/// A valid weights file with small random weights (see Nnue.hpp for the layout).
+void writeRandomNetwork(const std::filesystem::path& path, std::uint32_t seed) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const auto u32 = [&](std::uint32_t value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    const auto i16s = [&](const std::vector<std::int16_t>& values) {
+        out.write(reinterpret_cast<const char*>(values.data()),
+                  static_cast<std::streamsize>(values.size() * sizeof(std::int16_t)));
+    };
+
+    out.write("MCNN", 4);
+    u32(1);
+    u32(kInputs);
+    u32(kHidden);
+    u32(64);   // Q
+    u32(400);  // S
+    const std::array<char, 40> padding{};
+    out.write(padding.data(), padding.size());
+
+    std::mt19937 rng(seed);
+    i16s(randomValues(rng, std::size_t{kInputs} * kHidden, -64, 64));
+    i16s(randomValues(rng, kHidden, 0, 128));
+    i16s(randomValues(rng, 2 * kHidden, -64, 64));
+    u32(1000);
+}
+
+class NnueAccumulator : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        path_ = std::filesystem::temp_directory_path() / "chess_nnue_test.nnue";
+        writeRandomNetwork(path_, kSeed);
+        network_ = Network::load(path_);
+    }
+
+    static void TearDownTestSuite() {
+        network_.reset();
+        std::filesystem::remove(path_);
+    }
+
+    /// Walk the legal move tree to `depth`, updating the accumulator along
+    /// every move and comparing it with a refresh of the resulting board.
+    /// @return Nodes whose accumulators differed
+    int walk(chess::Board& board, chess::Color side, const Accumulator& accumulator, int depth) {
+        if (depth == 0) return 0;
+        chess::MoveList moves;
+        rules_.legalMoves(board, side, moves);
+
+        int mismatches = 0;
+        for (const chess::Move& move : moves) {
+            const chess::PlacementDelta delta = board.placementDelta(move);
+            const chess::UndoInfo undo = board.makeMove(move);
+            const chess::Color next = chess::opponent(side);
+
+            Accumulator updated;
+            Accumulator refreshed;
+            network_->update(accumulator, delta, updated);
+            network_->refresh(board, refreshed);
+            ++nodes_;
+            if (updated.values != refreshed.values) {
+                ADD_FAILURE() << "accumulator differs after " << chess::toFen(board, next).view();
+                ++mismatches;
+            } else {
+                EXPECT_EQ(network_->evaluate(updated, next), network_->evaluate(board, next));
+                mismatches += walk(board, next, updated, depth - 1);
+            }
+            board.unmakeMove(move, undo);
+        }
+        return mismatches;
+    }
+
+    void checkTree(std::string_view fen, int depth, int expected_nodes) {
+        ASSERT_TRUE(network_.has_value());
+        auto position = chess::parseFen(fen);
+        ASSERT_TRUE(position.has_value()) << fen;
+
+        Accumulator root;
+        network_->refresh(position->board, root);
+        nodes_ = 0;
+        EXPECT_EQ(walk(position->board, position->side_to_move, root, depth), 0) << fen;
+        EXPECT_EQ(nodes_, expected_nodes) << fen;
+    }
+
+    static inline std::filesystem::path path_;
+    static inline std::optional<Network> network_;
+    chess::Rules rules_;
+    int nodes_{0};
+};
+
+TEST_F(NnueAccumulator, LoadsRandomNetwork) {
+    ASSERT_TRUE(network_.has_value());
+    EXPECT_EQ(network_->kernelName(), std::string_view(bestKernels().name));
+}
+
+// Node counts are the perft totals of depth 1..depth
+TEST_F(NnueAccumulator, StartPositionUpdatesMatchRefresh) {
+    checkTree(chess::kStartFen, 3, 20 + 400 + 8902);
+}
+
+TEST_F(NnueAccumulator, CastlingAndPromotionUpdatesMatchRefresh) {
+    // Kiwipete, then position 4 of the perft suite
+    checkTree("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 2,
+              48 + 2039);
+    checkTree("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3,
+              6 + 264 + 9467);
+}
+
+TEST_F(NnueAccumulator, EnPassantUpdatesMatchRefresh) {
+    checkTree("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4, 14 + 191 + 2812 + 43238);
+}
+
+} // namespace
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+#include "TestSupport.hpp"
+#include "core/Notation.hpp"
+#include "core/PackedMove.hpp"
+#include "core/Pgn.hpp"
+#include "engine/OpeningBook.hpp"
+
+/// @file OpeningBookTest.cpp
+/// @brief Polyglot keys against the format's published test vectors, and a
+/// book written by OpeningBookBuilder read back through OpeningBook.
+
+namespace {
+
+using chess::ChessGame;
+using engine::OpeningBook;
+
+[[nodiscard]] std::uint64_t keyAfter(std::initializer_list<std::string_view> moves) {
+    ChessGame game;
+    EXPECT_TRUE(chess::test::play(game, moves));
+    return OpeningBook::polyglotKey(game.board(), game.sideToMove());
+}
+
+TEST(PolyglotKey, MatchesReferenceKeys) {
+    EXPECT_EQ(keyAfter({}), 0x463b96181691fc9cULL);
+    EXPECT_EQ(keyAfter({"e2e4"}), 0x823c9b50fd114196ULL);
+    EXPECT_EQ(keyAfter({"e2e4", "d7d5"}), 0x0756b94461c50fb0ULL);
+    EXPECT_EQ(keyAfter({"e2e4", "d7d5", "e4e5"}), 0x662fafb965db29d4ULL);
+}
+
+TEST(PolyglotKey, HashesCapturableEnPassantFile) {
+    // f7f5 next to the e5 pawn: the f-file is hashed
+    EXPECT_EQ(keyAfter({"e2e4", "d7d5", "e4e5", "f7f5"}), 0x22a48b5a8e47ff78ULL);
+    // c2c4 next to the b4 pawn
+    EXPECT_EQ(keyAfter({"a2a4", "b7b5", "h2h4", "b5b4", "c2c4"}), 0x3c8123ea7b067637ULL);
+}
+
+TEST(PolyglotKey, HashesCastlingRights) {
+    // White loses both rights, then Black
+    EXPECT_EQ(keyAfter({"e2e4", "d7d5", "e4e5", "f7f5", "e1e2"}), 0x652a607ca3f242c1ULL);
+    EXPECT_EQ(keyAfter({"e2e4", "d7d5", "e4e5", "f7f5", "e1e2", "e8f7"}),
+              0x00fdd303c946bdd9ULL);
+    // Only White's queen side right is lost
+    EXPECT_EQ(keyAfter({"a2a4", "b7b5", "h2h4", "b5b4", "c2c4", "b4c3", "a1a3"}),
+              0x5c3f9b829b279560ULL);
+}
+
+[[nodiscard]] std::vector<chess::PackedMove> packGame(std::initializer_list<std::string_view> moves) {
+    ChessGame game;
+    std::vector<chess::PackedMove> packed;
+    for (const std::string_view uci : moves) {
+        const auto move = chess::test::findMove(game, uci);
+        EXPECT_TRUE(move.has_value()) << uci;
+        if (!move) break;
+        packed.emplace_back(*move);
+        static_cast<void>(game.makeMove(*move));
+    }
+    return packed;
+}
+
+struct Expected {
+    std::string_view uci;
+    std::uint16_t weight;
+};
+
+void expectBookMoves(const OpeningBook& book, std::initializer_list<std::string_view> path,
+                     std::initializer_list<Expected> expected) {
+    ChessGame game;
+    ASSERT_TRUE(chess::test::play(game, path));
+    const std::vector<engine::BookMove> moves = book.lookup(game.board(), game.sideToMove());
+    ASSERT_EQ(moves.size(), expected.size());
+    std::size_t i = 0;
+    for (const Expected& want : expected) {
+        EXPECT_EQ(chess::toUci(moves[i].move), want.uci);
+        EXPECT_EQ(moves[i].weight, want.weight);
+        ++i;
+    }
+}
+
+TEST(OpeningBookBuilder, RoundTripsSummedWeights) {
+    // 2 per win, 1 per draw, 0 per loss: moves that only ever lost are dropped
+    engine::OpeningBookBuilder builder;
+    ASSERT_TRUE(builder.addGame(packGame({"e2e4", "e7e5", "g1f3", "b8c6"}),
+                                chess::GameResult::WhiteWins));
+    ASSERT_TRUE(builder.addGame(packGame({"e2e4", "c7c5"}), chess::GameResult::Draw));
+    ASSERT_TRUE(builder.addGame(packGame({"d2d4", "d7d5"}), chess::GameResult::WhiteWins));
+    EXPECT_EQ(builder.sampleCount(), 8U);
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "chess_opening_book_test.bin";
+    ASSERT_TRUE(builder.write(path));
+    {
+        const auto book = OpeningBook::open(path);
+        ASSERT_TRUE(book.has_value());
+        EXPECT_EQ(book->size(), 4U);  // e4, d4, c5 and Nf3
+
+        expectBookMoves(*book, {}, {{"e2e4", 3}, {"d2d4", 2}});
+        expectBookMoves(*book, {"e2e4"}, {{"c7c5", 1}});
+        expectBookMoves(*book, {"e2e4", "e7e5"}, {{"g1f3", 2}});
+        expectBookMoves(*book, {"d2d4"}, {});
+    }
+    std::filesystem::remove(path);
+}
+
+} // namespace
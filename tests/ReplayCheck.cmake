@@ -0,0 +1,43 @@
+# Runs pgn_replay --verbose on a PGN file and checks its per-game lines and
+# totals against an expected listing (position keys and timings removed).
+#
+#   cmake -DPGN_REPLAY=<exe> -DINPUT=<games.pgn> -DEXPECTED=<listing>
+#         -DEXPECTED_ERROR=<stderr text> -P ReplayCheck.cmake
+#
+# A game failing to replay makes pgn_replay exit non-zero, so the run must
+# fail exactly when EXPECTED_ERROR is set.
+
+foreach(var PGN_REPLAY INPUT EXPECTED)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "ReplayCheck.cmake: -D${var}=... is required")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND ${PGN_REPLAY} ${INPUT} --verbose --threads 1
+    RESULT_VARIABLE status
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE errors
+)
+
+if(DEFINED EXPECTED_ERROR)
+    if(status EQUAL 0)
+        message(FATAL_ERROR "pgn_replay succeeded, expected a failed game")
+    endif()
+    string(FIND "${errors}" "${EXPECTED_ERROR}" found)
+    if(found EQUAL -1)
+        message(FATAL_ERROR "stderr lacks '${EXPECTED_ERROR}':\n${errors}")
+    endif()
+elseif(NOT status EQUAL 0)
+    message(FATAL_ERROR "pgn_replay exited with ${status}:\n${errors}")
+endif()
+
+# Keep "<game> <result> <plies> <state>" and "Games: N (F failed), P plies"
+string(REGEX REPLACE "([^\n]+) [0-9a-f]+\n" "\\1\n" listing "${output}")
+string(REGEX REPLACE " in [^\n]*\n" "\n" listing "${listing}")
+string(REGEX REPLACE "Throughput:[^\n]*\n" "" listing "${listing}")
+
+file(READ ${EXPECTED} expected)
+if(NOT listing STREQUAL expected)
+    message(FATAL_ERROR "pgn_replay output differs.\nExpected:\n${expected}\nGot:\n${listing}")
+endif()
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include "core/Fen.hpp"
+#include "engine/SyzygyIndex.hpp"
+#include "engine/Tablebase.hpp"
+
+/// @file TablebaseTest.cpp
+/// @brief The parts of tablebase probing that need no table files: the
+/// fifty-move adjudication, the position index and a set without tables.
+
+namespace {
+
+using engine::Tablebase;
+using engine::Wdl;
+namespace syzygy = engine::syzygy;
+
+// ============================================================================
+// Fifty-Move Adjudication
+// ============================================================================
+
+TEST(TablebaseAdjudication, WinStandsWhileDtzAndClockFitInHundredPlies) {
+    EXPECT_EQ(Tablebase::fiftyMoveResult(Wdl::Win, 30, 0), Wdl::Win);
+    EXPECT_EQ(Tablebase::fiftyMoveResult(Wdl::Win, 30, 70), Wdl::Win);
+    EXPECT_EQ(Tablebase::fiftyMoveResult(Wdl::Win, 30, 71), Wdl::Draw);
+    EXPECT_EQ(Tablebase::fiftyMoveResult(Wdl::Win, 100, 0), Wdl::Win);
+}
+
+TEST(TablebaseAdjudication, LossStandsWhileDtzAndClockFitInHundredPlies) {
+    EXPECT_EQ(Tablebase::fiftyMoveResult(Wdl::Loss, -30, 70), Wdl::Loss);
+    EXPECT_EQ(Tablebase::fiftyMoveResult(Wdl::Loss, -30, 71), Wdl::Draw);
+}
+
+TEST(TablebaseAdjudication, CursedAndBlessedResultsAreDraws) {
+    EXPECT_EQ(Tablebase::fiftyMoveResult(Wdl::CursedWin, 120, 0), Wdl::Draw);
+    EXPECT_EQ(Tablebase::fiftyMoveResult(Wdl::BlessedLoss, -120, 0), Wdl::Draw);
+    EXPECT_EQ(Tablebase::fiftyMoveResult(Wdl::Draw, 0, 0), Wdl::Draw);
+}
+
+// ============================================================================
+// Position Index
+// ============================================================================
+
+constexpr int kWhitePawn = 1;
+constexpr int kWhiteQueen = 5;
+constexpr int kWhiteKing = 6;
+constexpr int kBlackKing = 6 + syzygy::kBlackBit;
+
+struct Table {
+    syzygy::TableShape shape;
+    syzygy::IndexLayout layout;
+};
+
+/// Table of `material` whose single sub-table encodes `pieces` in this order.
+[[nodiscard]] Table makeTable(std::string_view material, std::array<int, 3> pieces, int file) {
+    Table table{.shape = syzygy::shapeOf(*syzygy::parseMaterial(material)), .layout = {}};
+    std::ranges::copy(pieces, table.layout.pieces.begin());
+    syzygy::setGroups(table.shape, table.layout, {0, 0xF}, file);
+    return table;
+}
+
+[[nodiscard]] std::uint64_t indexOf(const Table& table, std::string_view fen) {
+    const auto position = chess::parseFen(fen);
+    EXPECT_TRUE(position.has_value()) << fen;
+    if (!position) return 0;
+    const syzygy::Placement placement = syzygy::placementOf(
+        position->board, position->side_to_move, table.shape, table.layout.pieces[0]);
+    return syzygy::encode(table.shape, table.layout, placement);
+}
+
+TEST(SyzygyIndex, KqvkUsesUniqueTripleEncoding) {
+    const Table kqvk = makeTable("KQvK", {kWhiteKing, kWhiteQueen, kBlackKing}, 0);
+    EXPECT_EQ(kqvk.layout.size(), 31332U);
+
+    // Kb1, Qd1, kc3: (map_a1d1d4[b1] * 63 + d1 - 1) * 62 + c3 - 2
+    EXPECT_EQ(indexOf(kqvk, "8/8/8/8/8/2k5/8/1K1Q4 w - - 0 1"), 140U);
+}
+
+TEST(SyzygyIndex, KqvkIndexIsInvariantUnderSymmetry) {
+    const Table kqvk = makeTable("KQvK", {kWhiteKing, kWhiteQueen, kBlackKing}, 0);
+    EXPECT_EQ(indexOf(kqvk, "8/8/8/8/8/5k2/8/4Q1K1 w - - 0 1"), 140U);  // Files mirrored
+    EXPECT_EQ(indexOf(kqvk, "1K1Q4/8/2k5/8/8/8/8/8 w - - 0 1"), 140U);  // Ranks mirrored
+    EXPECT_EQ(indexOf(kqvk, "8/8/8/8/Q7/2k5/K7/8 w - - 0 1"), 140U);     // Diagonal
+    // Colors swapped, Black to move: the same table entry
+    EXPECT_EQ(indexOf(kqvk, "1k1q4/8/2K5/8/8/8/8/8 b - - 0 1"), 140U);
+}
+
+TEST(SyzygyIndex, KpvkIndexesLeadingPawnThenKings) {
+    const Table kpvk = makeTable("KPvK", {kWhitePawn, kWhiteKing, kBlackKing}, 1);
+    EXPECT_EQ(kpvk.layout.size(), 6U * 63 * 62);
+
+    // Pb4 is the third pawn square of the b-file; then Ke1 (4) among 63
+    // squares and kd5 (35 - 2 taken below it) among 62
+    EXPECT_EQ(indexOf(kpvk, "8/8/8/3k4/1P6/8/8/4K3 w - - 0 1"), 2U + 4 * 6 + 33 * 6 * 63);
+    // Mirrored onto the g-file: the b-file sub-table again
+    EXPECT_EQ(indexOf(kpvk, "8/8/8/4k3/6P1/8/8/3K4 w - - 0 1"), 2U + 4 * 6 + 33 * 6 * 63);
+}
+
+TEST(SyzygyIndex, KpvkPlacementFindsLeadingPawnFile) {
+    const Table kpvk = makeTable("KPvK", {kWhitePawn, kWhiteKing, kBlackKing}, 1);
+    const auto position = chess::parseFen("8/8/8/4k3/6P1/8/8/3K4 b - - 0 1");
+    ASSERT_TRUE(position.has_value());
+    const syzygy::Placement placement =
+        syzygy::placementOf(position->board, position->side_to_move, kpvk.shape, kWhitePawn);
+    EXPECT_EQ(placement.lead_count, 1);
+    EXPECT_EQ(placement.lead_file, 1);
+    EXPECT_EQ(placement.stored_side, 1);
+}
+
+// ============================================================================
+// Without Tables
+// ============================================================================
+
+void expectNoProbes(const Tablebase& tablebase) {
+    const auto position = chess::parseFen("8/8/8/8/8/2k5/8/1K1Q4 w - - 0 1");
+    ASSERT_TRUE(position.has_value());
+    const chess::Board& board = position->board;
+    EXPECT_FALSE(tablebase.probeWdl(board, chess::Color::White).has_value());
+    EXPECT_FALSE(tablebase.probeDtz(board, chess::Color::White).has_value());
+    EXPECT_FALSE(tablebase.probeRoot(board, chess::Color::White).has_value());
+    EXPECT_FALSE(tablebase.adjudicate(board, chess::Color::White, 10).has_value());
+}
+
+TEST(TablebaseFiles, MissingDirectoryHasNoTables) {
+    const Tablebase tablebase("/nonexistent/syzygy");
+    EXPECT_EQ(tablebase.tableCount(), 0U);
+    EXPECT_EQ(tablebase.maxPieces(), 0);
+    expectNoProbes(tablebase);
+}
+
+TEST(TablebaseFiles, EmptyDirectoryHasNoTables) {
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "chess_tablebase_test_empty";
+    std::filesystem::create_directories(directory);
+    {
+        const Tablebase tablebase(directory.string());
+        EXPECT_EQ(tablebase.tableCount(), 0U);
+        EXPECT_EQ(tablebase.maxPieces(), 0);
+        expectNoProbes(tablebase);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST(TablebaseFiles, CorruptTableIsListedButNeverProbed) {
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "chess_tablebase_test_corrupt";
+    std::filesystem::create_directories(directory);
+    std::ofstream(directory / "KQvK.rtbw") << "not a table";
+    {
+        const Tablebase tablebase(directory.string());
+        EXPECT_EQ(tablebase.tableCount(), 1U);
+        EXPECT_EQ(tablebase.maxPieces(), 3);
+        expectNoProbes(tablebase);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+} // namespace
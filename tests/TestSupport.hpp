@@ -0,0 +1,32 @@
+#pragma once
+#include <algorithm>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include "core/ChessGame.hpp"
+#include "core/Notation.hpp"
+
+/// @file TestSupport.hpp
+/// @brief Helpers shared by the unit tests.
+
+namespace chess::test {
+
+/// The legal move of `game` written as `uci` (e.g. "e2e4", "e7e8q").
+[[nodiscard]] inline std::optional<Move> findMove(const ChessGame& game, std::string_view uci) {
+    const MoveList& legal = game.legalMoveList();
+    const auto it = std::ranges::find_if(legal, [&](const Move& move) { return toUci(move) == uci; });
+    if (it == legal.end()) return std::nullopt;
+    return *it;
+}
+
+/// Play UCI moves in order.
+/// @return false at the first move that is not legal
+[[nodiscard]] inline bool play(ChessGame& game, std::initializer_list<std::string_view> moves) {
+    for (const std::string_view uci : moves) {
+        const auto move = findMove(game, uci);
+        if (!move || !game.makeMove(*move)) return false;
+    }
+    return true;
+}
+
+} // namespace chess::test
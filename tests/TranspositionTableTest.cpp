@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <optional>
+#include "core/PackedMove.hpp"
+#include "core/Zobrist.hpp"
+#include "engine/TranspositionTable.hpp"
+
+/// @file TranspositionTableTest.cpp
+/// @brief Depth/age replacement of TranspositionTable::store().
+
+namespace {
+
+using engine::Bound;
+using engine::TranspositionTable;
+
+constexpr chess::zobrist::Key kKey = 0x0123456789abcdefULL;
+
+[[nodiscard]] int depthAt(const TranspositionTable& table, chess::zobrist::Key key) {
+    const std::optional<engine::TTEntry> entry = table.probe(key);
+    return entry ? entry->depth : -1;
+}
+
+/// A different key mapping to kKey's slot.
+[[nodiscard]] chess::zobrist::Key collidingKey(const TranspositionTable& table) {
+    return kKey + table.slotCount();
+}
+
+TEST(TranspositionTable, KeepsDeeperEntryOfAnotherPosition) {
+    TranspositionTable table(1);
+    const chess::zobrist::Key other = collidingKey(table);
+
+    table.store(kKey, chess::PackedMove{}, 10, 8, Bound::Exact);
+    table.store(other, chess::PackedMove{}, 20, 3, Bound::Lower);
+    EXPECT_EQ(depthAt(table, kKey), 8);
+    EXPECT_EQ(depthAt(table, other), -1);
+
+    table.store(other, chess::PackedMove{}, 20, 9, Bound::Lower);
+    EXPECT_EQ(depthAt(table, kKey), -1);
+    EXPECT_EQ(depthAt(table, other), 9);
+}
+
+TEST(TranspositionTable, ReplacesEntriesOfOlderSearches) {
+    TranspositionTable table(1);
+    const chess::zobrist::Key other = collidingKey(table);
+
+    table.store(kKey, chess::PackedMove{}, 10, 8, Bound::Exact);
+    table.newSearch();
+    table.store(other, chess::PackedMove{}, 20, 1, Bound::Upper);
+    EXPECT_EQ(depthAt(table, kKey), -1);
+    EXPECT_EQ(depthAt(table, other), 1);
+}
+
+TEST(TranspositionTable, SamePositionKeepsMeaningfullyDeeperResult) {
+    TranspositionTable table(1);
+
+    table.store(kKey, chess::PackedMove{}, 10, 8, Bound::Lower);
+    table.store(kKey, chess::PackedMove{}, 10, 5, Bound::Lower);
+    EXPECT_EQ(depthAt(table, kKey), 8);
+
+    // Within the margin, or exact, the newer result wins
+    table.store(kKey, chess::PackedMove{}, 10, 6, Bound::Lower);
+    EXPECT_EQ(depthAt(table, kKey), 6);
+    table.store(kKey, chess::PackedMove{}, 10, 1, Bound::Exact);
+    EXPECT_EQ(depthAt(table, kKey), 1);
+}
+
+} // namespace